@@ -13,6 +13,7 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "AIController.h"
+#include "SpiderNavigationDiagnostics.h"
 
 
 USpiderCloseEnoughDecorator::USpiderCloseEnoughDecorator()
@@ -40,7 +41,7 @@ bool USpiderCloseEnoughDecorator::CalculateRawConditionValue(UBehaviorTreeCompon
 
 	if (!CheckReferences(OwnerComp))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("SpiderCloseEnoughDecorator: Missing references."));
+		SPIDERNAV_LOG(OwnerComp.GetAIOwner(), Warning, TEXT("Missing references."));
 		return false;
 	}
 	else
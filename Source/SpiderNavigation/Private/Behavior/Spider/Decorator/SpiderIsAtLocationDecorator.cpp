@@ -9,6 +9,7 @@
 #include "BehaviorTree/BTFunctionLibrary.h"
 
 #include "AIController.h"
+#include "SpiderNavigationDiagnostics.h"
 
 void USpiderIsAtLocationDecorator::InitializeFromAsset(UBehaviorTree& Asset)
 {
@@ -38,17 +39,17 @@ bool USpiderIsAtLocationDecorator::CalculateRawConditionValue(UBehaviorTreeCompo
 			}
 			else
 			{
-				UE_LOG(LogBehaviorTree, Warning, TEXT("USpiderIsAtLocationDecorator: No BlackboardComponent found for BehaviorTreeComponent %s"), *OwnerComp.GetName());
+				SPIDERNAV_LOG(Controller, Warning, TEXT("No BlackboardComponent found for BehaviorTreeComponent %s"), *OwnerComp.GetName());
 			}
 		}
 		else
 		{
-			UE_LOG(LogBehaviorTree, Warning, TEXT("USpiderIsAtLocationDecorator: No Pawn found for AIController %s"), *Controller->GetName());
+			SPIDERNAV_LOG(Controller, Warning, TEXT("No Pawn found"));
 		}
 	}
 	else
 	{
-		UE_LOG(LogBehaviorTree, Warning, TEXT("USpiderIsAtLocationDecorator: No AIController found"));
+		SPIDERNAV_LOG(nullptr, Warning, TEXT("No AIController found"));
 	}
 
 	return false;
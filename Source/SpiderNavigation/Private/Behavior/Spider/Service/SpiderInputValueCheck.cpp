@@ -22,6 +22,7 @@
 #include "Subsystems/SpiderNavigationSubsystem.h"
 
 #include "AIController.h"
+#include "SpiderNavigationDiagnostics.h"
 
 USpiderInputValueCheck::USpiderInputValueCheck()
 {
@@ -109,12 +110,12 @@ void USpiderInputValueCheck::PerformValueCheck(UBehaviorTreeComponent& OwnerComp
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Navigation is null in SpiderInputValueCheck."));
+			SPIDERNAV_LOG(AIController, Warning, TEXT("Navigation is null."));
 		}
 
 		if (SpiderActors.Num() == 0)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Could not find any Spiders in scene."));
+			SPIDERNAV_LOG(AIController, Verbose, TEXT("Could not find any Spiders in scene."));
 			
 		}
 
@@ -180,6 +181,6 @@ void USpiderInputValueCheck::PerformValueCheck(UBehaviorTreeComponent& OwnerComp
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Target Visibility Check is disabled."));
+		SPIDERNAV_LOG(AIController, VeryVerbose, TEXT("Target Visibility Check is disabled."));
 	}
 }
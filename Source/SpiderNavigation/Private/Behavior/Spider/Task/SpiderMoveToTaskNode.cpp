@@ -7,8 +7,10 @@
 #include "BehaviorTree/BlackboardComponent.h"
 
 #include "Interfaces/SpiderAIControllerInterface.h"
+#include "Controllers/SpiderAIController.h"
 
 #include "AIController.h"
+#include "SpiderNavigationDiagnostics.h"
 
 USpiderMoveToTaskNode::USpiderMoveToTaskNode()
 {
@@ -25,26 +27,23 @@ EBTNodeResult::Type USpiderMoveToTaskNode::ExecuteTask(UBehaviorTreeComponent& O
 {
 	Super::ExecuteTask(OwnerComp, NodeMemory);
 
-	UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - Start"));
-
 	CachedOwnerComp = &OwnerComp;
 
     if(AIController == nullptr)
     {
         AIController = Cast<AActor>(OwnerComp.GetAIOwner());
-		UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - AIController gesetzt"));
 	}
 
     if (!AIController)
     {
-		UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - Kein AIController gefunden"));
+		SPIDERNAV_LOG(nullptr, Warning, TEXT("Kein AIController gefunden"));
         return EBTNodeResult::Failed;
     }
   
     const UBlackboardComponent* BB = OwnerComp.GetBlackboardComponent();
     if (!BB)
     {
-		UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - Kein BlackboardComponent gefunden"));
+		SPIDERNAV_LOG(AIController, Warning, TEXT("Kein BlackboardComponent gefunden"));
         return EBTNodeResult::Failed;        
     }
 
@@ -52,23 +51,29 @@ EBTNodeResult::Type USpiderMoveToTaskNode::ExecuteTask(UBehaviorTreeComponent& O
 
     if(!AIController->GetClass()->ImplementsInterface(USpiderAIControllerInterface::StaticClass()))
     {
-		UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - AIController implementiert nicht das Interface"));
+		SPIDERNAV_LOG(AIController, Warning, TEXT("AIController implementiert nicht das Interface"));
         return EBTNodeResult::Failed;
 	}
     
     ISpiderAIControllerInterface* SpiderCtrl = Cast<ISpiderAIControllerInterface>(AIController);
     if (!SpiderCtrl)
     {
-		UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - Konnte SpiderCtrl nicht casten"));
+		SPIDERNAV_LOG(AIController, Warning, TEXT("Konnte SpiderCtrl nicht casten"));
         return EBTNodeResult::Failed;
     }
-	UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - SpiderCtrl gefunden"));
     // Delegate binden
     SpiderCtrl->GetHandleMoveCompleted().AddUObject(this, &USpiderMoveToTaskNode::HandleMoveCompleted);
     
-	UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - MoveTo wird gestartet"));
-    ISpiderAIControllerInterface::Execute_MoveTo(AIController, VTargetLocation);
-	UE_LOG(LogTemp, Warning, TEXT("USpiderMoveToTaskNode::ExecuteTask - MoveTo gestartet"));
+    ASpiderAIController* SpiderController = Cast<ASpiderAIController>(AIController);
+    if (bOverrideQueryParams && SpiderController)
+    {
+        SpiderController->MoveToWithParams(VTargetLocation, QueryParams);
+    }
+    else
+    {
+        ISpiderAIControllerInterface::Execute_MoveTo(AIController, VTargetLocation);
+    }
+	SPIDERNAV_LOG(AIController, Verbose, TEXT("MoveTo %s"), *VTargetLocation.ToString());
     return EBTNodeResult::InProgress;
 }
 
@@ -92,5 +97,10 @@ FString USpiderMoveToTaskNode::GetStaticDescription() const
         ? TEXT("<none>")
         : TargetLocation.SelectedKeyName.ToString();
 
+    if (bOverrideQueryParams)
+    {
+        return FString::Printf(TEXT("Target: %s\nSearch: %s (epsilon %.2f)"), *KeyName,
+            *StaticEnum<ESpiderNavSearchMode>()->GetNameStringByValue((int64)QueryParams.Mode), QueryParams.Epsilon);
+    }
     return FString::Printf(TEXT("Target: %s"), *KeyName);
 }
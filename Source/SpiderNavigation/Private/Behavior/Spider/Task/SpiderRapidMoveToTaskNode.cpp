@@ -8,6 +8,7 @@
 #include "BehaviorTree/BlackboardComponent.h"
 
 #include "Interfaces/SpiderAIControllerInterface.h"
+#include "Controllers/SpiderAIController.h"
 
 #include "AIController.h"
 
@@ -52,6 +53,13 @@ EBTNodeResult::Type USpiderRapidMoveToTaskNode::ExecuteTask(UBehaviorTreeCompone
         return EBTNodeResult::Failed;
     }
 
+    // Spider controllers decide themselves (FollowMode) whether to search again or repair their search tree
+    if (ASpiderAIController* SpiderController = Cast<ASpiderAIController>(AIController))
+    {
+        SpiderController->FollowActor(Target);
+        return EBTNodeResult::Succeeded;
+    }
+
     ISpiderAIControllerInterface::Execute_MoveTo(AIController, Target->GetActorLocation());
     return EBTNodeResult::Succeeded;
 }
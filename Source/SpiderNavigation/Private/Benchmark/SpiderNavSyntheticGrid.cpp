@@ -0,0 +1,369 @@
+// Copyright Yves Tanas 2025
+
+#include "Benchmark/SpiderNavSyntheticGrid.h"
+#include "Math/RandomStream.h"
+
+namespace SpiderNavSyntheticGridPrivate
+{
+	/** Link radius in steps for lattice shapes: axis and face diagonals, no space diagonals */
+	static constexpr float LATTICE_LINK_RADIUS = 1.45f;
+
+	/** Floor to floor distance in steps */
+	static constexpr int32 FLOOR_HEIGHT = 8;
+
+	/** Interior cells per room side */
+	static constexpr int32 ROOM_SIZE = 10;
+
+	/** Doorway width and height in cells */
+	static constexpr int32 DOOR_SIZE = 3;
+
+	/** Expected neighbor count of the random geometric graph */
+	static constexpr float RGG_DEGREE = 8.f;
+
+	static const FIntVector CAVE_DIRS[6] =
+	{
+		FIntVector(1, 0, 0), FIntVector(-1, 0, 0),
+		FIntVector(0, 1, 0), FIntVector(0, -1, 0),
+		FIntVector(0, 0, 1), FIntVector(0, 0, -1)
+	};
+
+	static FIntVector CellOf(const FVector& P, double CellSize)
+	{
+		return FIntVector(FMath::FloorToInt(P.X / CellSize), FMath::FloorToInt(P.Y / CellSize), FMath::FloorToInt(P.Z / CellSize));
+	}
+
+	static bool IsDoorCell(int32 Along, int32 Row)
+	{
+		const int32 DoorStart = (ROOM_SIZE - DOOR_SIZE) / 2;
+		return Along >= DoorStart && Along < DoorStart + DOOR_SIZE && Row <= DOOR_SIZE;
+	}
+}
+
+void FSpiderNavSyntheticGrid::Generate(const FSpiderNavSyntheticGridParams& Params, FSavedSpiderNavGrid& OutGrid)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	TArray<FVector> Locations;
+	TArray<FVector> Normals;
+	float Radius = Params.Step * LATTICE_LINK_RADIUS;
+
+	switch (Params.Shape)
+	{
+	case ESpiderNavSyntheticShape::Caves:
+		GenerateCaves(Params, Locations, Normals);
+		break;
+	case ESpiderNavSyntheticShape::StackedFloors:
+		GenerateStackedFloors(Params, Locations, Normals);
+		break;
+	case ESpiderNavSyntheticShape::CubeRooms:
+		GenerateCubeRooms(Params, Locations, Normals);
+		break;
+	case ESpiderNavSyntheticShape::RandomGeometric:
+		GenerateRandomGeometric(Params, Locations, Normals, Radius);
+		break;
+	default:
+		break;
+	}
+
+	Link(Locations, Normals, Radius, OutGrid);
+}
+
+const TCHAR* FSpiderNavSyntheticGrid::GetShapeName(ESpiderNavSyntheticShape Shape)
+{
+	switch (Shape)
+	{
+	case ESpiderNavSyntheticShape::Caves:			return TEXT("Caves");
+	case ESpiderNavSyntheticShape::StackedFloors:	return TEXT("StackedFloors");
+	case ESpiderNavSyntheticShape::CubeRooms:		return TEXT("CubeRooms");
+	case ESpiderNavSyntheticShape::RandomGeometric:	return TEXT("RandomGeometric");
+	default:										return TEXT("Unknown");
+	}
+}
+
+bool FSpiderNavSyntheticGrid::ParseShape(const FString& Name, ESpiderNavSyntheticShape& OutShape)
+{
+	for (uint8 i = 0; i < (uint8)ESpiderNavSyntheticShape::Num; ++i)
+	{
+		if (Name.Equals(GetShapeName((ESpiderNavSyntheticShape)i), ESearchCase::IgnoreCase))
+		{
+			OutShape = (ESpiderNavSyntheticShape)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+int64 FSpiderNavSyntheticGrid::CountEdges(const FSavedSpiderNavGrid& Grid)
+{
+	int64 Edges = 0;
+	for (const FSpiderNavNode& Node : Grid.NavNodes)
+		Edges += Node.Neighbors.Num();
+	return Edges;
+}
+
+void FSpiderNavSyntheticGrid::GenerateCaves(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	FRandomStream Random(Params.Seed);
+	TSet<FIntVector> Empty;
+
+	auto Carve = [&Empty](const FIntVector& Center, int32 R)
+		{
+			for (int32 x = -R; x <= R; ++x)
+				for (int32 y = -R; y <= R; ++y)
+					for (int32 z = -R; z <= R; ++z)
+						if (x * x + y * y + z * z <= R * R)
+							Empty.Add(Center + FIntVector(x, y, z));
+		};
+
+	// Random walks with inertia: tunnels with occasional chambers
+	FIntVector Cursor(0, 0, 0);
+	int32 Dir = 0;
+	auto CarveWalk = [&](int32 Steps)
+		{
+			for (int32 i = 0; i < Steps; ++i)
+			{
+				if (Random.FRand() < 0.2f)
+					Dir = Random.RandHelper(6);
+				Cursor += CAVE_DIRS[Dir];
+				Carve(Cursor, Random.FRand() < 0.02f ? Random.RandRange(4, 6) : Random.RandRange(1, 2));
+			}
+
+			// Next walk starts at an existing cell -> everything stays connected
+			Cursor += CAVE_DIRS[Random.RandHelper(6)] * Random.RandRange(0, 2);
+		};
+
+	auto CountSurface = [&Empty]()
+		{
+			int32 Count = 0;
+			for (const FIntVector& Cell : Empty)
+			{
+				for (const FIntVector& D : CAVE_DIRS)
+				{
+					if (!Empty.Contains(Cell + D))
+					{
+						++Count;
+						break;
+					}
+				}
+			}
+			return Count;
+		};
+
+	const int32 Target = FMath::Max(Params.TargetNodes, 1);
+	int32 Surface = 0;
+	for (int32 Round = 0; Round < 32 && Surface < Target; ++Round)
+	{
+		// Carve roughly towards the target, then measure again
+		const int32 Missing = Target - Surface;
+		CarveWalk(FMath::Max(64, Missing / 16));
+		Surface = CountSurface();
+	}
+
+	Locations.Reserve(Surface);
+	Normals.Reserve(Surface);
+	for (const FIntVector& Cell : Empty)
+	{
+		FVector Away = FVector::ZeroVector;
+		FVector FirstSolid = FVector::ZeroVector;
+		for (const FIntVector& D : CAVE_DIRS)
+		{
+			if (!Empty.Contains(Cell + D))
+			{
+				Away -= FVector(D);
+				if (FirstSolid.IsZero())
+					FirstSolid = FVector(D);
+			}
+		}
+		if (FirstSolid.IsZero())
+			continue;
+
+		Locations.Add(FVector(Cell) * Params.Step);
+		Normals.Add(Away.IsNearlyZero() ? -FirstSolid : Away.GetSafeNormal());
+	}
+}
+
+void FSpiderNavSyntheticGrid::GenerateStackedFloors(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	const int32 Target = FMath::Max(Params.TargetNodes, 16);
+	const int32 Floors = FMath::Clamp(Target / 2500, 2, 16);
+	const int32 Side = FMath::Max(2, FMath::FloorToInt(FMath::Sqrt((float)Target / Floors)));
+	const float Step = Params.Step;
+
+	Locations.Reserve(Floors * Side * (Side + FLOOR_HEIGHT));
+	Normals.Reserve(Floors * Side * (Side + FLOOR_HEIGHT));
+
+	for (int32 Floor = 0; Floor < Floors; ++Floor)
+	{
+		const float Z = Floor * FLOOR_HEIGHT * Step;
+		for (int32 i = 0; i < Side; ++i)
+		{
+			for (int32 j = 0; j < Side; ++j)
+			{
+				Locations.Emplace(i * Step, j * Step, Z);
+				Normals.Add(FVector::UpVector);
+			}
+		}
+
+		if (Floor + 1 == Floors)
+			break;
+
+		// Wall to the next floor alternates left/right -> paths zigzag
+		const bool bMinSide = Floor % 2 == 0;
+		const float X = bMinSide ? -0.5f * Step : (Side - 0.5f) * Step;
+		const FVector Normal = bMinSide ? FVector::ForwardVector : -FVector::ForwardVector;
+		for (int32 Row = 1; Row < FLOOR_HEIGHT; ++Row)
+		{
+			for (int32 j = 0; j < Side; ++j)
+			{
+				Locations.Emplace(X, j * Step, Z + Row * Step);
+				Normals.Add(Normal);
+			}
+		}
+	}
+}
+
+void FSpiderNavSyntheticGrid::GenerateCubeRooms(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	const int32 R = ROOM_SIZE;
+	const int32 NodesPerRoom = 6 * R * R;
+	const int32 Rooms = FMath::Max(1, FMath::DivideAndRoundUp(FMath::Max(Params.TargetNodes, 1), NodesPerRoom));
+	const int32 RoomsX = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Rooms)));
+	const int32 RoomsY = FMath::DivideAndRoundUp(Rooms, RoomsX);
+	const float Step = Params.Step;
+	const float Pitch = (R + 1) * Step;
+
+	// Door per room and direction from the seed -> both sides of a wall see the same decision.
+	// Some stay closed, so paths take detours and some rooms are unreachable
+	auto HasDoor = [&Params](int32 Room, int32 Axis)
+		{
+			FRandomStream DoorRandom(HashCombine(GetTypeHash(Params.Seed), GetTypeHash(Room * 2 + Axis)));
+			return DoorRandom.FRand() < 0.8f;
+		};
+
+	Locations.Reserve(Rooms * NodesPerRoom);
+	Normals.Reserve(Rooms * NodesPerRoom);
+
+	auto Add = [&](const FVector& Location, const FVector& Normal)
+		{
+			Locations.Add(Location);
+			Normals.Add(Normal);
+		};
+
+	for (int32 Room = 0; Room < Rooms; ++Room)
+	{
+		const int32 RX = Room % RoomsX;
+		const int32 RY = Room / RoomsX;
+		const FVector Origin(RX * Pitch, RY * Pitch, 0.f);
+
+		const bool bDoorPosX = RX + 1 < RoomsX && Room + 1 < Rooms && HasDoor(Room, 0);
+		const bool bDoorPosY = RY + 1 < RoomsY && Room + RoomsX < Rooms && HasDoor(Room, 1);
+		const bool bDoorNegX = RX > 0 && HasDoor(Room - 1, 0);
+		const bool bDoorNegY = RY > 0 && HasDoor(Room - RoomsX, 1);
+
+		for (int32 i = 0; i < R; ++i)
+		{
+			for (int32 j = 0; j < R; ++j)
+			{
+				Add(Origin + FVector(i, j, 0.f) * Step, FVector::UpVector);
+				Add(Origin + FVector(i, j, R) * Step, -FVector::UpVector);
+			}
+		}
+
+		for (int32 Row = 1; Row < R; ++Row)
+		{
+			for (int32 k = 0; k < R; ++k)
+			{
+				if (!(bDoorNegX && IsDoorCell(k, Row)))
+					Add(Origin + FVector(-0.5f, k, Row) * Step, FVector::ForwardVector);
+				if (!(bDoorPosX && IsDoorCell(k, Row)))
+					Add(Origin + FVector(R - 0.5f, k, Row) * Step, -FVector::ForwardVector);
+				if (!(bDoorNegY && IsDoorCell(k, Row)))
+					Add(Origin + FVector(k, -0.5f, Row) * Step, FVector::RightVector);
+				if (!(bDoorPosY && IsDoorCell(k, Row)))
+					Add(Origin + FVector(k, R - 0.5f, Row) * Step, -FVector::RightVector);
+			}
+		}
+
+		// Threshold between the rooms
+		for (int32 k = 0; k < R; ++k)
+		{
+			if (!IsDoorCell(k, 0))
+				continue;
+			if (bDoorPosX)
+				Add(Origin + FVector(R, k, 0.f) * Step, FVector::UpVector);
+			if (bDoorPosY)
+				Add(Origin + FVector(k, R, 0.f) * Step, FVector::UpVector);
+		}
+	}
+}
+
+void FSpiderNavSyntheticGrid::GenerateRandomGeometric(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals, float& OutRadius)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	const int32 Num = FMath::Max(Params.TargetNodes, 2);
+	OutRadius = Params.Step * 1.5f;
+
+	// Cube edge chosen so that on average RGG_DEGREE neighbours lie within OutRadius
+	const double Side = OutRadius * FMath::Pow(4.0 / 3.0 * PI * Num / RGG_DEGREE, 1.0 / 3.0);
+
+	FRandomStream Random(Params.Seed);
+	Locations.SetNumUninitialized(Num);
+	Normals.SetNumUninitialized(Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Locations[i] = FVector(Random.FRand(), Random.FRand(), Random.FRand()) * Side;
+		Normals[i] = Random.GetUnitVector();
+	}
+}
+
+void FSpiderNavSyntheticGrid::Link(const TArray<FVector>& Locations, const TArray<FVector>& Normals, float Radius, FSavedSpiderNavGrid& OutGrid)
+{
+	using namespace SpiderNavSyntheticGridPrivate;
+
+	const int32 Num = Locations.Num();
+	OutGrid = FSavedSpiderNavGrid();
+	OutGrid.NavNodes.SetNum(Num);
+	OutGrid.NodesSavedIndexes.Reserve(Num);
+
+	TMap<FIntVector, TArray<int32>> Cells;
+	Cells.Reserve(Num / 4);
+	for (int32 i = 0; i < Num; ++i)
+		Cells.FindOrAdd(CellOf(Locations[i], Radius)).Add(i);
+
+	const double RadiusSq = FMath::Square((double)Radius);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		FSpiderNavNode& Node = OutGrid.NavNodes[i];
+		Node.Location = Locations[i];
+		Node.Normal = Normals[i];
+		Node.Index = i;
+		OutGrid.NodesSavedIndexes.Add(i, i);
+
+		const FIntVector Cell = CellOf(Locations[i], Radius);
+		for (int32 x = -1; x <= 1; ++x)
+		{
+			for (int32 y = -1; y <= 1; ++y)
+			{
+				for (int32 z = -1; z <= 1; ++z)
+				{
+					const TArray<int32>* Bucket = Cells.Find(Cell + FIntVector(x, y, z));
+					if (!Bucket)
+						continue;
+
+					for (int32 j : *Bucket)
+					{
+						if (j != i && FVector::DistSquared(Locations[i], Locations[j]) <= RadiusSq)
+							Node.Neighbors.Add(&OutGrid.NavNodes[j]);
+					}
+				}
+			}
+		}
+	}
+}
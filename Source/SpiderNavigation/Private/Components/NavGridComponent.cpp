@@ -4,16 +4,35 @@
 #include "Components/NavGridComponent.h"
 
 #include "Subsystems/SpiderNavigationSubsystem.h"
+#include "Components/SpiderNavGridVisualizerComponent.h"
+#include "Components/BoxComponent.h"
+#include "SpiderNavCostModifierVolume.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "Engine/GameInstance.h"
+#include "Planning/SpiderNavPathCache.h"
+#include "Planning/SpiderNavPathSmoothing.h"
 
 #include "Structs/SpiderNavNode.h"
+#include "SpiderNavigationStats.h"
+#include "SpiderNavigationDiagnostics.h"
 
 DEFINE_LOG_CATEGORY(NavGridComponent_LOG);
+
+// Older changes are dropped, planners that far behind rebuild
+static constexpr int32 MAX_GRID_CHANGES = 64;
+
 UNavGridComponent::UNavGridComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
 
 	bAutoLoadGrid = true;
+	bUsePathCache = true;
+	SmoothingMaxNormalAngle = 10.0f;
+	SmoothingTolerance = 20.0f;
 	DebugLinesThickness = 0.0f;
+	WallCostMultiplier = 1.0f;
+	CeilingCostMultiplier = 1.0f;
 }
 
 
@@ -26,11 +45,35 @@ void UNavGridComponent::BeginPlay()
 	}
 }
 
+void UNavGridComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DEC_MEMORY_STAT_BY(STAT_SpiderNav_GridMemory, LoadedGrid.GetAllocatedSize());
+	DEC_DWORD_STAT_BY(STAT_SpiderNav_LoadedNodes, LoadedGrid.NavNodes.Num());
+
+	if (UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		if (USpiderNavigationSubsystem* NavSubsystem = GameInstance->GetSubsystem<USpiderNavigationSubsystem>())
+			NavSubsystem->ReleasePathCache(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UNavGridComponent::LoadGrid()
 {
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_ComponentLoadGrid);
+	SCOPE_CYCLE_COUNTER(STAT_SpiderNav_LoadGrid);
+
 	if (USpiderNavigationSubsystem* NavSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<USpiderNavigationSubsystem>())
 	{
-		LoadedGrid = NavSubsystem->LoadGrid("SpiderNavGridSave", 0);
+		const double LoadStart = FPlatformTime::Seconds();
+		SetGrid(NavSubsystem->LoadGrid("SpiderNavGridSave", 0));
+		SET_FLOAT_STAT(STAT_SpiderNav_LoadTimeMs, (FPlatformTime::Seconds() - LoadStart) * 1000.0);
+
+		if (USpiderNavGridVisualizerComponent* Visualizer = GetOwner()->FindComponentByClass<USpiderNavGridVisualizerComponent>())
+		{
+			Visualizer->SetGrid(LoadedGrid);
+		}
 	}
 	else
 	{
@@ -38,204 +81,311 @@ void UNavGridComponent::LoadGrid()
 	}
 }
 
-TArray<FVector> UNavGridComponent::FindPath(FVector Start, FVector End, bool& bFoundCompletePath)
+void UNavGridComponent::SetGrid(FSavedSpiderNavGrid&& Grid)
 {
-	TArray<FVector> Path;
+	DEC_MEMORY_STAT_BY(STAT_SpiderNav_GridMemory, LoadedGrid.GetAllocatedSize());
+	DEC_DWORD_STAT_BY(STAT_SpiderNav_LoadedNodes, LoadedGrid.NavNodes.Num());
+
+	LoadedGrid = MoveTemp(Grid);
+	LoadedGrid.BuildQueryData(MakeCostSettings());
+	Obstacles.Rebuild(LoadedGrid);
+	GridChanges.Reset();
+	++GridVersion;
+	++GridLayoutVersion;
+
+	INC_DWORD_STAT_BY(STAT_SpiderNav_LoadedNodes, LoadedGrid.NavNodes.Num());
+	INC_MEMORY_STAT_BY(STAT_SpiderNav_GridMemory, LoadedGrid.GetAllocatedSize());
+}
 
-	FSpiderNavNode* StartNode = FindClosestNode(Start);
-	FSpiderNavNode* EndNode = FindClosestNode(End);
-	TArray<FSpiderNavNode*> NodesPath = FindNodesPath(StartNode, EndNode, bFoundCompletePath);
+FSpiderNavCostSettings UNavGridComponent::MakeCostSettings() const
+{
+	FSpiderNavCostSettings Costs;
+	Costs.WallCostMultiplier = WallCostMultiplier;
+	Costs.CeilingCostMultiplier = CeilingCostMultiplier;
 
-	for (int32 i = 0; i < NodesPath.Num(); i++) {
-		FSpiderNavNode* Node = NodesPath[i];
-		Path.Add(Node->Location);
-	}
+	if (UWorld* World = GetWorld())
+	{
+		for (TActorIterator<ASpiderNavCostModifierVolume> It(World); It; ++It)
+		{
+			const UBoxComponent* Box = It->GetVolume();
+			if (!Box)
+				continue;
 
-	return Path;
+			FSpiderNavCostSettings::FArea& Area = Costs.Areas.AddDefaulted_GetRef();
+			Area.Transform = Box->GetComponentTransform();
+			Area.Transform.SetScale3D(FVector::OneVector);
+			Area.Extent = Box->GetScaledBoxExtent();
+			Area.Multiplier = It->GetCostMultiplier();
+		}
+	}
+	return Costs;
 }
 
-TArray<FSpiderNavNode*> UNavGridComponent::FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode, bool& bFoundCompletePath)
+void UNavGridComponent::UpdateObstacle(const UObject* Obstacle, const FTransform& Transform, const FVector& Extent)
 {
-	TArray<FSpiderNavNode*> Path;
-	FSpiderNavNode* Node = NULL;
-	TArray <FSpiderNavNode*> Neighbors;
-
-	if (!StartNode || !EndNode) {
-		//GEngine->AddOnScreenDebugMessage(0, 1.0f, FColor::Yellow, TEXT("Not found closest nodes"));
-		UE_LOG(NavGridComponent_LOG, Warning, TEXT("Not found closest nodes"));
-		return Path;
+	const FBox Changed = Obstacles.Update(LoadedGrid, Obstacle, Transform, Extent);
+	if (Changed.IsValid)
+	{
+		RecordGridChange(Changed);
+		SPIDERNAV_LOG(GetOwner(), Verbose, TEXT("Obstacle %s changed %s, grid version %u"), *GetNameSafe(Obstacle), *Changed.ToString(), GridVersion);
+		OnGridChanged.Broadcast(GridVersion, Changed);
 	}
+}
 
+void UNavGridComponent::RemoveObstacle(const UObject* Obstacle)
+{
+	const FBox Changed = Obstacles.Remove(Obstacle);
+	if (Changed.IsValid)
+	{
+		RecordGridChange(Changed);
+		SPIDERNAV_LOG(GetOwner(), Verbose, TEXT("Obstacle %s removed, grid version %u"), *GetNameSafe(Obstacle), GridVersion);
+		OnGridChanged.Broadcast(GridVersion, Changed);
+	}
+}
 
-	ResetGridMetrics();
-	//OpenList.Empty();
-	std::vector<FSpiderNavNode*> openList;
-	TArray<FSpiderNavNode*> ClosedList;
+void UNavGridComponent::RecordGridChange(const FBox& ChangedBounds)
+{
+	++GridVersion;
+	if (GridChanges.Num() >= MAX_GRID_CHANGES)
+		GridChanges.RemoveAt(0);
+	GridChanges.Emplace(GridVersion, ChangedBounds);
+}
 
-	//OpenList.Add(StartNode);
-	openList.push_back(StartNode);
-	std::make_heap(openList.begin(), openList.end(), LessThanByNodeF());
-	StartNode->Opened = true;
+TArray<FVector> UNavGridComponent::FindPath(FVector Start, FVector End, bool& bFoundCompletePath)
+{
+	return FindPathWithParams(Start, End, DefaultQueryParams, bFoundCompletePath);
+}
 
+TArray<FVector> UNavGridComponent::FindPathWithParams(FVector Start, FVector End, const FSpiderNavQueryParams& Params, bool& bFoundCompletePath)
+{
+	FindPathInto(Start, End, Params, QueryResult);
+	bFoundCompletePath = QueryResult.bComplete;
+	return QueryResult.Locations;
+}
 
-	while (openList.size()) {
-		//Node = GetFromOpenList();
-		std::pop_heap(openList.begin(), openList.end(), LessThanByNodeF());
-		Node = openList.back();
-		openList.pop_back();
+bool UNavGridComponent::FindPathInto(const FVector& Start, const FVector& End, const FSpiderNavQueryParams& Params, FSpiderNavPathResult& OutResult)
+{
+	FindNodesPath(FindClosestNode(Start), FindClosestNode(End), Params, OutResult);
+	if (Params.bSmoothPath) {
+		FSpiderNavPathSmoothing::Smooth(OutResult, LoadedGrid, Obstacles, SmoothingMaxNormalAngle, SmoothingTolerance);
+	}
+	return !OutResult.IsEmpty();
+}
 
-		Node->Closed = true;
-		if (Node != StartNode) {
-			ClosedList.Add(Node);
+void UNavGridComponent::FindPathsBatch(TConstArrayView<FSpiderNavPathQuery> Queries, const FSpiderNavQueryParams& Params, TArray<FSpiderNavPathResult>& OutResults)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindPathsBatch);
+	SCOPE_CYCLE_COUNTER(STAT_SpiderNav_FindPath);
+
+	const int32 NumQueries = Queries.Num();
+	OutResults.SetNum(NumQueries);
+	BatchStarts.SetNumUninitialized(NumQueries);
+	BatchEnds.SetNumUninitialized(NumQueries);
+	BatchGoals.SetNumUninitialized(NumQueries);
+
+	// All closest-node lookups in one parallel pass, the spatial index is only read.
+	// Unreachable goals are replaced by the closest node of the start's component, as in FindNodesPath
+	ParallelFor(NumQueries, [&](int32 i)
+	{
+		const int32 Start = LoadedGrid.FindClosestNodeIndex(Queries[i].Start);
+		const int32 End = LoadedGrid.FindClosestNodeIndex(Queries[i].End);
+		int32 Goal = End;
+		if (Start != INDEX_NONE && End != INDEX_NONE && LoadedGrid.NavNodes[Start].ComponentId != LoadedGrid.NavNodes[End].ComponentId) {
+			const int32 ReachableIndex = LoadedGrid.FindClosestNodeIndex(LoadedGrid.NavNodes[End].Location, LoadedGrid.NavNodes[Start].ComponentId);
+			if (ReachableIndex != INDEX_NONE) {
+				Goal = ReachableIndex;
+			}
 		}
-
-		if (Node->Index == EndNode->Index) {
-			bFoundCompletePath = true;
-			return BuildNodesPathFromEndNode(Node);
+		BatchStarts[i] = Start;
+		BatchEnds[i] = End;
+		BatchGoals[i] = Goal;
+	});
+	INC_DWORD_STAT_BY(STAT_SpiderNav_ClosestNodeLookups, NumQueries * 2);
+
+	// The cache is not thread safe: hits are looked up up front on the game thread
+	FSpiderNavPathCache* PathCache = GetPathCache();
+	BatchPending.Reset();
+	for (int32 i = 0; i < NumQueries; ++i) {
+		FSpiderNavPathResult& Result = OutResults[i];
+		Result.Reset();
+		if (BatchStarts[i] == INDEX_NONE || BatchEnds[i] == INDEX_NONE) {
+			continue;
 		}
-
-		for (FSpiderNavNode* Neighbor : Node->Neighbors) {
-
-			if (Neighbor->Closed) {
-				continue;
-			}
-
-			//DrawDebugString(GetWorld(), Neighbor->Location, *FString::Printf(TEXT("[%d]"), Neighbor->Neighbors.Num()), NULL, FLinearColor(0.0f, 1.0f, 0.0f, 1.0f).ToFColor(true), 20.0f, false);
-
-			// get the distance between current node and the neighbor
-			// and calculate the next g score
-			float NewG = Node->G + (Neighbor->Location - Node->Location).Size();
-
-			// check if the neighbor has not been inspected yet, or
-			// can be reached with smaller cost from the current node
-			if (!Neighbor->Opened || NewG < Neighbor->G) {
-				Neighbor->G = NewG;
-				Neighbor->H = (Neighbor->Location - EndNode->Location).Size();
-				Neighbor->F = Neighbor->G + Neighbor->H;
-				Neighbor->ParentIndex = Node->Index;
-
-				if (!Neighbor->Opened) {
-					//OpenList.Add(Neighbor);
-					openList.push_back(Neighbor);
-					std::push_heap(openList.begin(), openList.end(), LessThanByNodeF());
-					Neighbor->Opened = true;
-				}
-				else {
-					// the neighbor can be reached with smaller cost.
-					// Since its f value has been updated, we have to
-					// update its position in the open list
-					std::make_heap(openList.begin(), openList.end(), LessThanByNodeF());
-				}
-			}
+		if (PathCache && PathCache->Find(BatchStarts[i], BatchEnds[i], GridVersion, Result.NodeIndices, Result.bComplete)) {
+			Result.FillFromIndices(LoadedGrid);
+			continue;
 		}
+		BatchPending.Add(i);
 	}
 
-	UE_LOG(NavGridComponent_LOG, Warning, TEXT("Not found complete path"));
-
+	BatchSearch.Run(LoadedGrid, Obstacles, Params, BatchPending, BatchStarts, BatchGoals, OutResults, BatchExpansions, BatchOpenListPeaks);
 
-	//Finding closest to end
-	float IterMin = 99999999999.0f;
-	for (FSpiderNavNode* IterNode : ClosedList) {
-		if (IterNode->F < IterMin) {
-			IterMin = IterNode->F;
-			Node = IterNode;
+	int32 TotalExpansions = 0;
+	int32 MaxOpenListPeak = 0;
+	for (const int32 i : BatchPending) {
+		FSpiderNavPathResult& Result = OutResults[i];
+		if (BatchGoals[i] != BatchEnds[i]) {
+			INC_DWORD_STAT(STAT_SpiderNav_CrossComponent);
+			Result.bComplete = false;
+		}
+		ReportSearch(BatchExpansions[i], BatchOpenListPeaks[i], Result);
+		TotalExpansions += BatchExpansions[i];
+		MaxOpenListPeak = FMath::Max(MaxOpenListPeak, BatchOpenListPeaks[i]);
+		if (PathCache && Params.IsOptimal()) {
+			PathCache->Add(BatchStarts[i], BatchEnds[i], GridVersion, Result.NodeIndices, Result.bComplete);
 		}
-		//DrawDebugString(GetWorld(), closedList[i]->Location, *FString::Printf(TEXT("[%f, %f]"), closedList[i]->F, closedList[i]->H), NULL, FLinearColor(0.0f, 1.0f, 0.0f, 1.0f).ToFColor(true), DebugLinesThickness, false);
 	}
+	// LastSearchStats describes the whole batch: complete only if every query is
+	LastSearchStats.Expansions = TotalExpansions;
+	LastSearchStats.OpenListPeak = MaxOpenListPeak;
+	LastSearchStats.bComplete = !OutResults.ContainsByPredicate([](const FSpiderNavPathResult& Result) { return !Result.bComplete; });
 
-	if (Node) {
-		UE_LOG(NavGridComponent_LOG, Log, TEXT("Min F = %f"), Node->F);
-		bFoundCompletePath = false;
-		//DrawDebugString(GetWorld(), Node->Location, *FString::Printf(TEXT("MINH[%f]"), Node->H), NULL, FLinearColor(1.0f, 0.0f, 0.0f, 1.0f).ToFColor(true), DebugLinesThickness, false);
+	SPIDERNAV_LOG(GetOwner(), Verbose, TEXT("Batch of %d queries, %d searched"), NumQueries, BatchPending.Num());
 
-		return BuildNodesPathFromEndNode(Node);
+	if (Params.bSmoothPath) {
+		for (FSpiderNavPathResult& Result : OutResults) {
+			FSpiderNavPathSmoothing::Smooth(Result, LoadedGrid, Obstacles, SmoothingMaxNormalAngle, SmoothingTolerance);
+		}
 	}
+}
 
-
-	return Path;
+TArray<FVector> UNavGridComponent::FindPathIncremental(FSpiderNavIncrementalPlanner& Planner, FVector Start, FVector End, bool& bFoundCompletePath)
+{
+	FindPathIncremental(Planner, Start, End, QueryResult);
+	bFoundCompletePath = QueryResult.bComplete;
+	return QueryResult.Locations;
 }
 
-FSpiderNavNode* UNavGridComponent::GetFromOpenList()
+bool UNavGridComponent::FindPathIncremental(FSpiderNavIncrementalPlanner& Planner, const FVector& Start, const FVector& End, FSpiderNavPathResult& OutResult)
 {
-	float MinF = 9999999999.0f;
-	FSpiderNavNode* MinNode = NULL;
-	for (FSpiderNavNode* Node : OpenList) {
-		if (Node->F < MinF) {
-			MinF = Node->F;
-			MinNode = Node;
-		}
-	}
-	if (MinNode) {
-		OpenList.Remove(MinNode);
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindPathIncremental);
+	SCOPE_CYCLE_COUNTER(STAT_SpiderNav_FindPath);
+
+	OutResult.Reset();
+	LastSearchStats = FSpiderNavSearchStats();
+
+	FSpiderNavNode* StartNode = FindClosestNode(Start);
+	FSpiderNavNode* EndNode = FindClosestNode(End);
+	if (!StartNode || !EndNode) {
+		SPIDERNAV_LOG(GetOwner(), Warning, TEXT("No closest nodes, grid not loaded?"));
+		return false;
 	}
 
-	return MinNode;
-}
+	// Bring the planner to the current grid version: replay the changes or, if the history
+	// does not reach back far enough (or SetGrid happened in between), drop the tree
+	if (Planner.GridVersion != GridVersion) {
+		const bool bHistoryCovers = Planner.HasTree() && GridChanges.Num() > 0
+			&& Planner.GridVersion + 1 >= GridChanges[0].Key && Planner.GridVersion < GridVersion;
+		if (bHistoryCovers) {
+			for (const TPair<uint32, FBox>& Change : GridChanges) {
+				if (Change.Key > Planner.GridVersion) {
+					Planner.NotifyChanged(LoadedGrid, Obstacles, Change.Value);
+				}
+			}
+		}
+		else {
+			Planner.Reset();
+		}
+		Planner.GridVersion = GridVersion;
+	}
 
-FSpiderNavNode* UNavGridComponent::FindClosestNode(FVector Location)
-{
-	FSpiderNavNode* ClosestNode = nullptr;
-	float MinDistance = 999999999.f;
-	for (int32 i = 0; i != LoadedGrid.NavNodes.Num(); i++) {
-		float Distance = (LoadedGrid.NavNodes[i].Location - Location).Size();
-		if (Distance < MinDistance) {
-			MinDistance = Distance;
-			ClosestNode = &(LoadedGrid.NavNodes[i]);
+	// as in FindNodesPath: replace an unreachable goal by the closest node of the start's component
+	int32 GoalIndex = EndNode->Index;
+	const bool bCrossComponent = StartNode->ComponentId != EndNode->ComponentId;
+	if (bCrossComponent) {
+		INC_DWORD_STAT(STAT_SpiderNav_CrossComponent);
+		const int32 ReachableIndex = LoadedGrid.FindClosestNodeIndex(EndNode->Location, StartNode->ComponentId);
+		if (ReachableIndex != INDEX_NONE) {
+			GoalIndex = ReachableIndex;
 		}
 	}
 
-	return ClosestNode;
-}
+	bool bComplete = false;
+	Planner.Plan(LoadedGrid, Obstacles, StartNode->Index, GoalIndex, OutResult.NodeIndices, bComplete);
+	OutResult.bComplete = bComplete && !bCrossComponent;
+	OutResult.FillFromIndices(LoadedGrid);
 
-void UNavGridComponent::ResetGridMetrics()
-{
-	for (int32 i = 0; i != LoadedGrid.NavNodes.Num(); ++i) {
-		FSpiderNavNode Node = LoadedGrid.NavNodes[i];
-		Node.ResetMetrics();
-		LoadedGrid.NavNodes[i] = Node;
-	}
+	SPIDERNAV_LOG(GetOwner(), VeryVerbose, TEXT("Incremental path %d -> %d: %d nodes, %d expansions%s"),
+		StartNode->Index, GoalIndex, OutResult.Num(), Planner.GetLastExpansions(), Planner.WasLastPlanIncremental() ? TEXT(" (reused)") : TEXT(""));
+	ReportSearch(Planner.GetLastExpansions(), Planner.GetLastOpenListPeak(), OutResult);
+	return !OutResult.IsEmpty();
 }
 
-TArray<FVector> UNavGridComponent::BuildPathFromEndNode(FSpiderNavNode* EndNode)
+void UNavGridComponent::FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode, const FSpiderNavQueryParams& Params, FSpiderNavPathResult& OutResult)
 {
-	TArray<FVector> Path;
-	TArray<int32> ReversedPathIndexes;
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindNodesPath);
+	SCOPE_CYCLE_COUNTER(STAT_SpiderNav_FindPath);
 
-	ReversedPathIndexes.Add(EndNode->Index);
+	OutResult.Reset();
+	LastSearchStats = FSpiderNavSearchStats();
 
-	FSpiderNavNode* IterNode = EndNode;
-	while (IterNode->ParentIndex > -1) {
-		ReversedPathIndexes.Add(IterNode->ParentIndex);
-		IterNode = &LoadedGrid.NavNodes[IterNode->ParentIndex];
+	if (!StartNode || !EndNode) {
+		SPIDERNAV_LOG(GetOwner(), Warning, TEXT("No closest nodes, grid not loaded?"));
+		return;
 	}
 
-	for (int32 i = ReversedPathIndexes.Num() - 1; i > -1; i--) {
-		int32 Index = ReversedPathIndexes[i];
-		Path.Add(LoadedGrid.NavNodes[Index].Location);
+	// Same query or start on a cached path to the same goal -> no search
+	FSpiderNavPathCache* PathCache = GetPathCache();
+	if (PathCache && PathCache->Find(StartNode->Index, EndNode->Index, GridVersion, OutResult.NodeIndices, OutResult.bComplete)) {
+		OutResult.FillFromIndices(LoadedGrid);
+		LastSearchStats.bComplete = OutResult.bComplete;
+		return;
+	}
+	// Indices are already in OutResult: fill the rest, report and
+	// share only shortest paths; Weighted/Anytime may still read cached ones
+	auto FinishPath = [&](bool bComplete, int32 SearchExpansions, int32 SearchOpenListPeak) {
+		OutResult.bComplete = bComplete;
+		OutResult.FillFromIndices(LoadedGrid);
+		ReportSearch(SearchExpansions, SearchOpenListPeak, OutResult);
+		if (PathCache && Params.IsOptimal()) {
+			PathCache->Add(StartNode->Index, EndNode->Index, GridVersion, OutResult.NodeIndices, bComplete);
+		}
+	};
+
+
+	// Goal in another connected component: do not flood the whole component,
+	// search straight to the closest node of the start's component instead
+	FSpiderNavNode* GoalNode = EndNode;
+	const bool bCrossComponent = StartNode->ComponentId != EndNode->ComponentId;
+	if (bCrossComponent) {
+		INC_DWORD_STAT(STAT_SpiderNav_CrossComponent);
+		const int32 ReachableIndex = LoadedGrid.FindClosestNodeIndex(EndNode->Location, StartNode->ComponentId);
+		if (ReachableIndex != INDEX_NONE) {
+			GoalNode = &LoadedGrid.NavNodes[ReachableIndex];
+		}
+		SPIDERNAV_LOG(GetOwner(), Verbose, TEXT("Goal %d unreachable (component %d vs %d), searching to %d"),
+			EndNode->Index, EndNode->ComponentId, StartNode->ComponentId, GoalNode->Index);
 	}
 
-	return Path;
-}
-
-TArray<FSpiderNavNode*> UNavGridComponent::BuildNodesPathFromEndNode(FSpiderNavNode* EndNode)
-{
-	TArray<FSpiderNavNode*> Path;
-	TArray<int32> ReversedPathIndexes;
-
-	ReversedPathIndexes.Add(EndNode->Index);
-
-	FSpiderNavNode* IterNode = EndNode;
-	while (IterNode->ParentIndex > -1) {
-		ReversedPathIndexes.Add(IterNode->ParentIndex);
-		IterNode = &LoadedGrid.NavNodes[IterNode->ParentIndex];
+	if (Params.Mode == ESpiderNavSearchMode::Bidirectional) {
+		bool bComplete = false;
+		BidirectionalSearch.Search(LoadedGrid, Obstacles, StartNode->Index, GoalNode->Index, OutResult.NodeIndices, bComplete);
+		FinishPath(bComplete && !bCrossComponent, BidirectionalSearch.GetLastExpansions(), BidirectionalSearch.GetLastOpenListPeak());
+		return;
 	}
 
-	for (int32 i = ReversedPathIndexes.Num() - 1; i > -1; i--) {
-		int32 Index = ReversedPathIndexes[i];
-		Path.Add(&LoadedGrid.NavNodes[Index]);
+	// A* and Weighted are the first ARA* pass with epsilon 1 or Epsilon and no improvement; Anytime improves until the deadline
+	const float Epsilon = Params.Mode == ESpiderNavSearchMode::AStar ? 1.f : Params.Epsilon;
+	const double Deadline = Params.Mode == ESpiderNavSearchMode::Anytime ? Params.DeadlineMs / 1000.0 : 0.0;
+	bool bComplete = false;
+	AnytimeSearch.Search(LoadedGrid, Obstacles, StartNode->Index, GoalNode->Index, Epsilon, Deadline, OutResult.NodeIndices, bComplete);
+	if (Params.Mode == ESpiderNavSearchMode::Anytime) {
+		SPIDERNAV_LOG(GetOwner(), VeryVerbose, TEXT("Anytime search: %d passes, epsilon %.2f"), AnytimeSearch.GetLastPasses(), AnytimeSearch.GetLastEpsilon());
 	}
+	if (!bComplete) {
+		SPIDERNAV_LOG(GetOwner(), Verbose, TEXT("No complete path from %d to %d"), StartNode->Index, EndNode->Index);
+	}
+	FinishPath(bComplete && !bCrossComponent, AnytimeSearch.GetLastExpansions(), AnytimeSearch.GetLastOpenListPeak());
+}
+
+FSpiderNavNode* UNavGridComponent::FindClosestNode(FVector Location)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindClosestNode);
+	SCOPE_CYCLE_COUNTER(STAT_SpiderNav_FindClosestNode);
+	INC_DWORD_STAT(STAT_SpiderNav_ClosestNodeLookups);
 
-	return Path;
+	const int32 ClosestIndex = LoadedGrid.FindClosestNodeIndex(Location);
+	return ClosestIndex != INDEX_NONE ? &LoadedGrid.NavNodes[ClosestIndex] : nullptr;
 }
 
 FVector UNavGridComponent::FindClosestNodeLocation_Implementation(FVector Location)
@@ -262,139 +412,79 @@ bool UNavGridComponent::FindNextLocationAndNormal(FVector CurrentLocation, FVect
 {
 	FSpiderNavNode* StartNode = FindClosestNode(CurrentLocation);
 	FSpiderNavNode* EndNode = FindClosestNode(TargetLocation);
-	bool bFoundPartialPath;
-
-	FSpiderNavNode* NextNode = NULL;
-
-	TArray<FSpiderNavNode*> NodesPath = FindNodesPath(StartNode, EndNode, bFoundPartialPath);
-
-	if (NodesPath.Num() > 1) {
-		NextNode = NodesPath[1];
+	if (!StartNode || !EndNode) {
+		return false;
 	}
 
-	if (!NextNode) {
+	const int32 NextIndex = FindNextHop(StartNode->Index, EndNode->Index);
+	if (NextIndex == INDEX_NONE) {
 		return false;
 	}
 
-	NextLocation = NextNode->Location;
-	Normal = NextNode->Normal;
+	NextLocation = LoadedGrid.NavNodes[NextIndex].Location;
+	Normal = LoadedGrid.NavNodes[NextIndex].Normal;
 
 	return true;
 }
 
-TArray<FVector> UNavGridComponent::FindPathBetweenPoints_Implementation(FVector StartLocation, FVector EndLocation)
+int32 UNavGridComponent::FindNextHop(int32 StartNode, int32 GoalNode)
 {
-	TArray<FVector> Path;
-
-	FSpiderNavNode* StartNode = FindClosestNode(StartLocation);
-	FSpiderNavNode* EndNode = FindClosestNode(EndLocation);
-	TArray<FSpiderNavNode*> NodesPath = FindNodesPath(StartNode, EndNode);
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindNextHop);
+	INC_DWORD_STAT(STAT_SpiderNav_NextHops);
 
-	for (int32 i = 0; i < NodesPath.Num(); i++) {
-		FSpiderNavNode* Node = NodesPath[i];
-		Path.Add(Node->Location);
+	if (StartNode == GoalNode || !LoadedGrid.NavNodes.IsValidIndex(StartNode) || !LoadedGrid.NavNodes.IsValidIndex(GoalNode)) {
+		return INDEX_NONE;
 	}
 
-	return Path;
-}
-
-TArray<FSpiderNavNode*> UNavGridComponent::FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode)
-{
-	TArray<FSpiderNavNode*> Path;
-	FSpiderNavNode* Node = NULL;
-	TArray <FSpiderNavNode*> Neighbors;
-
-	if (!StartNode || !EndNode) {
-		//GEngine->AddOnScreenDebugMessage(0, 1.0f, FColor::Yellow, TEXT("Not found closest nodes"));
-		UE_LOG(LogTemp, Warning, TEXT("Not found closest nodes"));
-		return Path;
+	// Cache: same query, or the start lies on a cached path to the goal (the spider is walking it)
+	int32 NextIndex = INDEX_NONE;
+	FSpiderNavPathCache* PathCache = GetPathCache();
+	if (PathCache && PathCache->FindNextNode(StartNode, GoalNode, GridVersion, NextIndex)) {
+		return NextIndex;
 	}
 
-
-	ResetGridMetrics();
-	//OpenList.Empty();
-	std::vector<FSpiderNavNode*> openList;
-	TArray<FSpiderNavNode*> ClosedList;
-
-	//OpenList.Add(StartNode);
-	openList.push_back(StartNode);
-	std::make_heap(openList.begin(), openList.end(), LessThanByNodeF());
-	StartNode->Opened = true;
-
-
-	while (openList.size()) {
-		//Node = GetFromOpenList();
-		std::pop_heap(openList.begin(), openList.end(), LessThanByNodeF());
-		Node = openList.back();
-		openList.pop_back();
-
-		Node->Closed = true;
-		if (Node != StartNode) {
-			ClosedList.Add(Node);
-		}
-
-		if (Node->Index == EndNode->Index) {
-			return BuildNodesPathFromEndNode(Node);
-		}
-
-		for (FSpiderNavNode* Neighbor : Node->Neighbors) {
-
-			if (Neighbor->Closed) {
-				continue;
-			}
-
-			//DrawDebugString(GetWorld(), Neighbor->Location, *FString::Printf(TEXT("[%d]"), Neighbor->Neighbors.Num()), NULL, FLinearColor(0.0f, 1.0f, 0.0f, 1.0f).ToFColor(true), 20.0f, false);
-
-			// get the distance between current node and the neighbor
-			// and calculate the next g score
-			float NewG = Node->G + (Neighbor->Location - Node->Location).Size();
-
-			// check if the neighbor has not been inspected yet, or
-			// can be reached with smaller cost from the current node
-			if (!Neighbor->Opened || NewG < Neighbor->G) {
-				Neighbor->G = NewG;
-				Neighbor->H = (Neighbor->Location - EndNode->Location).Size();
-				Neighbor->F = Neighbor->G + Neighbor->H;
-				Neighbor->ParentIndex = Node->Index;
-
-				if (!Neighbor->Opened) {
-					//OpenList.Add(Neighbor);
-					openList.push_back(Neighbor);
-					std::push_heap(openList.begin(), openList.end(), LessThanByNodeF());
-					Neighbor->Opened = true;
-				}
-				else {
-					// the neighbor can be reached with smaller cost.
-					// Since its f value has been updated, we have to
-					// update its position in the open list
-					std::make_heap(openList.begin(), openList.end(), LessThanByNodeF());
-				}
-			}
+	// Flow field of a followed actor on this goal node, O(1)
+	UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	if (USpiderNavigationSubsystem* NavSubsystem = GameInstance ? GameInstance->GetSubsystem<USpiderNavigationSubsystem>() : nullptr) {
+		const int32 Edge = NavSubsystem->FindFlowFieldNextEdge(this, StartNode, GoalNode);
+		if (Edge != INDEX_NONE && !Obstacles.IsEdgeBlocked(Edge)) {
+			return LoadedGrid.EdgeTargets[Edge];
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("Not found complete path"));
-
+	// Search; the path goes into the cache and answers the following ticks along the way.
+	// Always optimal, suboptimal paths are not cached and every tick would search again.
+	// Unsmoothed: the next node has to be a neighbour
+	INC_DWORD_STAT(STAT_SpiderNav_NextHopSearches);
+	FSpiderNavQueryParams NextHopParams = DefaultQueryParams;
+	NextHopParams.Mode = ESpiderNavSearchMode::AStar;
+	FindNodesPath(&LoadedGrid.NavNodes[StartNode], &LoadedGrid.NavNodes[GoalNode], NextHopParams, QueryResult);
+	return QueryResult.Num() > 1 ? QueryResult.NodeIndices[1] : INDEX_NONE;
+}
 
-	//Finding closest to end
-	float IterMin = 99999999999.0f;
-	for (FSpiderNavNode* IterNode : ClosedList) {
-		if (IterNode->F < IterMin) {
-			IterMin = IterNode->F;
-			Node = IterNode;
-		}
-		//DrawDebugString(GetWorld(), closedList[i]->Location, *FString::Printf(TEXT("[%f, %f]"), closedList[i]->F, closedList[i]->H), NULL, FLinearColor(0.0f, 1.0f, 0.0f, 1.0f).ToFColor(true), DebugLinesThickness, false);
-	}
+TArray<FVector> UNavGridComponent::FindPathBetweenPoints_Implementation(FVector StartLocation, FVector EndLocation)
+{
+	bool bFoundCompletePath = false;
+	return FindPath(StartLocation, EndLocation, bFoundCompletePath);
+}
 
-	if (Node) {
-		UE_LOG(LogTemp, Log, TEXT("Min F = %f"), Node->F);
-		//DrawDebugString(GetWorld(), Node->Location, *FString::Printf(TEXT("MINH[%f]"), Node->H), NULL, FLinearColor(1.0f, 0.0f, 0.0f, 1.0f).ToFColor(true), DebugLinesThickness, false);
+FSpiderNavPathCache* UNavGridComponent::GetPathCache() const
+{
+	if (!bUsePathCache)
+		return nullptr;
 
-		return BuildNodesPathFromEndNode(Node);
-	}
+	UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	USpiderNavigationSubsystem* NavSubsystem = GameInstance ? GameInstance->GetSubsystem<USpiderNavigationSubsystem>() : nullptr;
+	return NavSubsystem ? NavSubsystem->GetPathCache(this) : nullptr;
+}
 
+void UNavGridComponent::ReportSearch(int32 Expansions, int32 OpenListPeak, const FSpiderNavPathResult& Path)
+{
+	LastSearchStats.Expansions = Expansions;
+	LastSearchStats.OpenListPeak = OpenListPeak;
+	LastSearchStats.bComplete = Path.bComplete;
 
-	return Path;
+	SpiderNavStats::ReportSearch(Expansions, OpenListPeak, Path.Locations, Path.bComplete);
 }
 
 void UNavGridComponent::RegisterSpiderNavGridActor_Implementation(AActor* SpiderNavGridActor)
@@ -426,7 +516,7 @@ void UNavGridComponent::DrawDebugRelations()
 	bool DrawShadow = false;
 
 	for (int32 i = 0; i != LoadedGrid.NavNodes.Num(); ++i) {
-		FSpiderNavNode Nav = LoadedGrid.NavNodes[i];
+		const FSpiderNavNode& Nav = LoadedGrid.NavNodes[i];
 
 
 		//DrawDebugString(GetWorld(), Nav.Location, *FString::Printf(TEXT("[%d]"), Nav.Neighbors.Num()), NULL, DrawColor, DrawDuration, DrawShadow);
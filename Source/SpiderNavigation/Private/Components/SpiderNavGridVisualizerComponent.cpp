@@ -0,0 +1,398 @@
+// Copyright Yves Tanas 2025
+
+#include "Components/SpiderNavGridVisualizerComponent.h"
+#include "SaveGame/SpiderNavGridSaveGame.h"
+#include "PrimitiveSceneProxy.h"
+#include "SceneManagement.h"
+#include "SceneView.h"
+#include "LocalVertexFactory.h"
+#include "StaticMeshResources.h"
+#include "RawIndexBuffer.h"
+#include "MaterialShared.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "Engine/Engine.h"
+
+/** Uploads the prebuilt line lists once and draws the visible chunks as ranges of them */
+class FSpiderNavGridSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FSpiderNavGridSceneProxy(const USpiderNavGridVisualizerComponent* Component, TSharedPtr<const FSpiderNavGridRenderData, ESPMode::ThreadSafe> InRenderData)
+		: FPrimitiveSceneProxy(Component)
+		, RenderData(MoveTemp(InRenderData))
+		, VertexFactory(GetScene().GetFeatureLevel(), "FSpiderNavGridSceneProxy")
+		, bDrawNormals(Component->bDrawNormals)
+		, MaxDrawDistanceSq(FMath::Square((double)Component->MaxDrawDistance))
+		, LodDistanceSq(FMath::Square((double)Component->LodDistance))
+	{
+		bWillEverBeLit = false;
+		// The engine wireframe material is not part of the component's materials
+		bVerifyUsedMaterials = false;
+
+		UMaterialInterface* LineMaterial = GEngine->WireframeMaterial;
+		MaterialRelevance = LineMaterial->GetRelevance_Concurrent(GetScene().GetFeatureLevel());
+		EdgeMaterial = MakeUnique<FColoredMaterialRenderProxy>(LineMaterial->GetRenderProxy(), Component->EdgeColor);
+		NormalMaterial = MakeUnique<FColoredMaterialRenderProxy>(LineMaterial->GetRenderProxy(), Component->NormalColor);
+		NodeMaterial = MakeUnique<FColoredMaterialRenderProxy>(LineMaterial->GetRenderProxy(), Component->NodeColor);
+	}
+
+	virtual ~FSpiderNavGridSceneProxy() override
+	{
+		VertexBuffers.PositionVertexBuffer.ReleaseResource();
+		VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+		VertexBuffers.ColorVertexBuffer.ReleaseResource();
+		IndexBuffer.ReleaseResource();
+		VertexFactory.ReleaseResource();
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	virtual void CreateRenderThreadResources(FRHICommandListBase& RHICmdList) override
+	{
+		// The only upload of the grid for this proxy; the CPU copies are dropped once the buffers exist
+		const TArray<FVector3f>& Positions = RenderData->Positions;
+		const int32 NumVertices = Positions.Num();
+
+		VertexBuffers.PositionVertexBuffer.Init(Positions, false);
+		VertexBuffers.StaticMeshVertexBuffer.Init(NumVertices, 1, false);
+		for (int32 i = 0; i < NumVertices; ++i)
+		{
+			VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(i, FVector3f::ForwardVector, FVector3f::RightVector, FVector3f::UpVector);
+			VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(i, 0, FVector2f::ZeroVector);
+		}
+		VertexBuffers.ColorVertexBuffer.InitFromSingleColor(FColor::White, NumVertices);
+
+		VertexBuffers.PositionVertexBuffer.InitResource(RHICmdList);
+		VertexBuffers.StaticMeshVertexBuffer.InitResource(RHICmdList);
+		VertexBuffers.ColorVertexBuffer.InitResource(RHICmdList);
+
+		FLocalVertexFactory::FDataType Data;
+		VertexBuffers.PositionVertexBuffer.BindPositionVertexBuffer(&VertexFactory, Data);
+		VertexBuffers.StaticMeshVertexBuffer.BindTangentVertexBuffer(&VertexFactory, Data);
+		VertexBuffers.StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(&VertexFactory, Data);
+		VertexBuffers.ColorVertexBuffer.BindColorVertexBuffer(&VertexFactory, Data);
+		VertexFactory.SetData(RHICmdList, Data);
+		VertexFactory.InitResource(RHICmdList);
+
+		IndexBuffer.SetIndices(RenderData->Indices, EIndexBufferStride::AutoDetect);
+		IndexBuffer.InitResource(RHICmdList);
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
+		if (!RenderData.IsValid())
+			return;
+
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+		{
+			if (!(VisibilityMap & (1 << ViewIndex)))
+				continue;
+
+			const FSceneView* View = Views[ViewIndex];
+			const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+
+			for (const FSpiderNavGridRenderChunk& Chunk : RenderData->Chunks)
+			{
+				// Distance and frustum culling per chunk; what is left are a few batches without vertex work
+				const double DistSq = Chunk.Bounds.ComputeSquaredDistanceToPoint(ViewOrigin);
+				if (DistSq > MaxDrawDistanceSq)
+					continue;
+				if (!View->ViewFrustum.IntersectBox(Chunk.Bounds.GetCenter(), Chunk.Bounds.GetExtent()))
+					continue;
+
+				const bool bLod = DistSq > LodDistanceSq;
+				AddLineBatch(Collector, ViewIndex, bLod ? Chunk.LodEdges : Chunk.Edges, EdgeMaterial.Get());
+				if (!bLod)
+				{
+					if (bDrawNormals)
+						AddLineBatch(Collector, ViewIndex, Chunk.Normals, NormalMaterial.Get());
+					AddLineBatch(Collector, ViewIndex, Chunk.Nodes, NodeMaterial.Get());
+				}
+			}
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bDynamicRelevance = true;
+		Result.bShadowRelevance = false;
+		Result.bEditorPrimitiveRelevance = UseEditorCompositing(View);
+		MaterialRelevance.SetPrimitiveViewRelevance(Result);
+		return Result;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+private:
+	void AddLineBatch(FMeshElementCollector& Collector, int32 ViewIndex, const FSpiderNavGridIndexRange& Range, const FMaterialRenderProxy* Material) const
+	{
+		if (Range.Num == 0)
+			return;
+
+		FMeshBatch& Mesh = Collector.AllocateMesh();
+		Mesh.VertexFactory = &VertexFactory;
+		Mesh.MaterialRenderProxy = Material;
+		Mesh.Type = PT_LineList;
+		Mesh.DepthPriorityGroup = SDPG_World;
+		Mesh.bCanApplyViewModeOverrides = false;
+		Mesh.CastShadow = false;
+
+		FMeshBatchElement& Element = Mesh.Elements[0];
+		Element.IndexBuffer = &IndexBuffer;
+		Element.FirstIndex = Range.First;
+		Element.NumPrimitives = Range.Num / 2;
+		Element.MinVertexIndex = 0;
+		Element.MaxVertexIndex = RenderData->Positions.Num() - 1;
+		Element.PrimitiveUniformBuffer = GetUniformBuffer();
+
+		Collector.AddMesh(ViewIndex, Mesh);
+	}
+
+	TSharedPtr<const FSpiderNavGridRenderData, ESPMode::ThreadSafe> RenderData;
+
+	FStaticMeshVertexBuffers VertexBuffers;
+	FRawStaticIndexBuffer IndexBuffer;
+	FLocalVertexFactory VertexFactory;
+
+	TUniquePtr<FColoredMaterialRenderProxy> EdgeMaterial;
+	TUniquePtr<FColoredMaterialRenderProxy> NormalMaterial;
+	TUniquePtr<FColoredMaterialRenderProxy> NodeMaterial;
+	FMaterialRelevance MaterialRelevance;
+
+	bool bDrawNormals;
+	double MaxDrawDistanceSq;
+	double LodDistanceSq;
+};
+
+USpiderNavGridVisualizerComponent::USpiderNavGridVisualizerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	CastShadow = false;
+	bHiddenInGame = true;
+	bUseEditorCompositing = true;
+
+	// Vertices are in world space: keep the component at the origin wherever it is attached
+	SetUsingAbsoluteLocation(true);
+	SetUsingAbsoluteRotation(true);
+	SetUsingAbsoluteScale(true);
+}
+
+void USpiderNavGridVisualizerComponent::SetGrid(const FSavedSpiderNavGrid& Grid)
+{
+	const int32 Num = Grid.NavNodes.Num();
+	TArray<FVector> Locations;
+	TArray<FVector> Normals;
+	TArray<FIntPoint> Edges;
+	Locations.Reserve(Num);
+	Normals.Reserve(Num);
+
+	const FSpiderNavNode* First = Grid.NavNodes.GetData();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const FSpiderNavNode& Node = Grid.NavNodes[i];
+		Locations.Add(Node.Location);
+		Normals.Add(Node.Normal);
+
+		for (const FSpiderNavNode* Neighbor : Node.Neighbors)
+		{
+			// Every edge once
+			const int32 j = Neighbor ? int32(Neighbor - First) : INDEX_NONE;
+			if (j > i && j < Num)
+				Edges.Emplace(i, j);
+		}
+	}
+
+	BuildRenderData(Locations, Normals, Edges);
+}
+
+void USpiderNavGridVisualizerComponent::SetGridFromSaveGame(const USpiderNavGridSaveGame* SaveGame)
+{
+	if (!SaveGame)
+	{
+		ClearGrid();
+		return;
+	}
+
+	TArray<FVector> Locations;
+	TArray<FVector> Normals;
+	TArray<FIntPoint> Edges;
+	TMap<int32, int32> LocalIndices;
+	Locations.Reserve(SaveGame->NavLocations.Num());
+	Normals.Reserve(SaveGame->NavLocations.Num());
+	LocalIndices.Reserve(SaveGame->NavLocations.Num());
+
+	for (const TPair<int32, FVector>& Pair : SaveGame->NavLocations)
+	{
+		LocalIndices.Add(Pair.Key, Locations.Num());
+		Locations.Add(Pair.Value);
+		const FVector* Normal = SaveGame->NavNormals.Find(Pair.Key);
+		Normals.Add(Normal ? *Normal : FVector::UpVector);
+	}
+
+	for (const TPair<int32, FSpiderNavRelations>& Pair : SaveGame->NavRelations)
+	{
+		const int32* i = LocalIndices.Find(Pair.Key);
+		if (!i)
+			continue;
+
+		for (int32 SavedNeighbor : Pair.Value.Neighbors)
+		{
+			const int32* j = LocalIndices.Find(SavedNeighbor);
+			if (j && *j > *i)
+				Edges.Emplace(*i, *j);
+		}
+	}
+
+	BuildRenderData(Locations, Normals, Edges);
+}
+
+void USpiderNavGridVisualizerComponent::ClearGrid()
+{
+	RenderData.Reset();
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void USpiderNavGridVisualizerComponent::BuildRenderData(const TArray<FVector>& Locations, const TArray<FVector>& Normals, const TArray<FIntPoint>& Edges)
+{
+	TSharedRef<FSpiderNavGridRenderData, ESPMode::ThreadSafe> Data = MakeShared<FSpiderNavGridRenderData, ESPMode::ThreadSafe>();
+
+	const double CellSize = FMath::Max(ChunkSize, 100.f);
+	auto ChunkOf = [CellSize](const FVector& P)
+		{
+			return FIntVector(
+				FMath::FloorToInt(P.X / CellSize),
+				FMath::FloorToInt(P.Y / CellSize),
+				FMath::FloorToInt(P.Z / CellSize));
+		};
+
+	// Line indices per chunk and kind, concatenated into one index buffer at the end
+	struct FChunkLines
+	{
+		TArray<uint32> Edges;
+		TArray<uint32> LodEdges;
+		TArray<uint32> Normals;
+		TArray<uint32> Nodes;
+	};
+	TArray<FChunkLines> ChunkLines;
+
+	TMap<FIntVector, int32> ChunkIndices;
+	TArray<int32> NodeChunk;
+	NodeChunk.SetNumUninitialized(Locations.Num());
+
+	// Node vertices first, so edges index them directly; then one normal tip per node, then the node crosses
+	const int32 NumNodes = Locations.Num();
+	static constexpr float NODE_CROSS_SIZE = 4.f;
+	Data->Positions.Reserve(NumNodes * (bDrawNodes ? 8 : 2));
+	for (const FVector& Location : Locations)
+		Data->Positions.Add(FVector3f(Location));
+
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		const FIntVector Key = ChunkOf(Locations[i]);
+		int32* Existing = ChunkIndices.Find(Key);
+		const int32 ChunkIndex = Existing ? *Existing : ChunkIndices.Add(Key, Data->Chunks.AddDefaulted());
+		if (ChunkLines.Num() <= ChunkIndex)
+			ChunkLines.SetNum(ChunkIndex + 1);
+
+		FSpiderNavGridRenderChunk& Chunk = Data->Chunks[ChunkIndex];
+		FChunkLines& Lines = ChunkLines[ChunkIndex];
+		const FVector Tip = Locations[i] + Normals[i] * NormalLength;
+		Chunk.Bounds += Locations[i];
+		Chunk.Bounds += Tip;
+		NodeChunk[i] = ChunkIndex;
+
+		Lines.Normals.Add(i);
+		Lines.Normals.Add(Data->Positions.Add(FVector3f(Tip)));
+	}
+
+	if (bDrawNodes)
+	{
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			FChunkLines& Lines = ChunkLines[NodeChunk[i]];
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				FVector3f Offset = FVector3f::ZeroVector;
+				Offset[Axis] = NODE_CROSS_SIZE;
+				Lines.Nodes.Add(Data->Positions.Add(Data->Positions[i] - Offset));
+				Lines.Nodes.Add(Data->Positions.Add(Data->Positions[i] + Offset));
+			}
+		}
+	}
+
+	// An edge belongs to the chunk of its first node; the bounds cover both ends
+	const int32 Stride = FMath::Max(1, LodEdgeStride);
+	for (const FIntPoint& Edge : Edges)
+	{
+		const int32 ChunkIndex = NodeChunk[Edge.X];
+		FChunkLines& Lines = ChunkLines[ChunkIndex];
+		Data->Chunks[ChunkIndex].Bounds += Locations[Edge.Y];
+
+		if ((Lines.Edges.Num() / 2) % Stride == 0)
+		{
+			Lines.LodEdges.Add(Edge.X);
+			Lines.LodEdges.Add(Edge.Y);
+		}
+		Lines.Edges.Add(Edge.X);
+		Lines.Edges.Add(Edge.Y);
+	}
+
+	auto AppendRange = [&Data](const TArray<uint32>& Source, FSpiderNavGridIndexRange& OutRange)
+		{
+			OutRange.First = Data->Indices.Num();
+			OutRange.Num = Source.Num();
+			Data->Indices.Append(Source);
+		};
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Data->Chunks.Num(); ++ChunkIndex)
+	{
+		FSpiderNavGridRenderChunk& Chunk = Data->Chunks[ChunkIndex];
+		const FChunkLines& Lines = ChunkLines[ChunkIndex];
+		AppendRange(Lines.Edges, Chunk.Edges);
+		AppendRange(Lines.LodEdges, Chunk.LodEdges);
+		AppendRange(Lines.Normals, Chunk.Normals);
+		AppendRange(Lines.Nodes, Chunk.Nodes);
+		Data->Bounds += Chunk.Bounds;
+	}
+
+	RenderData = Data;
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+FPrimitiveSceneProxy* USpiderNavGridVisualizerComponent::CreateSceneProxy()
+{
+	if (!RenderData.IsValid() || RenderData->Indices.Num() == 0)
+		return nullptr;
+
+	return new FSpiderNavGridSceneProxy(this, RenderData);
+}
+
+FBoxSphereBounds USpiderNavGridVisualizerComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// Grid points are already in world space
+	if (RenderData.IsValid() && RenderData->Bounds.IsValid)
+		return FBoxSphereBounds(RenderData->Bounds);
+
+	return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+}
+
+#if WITH_EDITOR
+void USpiderNavGridVisualizerComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	MarkRenderStateDirty();
+}
+#endif
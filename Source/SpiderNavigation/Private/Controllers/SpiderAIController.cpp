@@ -2,8 +2,12 @@
 
 #include "Controllers/SpiderAIController.h"
 #include "Interfaces/SpiderNavigationInterface.h"
+#include "Components/NavGridComponent.h"
+#include "Subsystems/SpiderNavigationSubsystem.h"
+#include "Subsystems/SpiderAILODSubsystem.h"
 
 #include "GameFramework/GameStateBase.h"
+#include "Engine/GameInstance.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
@@ -11,8 +15,8 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "TimerManager.h"
 #include "DrawDebugHelpers.h"
+#include "SpiderNavigationDiagnostics.h"
 
-#define SPIDER_LOG(Verbosity, Format, ...) UE_LOG(LogTemp, Verbosity, TEXT("[SpiderAI] %s(): ") Format, ANSI_TO_TCHAR(__FUNCTION__), ##__VA_ARGS__)
 
 ASpiderAIController::ASpiderAIController()
 {
@@ -44,6 +48,30 @@ void ASpiderAIController::BeginPlay()
 		UpdateLocalDestinationInterval,
 		true
 	);
+
+	if (bUseSignificanceLOD)
+	{
+		if (USpiderAILODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<USpiderAILODSubsystem>())
+		{
+			LODSubsystem->RegisterController(this);
+		}
+	}
+}
+
+void ASpiderAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNavGridComponent* NavGrid = Cast<UNavGridComponent>(NavigationComponent))
+	{
+		NavGrid->OnGridChanged.Remove(GridChangedHandle);
+	}
+	GridChangedHandle.Reset();
+
+	if (USpiderAILODSubsystem* LODSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USpiderAILODSubsystem>() : nullptr)
+	{
+		LODSubsystem->UnregisterController(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASpiderAIController::OnPossess(APawn* InPawn)
@@ -114,27 +142,21 @@ bool ASpiderAIController::MustCheckTargetVisibility_Implementation() const { ret
 
 void ASpiderAIController::MoveTo_Implementation(const FVector& Destination)
 {
-	// --- DEBUG START ---
-	SPIDER_LOG(Log, TEXT("MoveTo_Implementation called with Destination: %s"), *Destination.ToString());
+	SPIDERNAV_LOG(this, Verbose, TEXT("Destination: %s"), *Destination.ToString());
 
-	// Check Interface validity
-	if (!NavigationComponent)
+	if (!bKeepMoveQueryParams)
 	{
-		NavigationComponent = ResolveNavigationInterface();
-		SPIDER_LOG(Warning, TEXT("NavigationComponent was null. Attempted to resolve: %s"),
-			NavigationComponent ? TEXT("SUCCESS") : TEXT("FAILED"));
+		MoveQueryParams.Reset();
 	}
 
 	if (!NavigationComponent)
 	{
-		SPIDER_LOG(Error, TEXT("NavigationComponent is still NULL after Resolve. Aborting MoveTo."));
-		return;
+		NavigationComponent = ResolveNavigationInterface();
 	}
 
-	if (!NavigationComponent->GetClass()->ImplementsInterface(USpiderNavigationInterface::StaticClass()))
+	if (!NavigationComponent)
 	{
-		SPIDER_LOG(Error, TEXT("NavigationComponent (%s) does NOT implement ISpiderNavigationInterface!"),
-			*NavigationComponent->GetClass()->GetName());
+		SPIDERNAV_LOG(this, Error, TEXT("No navigation interface resolved. Aborting MoveTo."));
 		return;
 	}
 
@@ -142,59 +164,165 @@ void ASpiderAIController::MoveTo_Implementation(const FVector& Destination)
 	const FVector AdjustedDestination =
 		ISpiderNavigationInterface::Execute_FindClosestNodeLocation(NavigationComponent, Destination);
 
-	SPIDER_LOG(Log, TEXT("AdjustedDestination (ClosestNode): %s"), *AdjustedDestination.ToString());
-
-	if (AdjustedDestination.Equals(MoveDestination, 1.f))
+	if (!bRepathRequested && AdjustedDestination.Equals(MoveDestination, 1.f))
 	{
-		SPIDER_LOG(Log, TEXT("AdjustedDestination == MoveDestination -> No new path required."));
+		SPIDERNAV_LOG(this, VeryVerbose, TEXT("Destination node unchanged, keeping current path."));
 		return;
 	}
+	bRepathRequested = false;
+	bFollowingTarget = false;
 
 	MoveDestination = AdjustedDestination;
 
 	const FVector PawnPos = GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector;
 	const FVector StartNode = ISpiderNavigationInterface::Execute_FindClosestNodeLocation(NavigationComponent, PawnPos);
 
-	SPIDER_LOG(Log, TEXT("PawnPos: %s"), *PawnPos.ToString());
-	SPIDER_LOG(Log, TEXT("StartNode (Closest to Pawn): %s"), *StartNode.ToString());
-	SPIDER_LOG(Log, TEXT("Destination (ClosestNode): %s"), *MoveDestination.ToString());
+	// Pathfinding
+	FindMovePath(StartNode, MoveDestination, CurrentPath);
 
-	// Visual Debug
-#if WITH_EDITOR
-	DrawDebugSphere(GetWorld(), PawnPos, 15.f, 8, FColor::Yellow, false, 10.f);  // Pawn
-	DrawDebugSphere(GetWorld(), StartNode, 25.f, 8, FColor::Green, false, 10.f); // Start Node
-	DrawDebugSphere(GetWorld(), MoveDestination, 25.f, 8, FColor::Red, false, 10.f); // Destination
-#endif
+	SPIDERNAV_LOG(this, Verbose, TEXT("Pawn=%s Start=%s End=%s -> %d points"),
+		*PawnPos.ToString(), *StartNode.ToString(), *MoveDestination.ToString(), CurrentPath.Locations.Num());
+	SPIDERNAV_DRAW(this,
+		DrawDebugSphere(GetWorld(), PawnPos, 15.f, 8, FColor::Yellow, false, 10.f);
+		DrawDebugSphere(GetWorld(), StartNode, 25.f, 8, FColor::Green, false, 10.f);
+		DrawDebugSphere(GetWorld(), MoveDestination, 25.f, 8, FColor::Red, false, 10.f));
 
-	// Pathfinding
-	CurrentPathPoints = ISpiderNavigationInterface::Execute_FindPathBetweenPoints(
-		NavigationComponent, StartNode, MoveDestination);
+	StartPathMove(StartNode);
+}
 
-	SPIDER_LOG(Log, TEXT("FindPathBetweenPoints called: Start=%s  End=%s  -> Returned %d points"),
-		*StartNode.ToString(), *MoveDestination.ToString(), CurrentPathPoints.Num());
+void ASpiderAIController::MoveToWithParams(const FVector& Destination, const FSpiderNavQueryParams& Params)
+{
+	TGuardValue<bool> KeepParams(bKeepMoveQueryParams, true);
+	MoveQueryParams = Params;
+	ISpiderAIControllerInterface::Execute_MoveTo(this, Destination);
+}
 
-	if (CurrentPathPoints.Num() > 0)
+void ASpiderAIController::FindMovePath(const FVector& Start, const FVector& End, FSpiderNavPathResult& OutPath)
+{
+	UNavGridComponent* NavGrid = Cast<UNavGridComponent>(NavigationComponent);
+	if (NavGrid)
 	{
-		for (int32 i = 0; i < CurrentPathPoints.Num(); ++i)
-		{
-			SPIDER_LOG(Log, TEXT("  PathPoint[%d]: %s"), i, *CurrentPathPoints[i].ToString());
-		}
+		FSpiderNavQueryParams Params = MoveQueryParams.IsSet() ? MoveQueryParams.GetValue()
+			: bOverrideQueryParams ? QueryParams : NavGrid->GetDefaultQueryParams();
+		Params.bSmoothPath |= bSmoothPath;
+
+		NavGrid->FindPathInto(Start, End, Params, OutPath);
+		return;
 	}
-	else
+
+	// other implementations of the interface know no search options and only return locations
+	OutPath.Reset();
+	OutPath.Locations = ISpiderNavigationInterface::Execute_FindPathBetweenPoints(NavigationComponent, Start, End);
+}
+
+void ASpiderAIController::FollowTo(const FVector& TargetLocation)
+{
+	if (!NavigationComponent)
 	{
-		SPIDER_LOG(Warning, TEXT("Empty path returned from navigation."));
-		SPIDER_LOG(Warning, TEXT("Possible causes:"));
-		SPIDER_LOG(Warning, TEXT("  - Start or End node not inside Navigation Volume"));
-		SPIDER_LOG(Warning, TEXT("  - NavigationComponent world not matching Pawn world"));
-		SPIDER_LOG(Warning, TEXT("  - NavGraph not yet built / async generation incomplete"));
-		SPIDER_LOG(Warning, TEXT("  - FindClosestNodeLocation returned fallback (0,0,0)"));
+		NavigationComponent = ResolveNavigationInterface();
+	}
 
-		// Optionally: draw debug markers to visualize
-		if (GetWorld())
-		{
+	UNavGridComponent* NavGrid = Cast<UNavGridComponent>(NavigationComponent);
+	if (FollowMode != ESpiderFollowMode::Incremental || !NavGrid)
+	{
+		ISpiderAIControllerInterface::Execute_MoveTo(this, TargetLocation);
+		return;
+	}
+
+	bFollowingTarget = true;
+	bRepathRequested = false;
+	FollowTargetActor.Reset();
+	FollowTargetLocation = TargetLocation;
+
+	// The tree is kept between calls, only the goal moves
+	const FVector PawnPos = GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector;
+	NavGrid->FindPathIncremental(FollowPlanner, PawnPos, TargetLocation, CurrentPath);
+
+	const FVector StartNode = CurrentPath.Locations.Num() > 0 ? CurrentPath.Locations[0] : PawnPos;
+	MoveDestination = CurrentPath.Locations.Num() > 0 ? CurrentPath.Locations.Last() : TargetLocation;
+
+	SPIDERNAV_LOG(this, VeryVerbose, TEXT("Follow %s -> %d points, %d expansions%s"),
+		*TargetLocation.ToString(), CurrentPath.Locations.Num(), FollowPlanner.GetLastExpansions(),
+		CurrentPath.bComplete ? TEXT("") : TEXT(" (partial)"));
+
+	StartPathMove(StartNode);
+}
+
+void ASpiderAIController::FollowActor(AActor* Target)
+{
+	if (!Target)
+		return;
+
+	if (FollowMode != ESpiderFollowMode::FlowField)
+	{
+		FollowTo(Target->GetActorLocation());
+		return;
+	}
+
+	if (!NavigationComponent)
+	{
+		NavigationComponent = ResolveNavigationInterface();
+	}
+
+	UNavGridComponent* NavGrid = Cast<UNavGridComponent>(NavigationComponent);
+	UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	USpiderNavigationSubsystem* NavSubsystem = GameInstance ? GameInstance->GetSubsystem<USpiderNavigationSubsystem>() : nullptr;
+	const FVector PawnPos = GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector;
+
+	// into the second buffer: if the field fails, the current path is kept for MoveTo
+	if (!NavGrid || !NavSubsystem || !NavSubsystem->FindFlowFieldPath(NavGrid, Target, PawnPos, PendingPath))
+	{
+		// Field still building, start not connected or a new obstacle on the field -> own search
+		SPIDERNAV_LOG(this, VeryVerbose, TEXT("No flow field path to %s, falling back to MoveTo."), *GetNameSafe(Target));
+		ISpiderAIControllerInterface::Execute_MoveTo(this, Target->GetActorLocation());
+		return;
+	}
+
+	bFollowingTarget = true;
+	bRepathRequested = false;
+	FollowTargetActor = Target;
+	FollowTargetLocation = Target->GetActorLocation();
+
+	Swap(CurrentPath, PendingPath);
+	// A path cut at MaxPoints ends short of the target: keep heading for the target and extend it at the end
+	MoveDestination = CurrentPath.bComplete ? CurrentPath.Locations.Last() : FollowTargetLocation;
+	StartPathMove(CurrentPath.Locations[0]);
+}
+
+bool ASpiderAIController::ExtendFlowFieldPath()
+{
+	AActor* Target = FollowTargetActor.Get();
+	if (!bFollowingTarget || !Target || CurrentPath.bComplete || CurrentPath.Locations.Num() == 0)
+		return false;
+
+	UNavGridComponent* NavGrid = Cast<UNavGridComponent>(NavigationComponent);
+	UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	USpiderNavigationSubsystem* NavSubsystem = GameInstance ? GameInstance->GetSubsystem<USpiderNavigationSubsystem>() : nullptr;
+	if (!NavGrid || !NavSubsystem || !NavSubsystem->FindFlowFieldPath(NavGrid, Target, CurrentPath.Locations.Last(), PendingPath)
+		|| PendingPath.Locations.Num() < 2)
+	{
+		SPIDERNAV_LOG(this, VeryVerbose, TEXT("Could not extend the flow field path to %s."), *GetNameSafe(Target));
+		return false;
+	}
+
+	Swap(CurrentPath, PendingPath);
+	// The first point is the end of the previous stretch, where the spider already is
+	CurrentPathIndex = 1;
+	FollowTargetLocation = Target->GetActorLocation();
+	MoveDestination = CurrentPath.bComplete ? CurrentPath.Locations.Last() : FollowTargetLocation;
+	return true;
+}
+
+void ASpiderAIController::StartPathMove(const FVector& StartNode)
+{
+	CurrentPathIndex = 0;
+	if (CurrentPath.Locations.Num() == 0)
+	{
+		// Start/goal outside the grid, grid not loaded or the (0,0,0) fallback of FindClosestNodeLocation
+		SPIDERNAV_LOG(this, Warning, TEXT("Empty path from %s to %s."), *StartNode.ToString(), *MoveDestination.ToString());
+		SPIDERNAV_DRAW(this,
 			DrawDebugSphere(GetWorld(), StartNode, 40.f, 12, FColor::Red, false, 5.f);
-			DrawDebugSphere(GetWorld(), MoveDestination, 40.f, 12, FColor::Blue, false, 5.f);
-		}
+			DrawDebugSphere(GetWorld(), MoveDestination, 40.f, 12, FColor::Blue, false, 5.f));
 
 		bMustMove = false;
 		bLocalPathFound = false;
@@ -202,12 +330,11 @@ void ASpiderAIController::MoveTo_Implementation(const FVector& Destination)
 		HandleMoveCompleted.Broadcast(false);
 		return;
 	}
-	// --- DEBUG END ---
 
-	// remove start if it's same as current position
-	if (FVector::DistSquared(CurrentPathPoints[0], StartNode) < FMath::Square(NodeAcceptanceRadius))
+	// skip start if it's same as current position
+	if (FVector::DistSquared(CurrentPath.Locations[0], StartNode) < FMath::Square(NodeAcceptanceRadius))
 	{
-		CurrentPathPoints.RemoveAt(0);
+		++CurrentPathIndex;
 	}
 
 	UpdateLocalMoveDestination();
@@ -219,7 +346,7 @@ void ASpiderAIController::MoveTo_Implementation(const FVector& Destination)
 	}
 
 	bMustMove = true;
-	SPIDER_LOG(Log, TEXT("MoveTo started. PathLength=%d"), CurrentPathPoints.Num());
+	SPIDERNAV_LOG(this, Verbose, TEXT("MoveTo started. PathLength=%d"), CurrentPath.Locations.Num() - CurrentPathIndex);
 }
 
 void ASpiderAIController::Tick_CheckFinish()
@@ -235,7 +362,7 @@ void ASpiderAIController::Tick_CheckFinish()
 		bMustMoveLocal = false;
 		bMustRotate = false;
 		HandleMoveCompleted.Broadcast(true);
-		SPIDER_LOG(Log, TEXT("Movement completed successfully."));
+		SPIDERNAV_LOG(this, Verbose, TEXT("Movement completed."));
 	}
 }
 
@@ -270,19 +397,113 @@ void ASpiderAIController::Tick_Move(float DeltaSeconds)
 	}
 
 	NormalToDestinationBeforeMove = Dir;
-	GetPawn()->AddActorWorldOffset(Dir * MoveSpeed * DeltaSeconds, true);
+	// not past the node, otherwise the spider oscillates around it with large DeltaSeconds (Reduced LOD)
+	const float Step = FMath::Min(MoveSpeed * DeltaSeconds, FVector::Dist(GetPawn()->GetActorLocation(), LocalMoveDestination));
+	GetPawn()->AddActorWorldOffset(Dir * Step, true);
 
 	const float DistSq = FVector::DistSquared(GetPawn()->GetActorLocation(), LocalMoveDestination);
 	if (DistSq <= FMath::Square(NodeAcceptanceRadius))
 	{
-		if (CurrentPathPoints.Num() > 0)
+		if (CurrentPathIndex < CurrentPath.Locations.Num())
 		{
-			CurrentPathPoints.RemoveAt(0);
+			++CurrentPathIndex;
 		}
 		UpdateLocalMoveDestination();
 	}
 }
 
+void ASpiderAIController::TickCoarse(float DeltaSeconds)
+{
+	APawn* MyPawn = GetPawn();
+	if (!bMustMove || !MyPawn)
+		return;
+
+	// Walk the remaining distance along the path points: no sweep, rotation only at the nodes
+	FVector Location = MyPawn->GetActorLocation();
+	float Remaining = MoveSpeed * DeltaSeconds;
+	while (Remaining > 0.f && CurrentPathIndex < CurrentPath.Locations.Num())
+	{
+		const FVector& Point = CurrentPath.Locations[CurrentPathIndex];
+		const float Dist = FVector::Dist(Location, Point);
+		if (Dist > Remaining)
+		{
+			Location += (Point - Location) * (Remaining / Dist);
+			break;
+		}
+		Location = Point;
+		Remaining -= Dist;
+		++CurrentPathIndex;
+	}
+	MyPawn->SetActorLocation(Location);
+
+	Tick_CheckFinish();
+	FindPathTick();
+
+	if (bMustRotate)
+	{
+		MyPawn->SetActorRotation(RotationDestination);
+		bMustRotate = false;
+	}
+}
+
+void ASpiderAIController::SetLOD(ESpiderLOD NewLOD)
+{
+	USpiderAILODSubsystem* LODSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USpiderAILODSubsystem>() : nullptr;
+	if (NewLOD == ESpiderLOD::Coarse && !LODSubsystem)
+	{
+		// without the subsystem nobody would move the spider
+		NewLOD = ESpiderLOD::Reduced;
+	}
+
+	if (NewLOD == CurrentLOD)
+		return;
+
+	const bool bWasCoarse = CurrentLOD == ESpiderLOD::Coarse;
+	CurrentLOD = NewLOD;
+	SPIDERNAV_LOG(this, Verbose, TEXT("LOD %s"), *UEnum::GetValueAsString(NewLOD));
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (NewLOD == ESpiderLOD::Coarse)
+	{
+		// No tick and no timer, the subsystem moves coarse spiders in batches
+		SetActorTickEnabled(false);
+		TimerManager.PauseTimer(TimerHandle_FindPathTick);
+		LODSubsystem->SetCoarse(this, true);
+		return;
+	}
+
+	SetActorTickInterval(NewLOD == ESpiderLOD::Full ? 0.f : LODReducedTickInterval);
+	if (bWasCoarse)
+	{
+		if (LODSubsystem)
+		{
+			LODSubsystem->SetCoarse(this, false);
+		}
+		TimerManager.UnPauseTimer(TimerHandle_FindPathTick);
+		SetActorTickEnabled(true);
+
+		// Pick the next waypoint again from the coarse position
+		FindPathTick();
+	}
+}
+
+float ASpiderAIController::CalculateSignificance(const FTransform& Viewpoint) const
+{
+	const APawn* MyPawn = GetPawn();
+	if (!MyPawn)
+		return static_cast<float>(ESpiderLOD::Coarse);
+
+	const FVector ToPawn = MyPawn->GetActorLocation() - Viewpoint.GetLocation();
+	const float DistSq = ToPawn.SizeSquared();
+	if (DistSq <= FMath::Square(LODFullDistance))
+		return static_cast<float>(ESpiderLOD::Full);
+
+	// View cone instead of a visibility trace, which per spider and viewpoint would cost more than the saved tick
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(LODViewHalfAngle));
+	const bool bInView = FVector::DotProduct(ToPawn.GetSafeNormal(), Viewpoint.GetRotation().GetForwardVector()) >= CosHalfAngle;
+	return static_cast<float>(bInView && DistSq <= FMath::Square(LODReducedDistance) ? ESpiderLOD::Reduced : ESpiderLOD::Coarse);
+}
+
 void ASpiderAIController::FindPathTick()
 {
 	if (!bMustMove)
@@ -299,23 +520,21 @@ void ASpiderAIController::FindPathTick()
 
 void ASpiderAIController::UpdateLocalMoveDestination()
 {
-	if (CurrentPathPoints.Num() == 0)
+	if (CurrentPathIndex >= CurrentPath.Locations.Num() && !ExtendFlowFieldPath())
 	{
 		bLocalPathFound = false;
 		bMustMoveLocal = false;
 		return;
 	}
 
-	LocalMoveDestination = CurrentPathPoints[0];
+	LocalMoveDestination = CurrentPath.Locations[CurrentPathIndex];
+	MoveNormal = CurrentPath.Normals.IsValidIndex(CurrentPathIndex) ? CurrentPath.Normals[CurrentPathIndex] : FVector::UpVector;
 	bLocalPathFound = true;
 	bMustMoveLocal = true;
 
 	UpdateRotationParams();
 
-	if (bDebug)
-	{
-		DrawDebugPath();
-	}
+	SPIDERNAV_DRAW(this, DrawDebugPath());
 }
 
 void ASpiderAIController::UpdateRotationParams()
@@ -326,7 +545,10 @@ void ASpiderAIController::UpdateRotationParams()
 	RotationBeforeMove = GetPawn()->GetActorRotation();
 
 	const FVector ToTarget = (LocalMoveDestination - GetPawn()->GetActorLocation()).GetSafeNormal();
-	RotationDestination = ToTarget.Rotation();
+	// Align the up vector to the surface of the target node (walls, ceilings); nearly parallel -> facing only
+	RotationDestination = FMath::Abs(FVector::DotProduct(ToTarget, MoveNormal)) < 0.99f
+		? FRotationMatrix::MakeFromXZ(ToTarget, MoveNormal).Rotator()
+		: ToTarget.Rotation();
 
 	bMustRotate = !RotationBeforeMove.Equals(RotationDestination, 0.5f);
 }
@@ -349,28 +571,69 @@ UObject* ASpiderAIController::ResolveNavigationInterface()
 		TArray<UActorComponent*> Components =
 			GameState->GetComponentsByInterface(USpiderNavigationInterface::StaticClass());
 		if (Components.Num() > 0)
+		{
+			// Search paths again only if obstacles actually cross them
+			if (UNavGridComponent* NavGrid = Cast<UNavGridComponent>(Components[0]))
+			{
+				if (!GridChangedHandle.IsValid())
+					GridChangedHandle = NavGrid->OnGridChanged.AddUObject(this, &ASpiderAIController::OnNavGridChanged);
+			}
 			return Components[0];
+		}
 	}
 
-	SPIDER_LOG(Warning, TEXT("No valid ISpiderNavigationInterface found in GameState."));
+	UE_LOG(LogSpiderNavigation, Warning, TEXT("%s: No ISpiderNavigationInterface found in GameState."), *GetName());
 	return nullptr;
 }
 
+void ASpiderAIController::OnNavGridChanged(uint32 GridVersion, const FBox& ChangedBounds)
+{
+	if (!bMustMove || !DoesPathIntersect(ChangedBounds.ExpandBy(NodeAcceptanceRadius)))
+		return;
+
+	SPIDERNAV_LOG(this, Verbose, TEXT("Grid version %u blocks the current path, repathing."), GridVersion);
+	bRepathRequested = true;
+	TGuardValue<bool> KeepParams(bKeepMoveQueryParams, true);
+	if (bFollowingTarget)
+	{
+		// The planner or flow field picks up the change
+		if (AActor* FollowTarget = FollowTargetActor.Get())
+			FollowActor(FollowTarget);
+		else
+			FollowTo(FollowTargetLocation);
+		return;
+	}
+	ISpiderAIControllerInterface::Execute_MoveTo(this, MoveDestination);
+}
+
+bool ASpiderAIController::DoesPathIntersect(const FBox& Bounds) const
+{
+	FVector Previous = GetPawn() ? GetPawn()->GetActorLocation() : LocalMoveDestination;
+	for (int32 i = CurrentPathIndex; i < CurrentPath.Locations.Num(); ++i)
+	{
+		const FVector& Point = CurrentPath.Locations[i];
+		if (Bounds.IsInside(Point) || FMath::LineBoxIntersection(Bounds, Previous, Point, Point - Previous))
+			return true;
+		Previous = Point;
+	}
+	return false;
+}
+
 void ASpiderAIController::DrawDebugPath() const
 {
-	if (!bDebug || CurrentPathPoints.Num() == 0 || !GetWorld())
+	if (CurrentPathIndex >= CurrentPath.Locations.Num() || !GetWorld())
 		return;
 
 	const FVector PawnLoc = GetPawn() ? GetPawn()->GetActorLocation() : FVector::ZeroVector;
 
-	for (int32 i = 0; i < CurrentPathPoints.Num(); ++i)
+	for (int32 i = CurrentPathIndex; i < CurrentPath.Locations.Num(); ++i)
 	{
-		const FVector& P = CurrentPathPoints[i];
+		const FVector& P = CurrentPath.Locations[i];
 		DrawDebugSphere(GetWorld(), P, 6.f, 8, FColor::Green, false, UpdateLocalDestinationInterval);
 
-		if (i > 0)
+		if (i > CurrentPathIndex)
 		{
-			DrawDebugLine(GetWorld(), CurrentPathPoints[i - 1], P, FColor::Green, false, UpdateLocalDestinationInterval);
+			DrawDebugLine(GetWorld(), CurrentPath.Locations[i - 1], P, FColor::Green, false, UpdateLocalDestinationInterval);
 		}
 	}
 
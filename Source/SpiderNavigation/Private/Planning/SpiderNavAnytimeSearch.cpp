@@ -0,0 +1,216 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavAnytimeSearch.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "SpiderNavigationStats.h"
+#include "Algo/Reverse.h"
+
+namespace SpiderNavAnytimePrivate
+{
+	static constexpr float INF = TNumericLimits<float>::Max();
+
+	// Epsilon decrease per pass
+	static constexpr float EPSILON_STEP = 0.5f;
+
+	// Read the clock only every n expansions
+	static constexpr int32 DEADLINE_CHECK_INTERVAL = 256;
+}
+
+bool FSpiderNavAnytimeSearch::Search(const FSavedSpiderNavGrid& InGrid, const FSpiderNavObstacleLayer& InObstacles, int32 Start, int32 InGoal,
+	float Epsilon, double DeadlineSeconds, TArray<int32>& OutPath, bool& bOutComplete)
+{
+	using namespace SpiderNavAnytimePrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_AnytimeSearch);
+
+	OutPath.Reset();
+	bOutComplete = false;
+	LastEpsilon = FMath::Max(1.f, Epsilon);
+	LastPasses = 0;
+	LastExpansions = 0;
+	LastOpenListPeak = 0;
+
+	const int32 NumNodes = InGrid.NavNodes.Num();
+	if (!InGrid.NavNodes.IsValidIndex(Start) || !InGrid.NavNodes.IsValidIndex(InGoal) || InGrid.EdgeOffsets.Num() != NumNodes + 1)
+		return false;
+
+	if (Start == InGoal)
+	{
+		OutPath.Add(Start);
+		bOutComplete = true;
+		return true;
+	}
+
+	Grid = &InGrid;
+	Obstacles = &InObstacles;
+	Goal = InGoal;
+	GoalLocation = InGrid.NavNodes[Goal].Location;
+
+	if (G.Num() != NumNodes)
+	{
+		G.SetNumUninitialized(NumNodes);
+		Parent.SetNumUninitialized(NumNodes);
+		Visited.Init(0, NumNodes);
+		Closed.Init(0, NumNodes);
+		InconsistentMark.Init(0, NumNodes);
+		Stamp = 0;
+		PassStamp = 0;
+	}
+
+	auto NextPass = [this]()
+		{
+			if (++PassStamp == 0)
+			{
+				Closed.Init(0, Closed.Num());
+				InconsistentMark.Init(0, InconsistentMark.Num());
+				PassStamp = 1;
+			}
+		};
+
+	if (++Stamp == 0)
+	{
+		Visited.Init(0, NumNodes);
+		Stamp = 1;
+	}
+	NextPass();
+	Queue.Reset();
+	Inconsistent.Reset();
+
+	G[Start] = 0.f;
+	Parent[Start] = INDEX_NONE;
+	Visited[Start] = Stamp;
+	BestPartial = Start;
+	BestPartialDistance = (InGrid.NavNodes[Start].Location - GoalLocation).SizeSquared();
+
+	CurrentEpsilon = FMath::Max(1.f, Epsilon);
+	Queue.HeapPush({ CurrentEpsilon * Heuristic(Start), 0.f, Start });
+
+	// The first pass always runs to the end, otherwise there would be no path
+	const double EndTime = FPlatformTime::Seconds() + FMath::Max(0.0, DeadlineSeconds);
+	ImprovePath(EndTime, false);
+	LastPasses = 1;
+	LastEpsilon = CurrentEpsilon;
+
+	const bool bReached = Visited[Goal] == Stamp;
+	while (bReached && CurrentEpsilon > 1.f && FPlatformTime::Seconds() < EndTime)
+	{
+		CurrentEpsilon = FMath::Max(1.f, CurrentEpsilon - EPSILON_STEP);
+
+		// Re-key OPEN + INCONS with the new epsilon, duplicates drop out when pruning
+		TArray<FQueueEntry> Previous = MoveTemp(Queue);
+		Queue.Reset();
+		for (const FQueueEntry& Entry : Previous)
+		{
+			if (Entry.G == G[Entry.Node])
+				Queue.Add({ Entry.G + CurrentEpsilon * Heuristic(Entry.Node), Entry.G, Entry.Node });
+		}
+		for (const int32 Node : Inconsistent)
+			Queue.Add({ G[Node] + CurrentEpsilon * Heuristic(Node), G[Node], Node });
+		Inconsistent.Reset();
+		Queue.Heapify();
+		NextPass();
+
+		if (!ImprovePath(EndTime, true))
+			break;
+
+		++LastPasses;
+		LastEpsilon = CurrentEpsilon;
+	}
+
+	// Parents always point along a valid path, even after an aborted pass
+	for (int32 Node = bReached ? Goal : BestPartial; Node != INDEX_NONE; Node = Parent[Node])
+		OutPath.Add(Node);
+	Algo::Reverse(OutPath);
+	bOutComplete = bReached;
+
+	Grid = nullptr;
+	Obstacles = nullptr;
+	return OutPath.Num() > 0;
+}
+
+bool FSpiderNavAnytimeSearch::ImprovePath(double EndTime, bool bCanAbort)
+{
+	using namespace SpiderNavAnytimePrivate;
+
+	int32 SinceDeadlineCheck = 0;
+	while (true)
+	{
+		PruneQueue();
+		if (Queue.Num() == 0)
+			return true;
+
+		const float GoalG = Visited[Goal] == Stamp ? G[Goal] : INF;
+		if (Queue.HeapTop().Key >= GoalG)
+			return true;
+
+		if (bCanAbort && ++SinceDeadlineCheck >= DEADLINE_CHECK_INTERVAL)
+		{
+			SinceDeadlineCheck = 0;
+			if (FPlatformTime::Seconds() > EndTime)
+				return false;
+		}
+
+		FQueueEntry Top;
+		Queue.HeapPop(Top);
+		const int32 Node = Top.Node;
+		Closed[Node] = PassStamp;
+		++LastExpansions;
+
+		const float Distance = (Grid->NavNodes[Node].Location - GoalLocation).SizeSquared();
+		if (Distance < BestPartialDistance)
+		{
+			BestPartialDistance = Distance;
+			BestPartial = Node;
+		}
+
+		for (int32 Edge = Grid->EdgeOffsets[Node]; Edge < Grid->EdgeOffsets[Node + 1]; ++Edge)
+		{
+			if (Obstacles->IsEdgeBlocked(Edge))
+				continue;
+
+			const int32 Next = Grid->EdgeTargets[Edge];
+			const float NewG = Top.G + Grid->EdgeCosts[Edge];
+			if (Visited[Next] == Stamp && NewG >= G[Next])
+				continue;
+
+			G[Next] = NewG;
+			Parent[Next] = Node;
+			Visited[Next] = Stamp;
+
+			if (Closed[Next] != PassStamp)
+			{
+				Queue.HeapPush({ NewG + CurrentEpsilon * Heuristic(Next), NewG, Next });
+			}
+			else if (InconsistentMark[Next] != PassStamp)
+			{
+				// Already expanded in this pass -> reopen only in the next one
+				InconsistentMark[Next] = PassStamp;
+				Inconsistent.Add(Next);
+			}
+		}
+
+		LastOpenListPeak = FMath::Max(LastOpenListPeak, Queue.Num());
+	}
+}
+
+float FSpiderNavAnytimeSearch::Heuristic(int32 Node) const
+{
+	return (Grid->NavNodes[Node].Location - GoalLocation).Size() * Grid->HeuristicScale;
+}
+
+void FSpiderNavAnytimeSearch::PruneQueue()
+{
+	while (Queue.Num() > 0)
+	{
+		const FQueueEntry& Top = Queue.HeapTop();
+		if (Closed[Top.Node] != PassStamp && Top.G == G[Top.Node])
+			return;
+		Queue.HeapPopDiscard();
+	}
+}
+
+SIZE_T FSpiderNavAnytimeSearch::GetAllocatedSize() const
+{
+	return G.GetAllocatedSize() + Parent.GetAllocatedSize() + Visited.GetAllocatedSize() + Closed.GetAllocatedSize()
+		+ InconsistentMark.GetAllocatedSize() + Inconsistent.GetAllocatedSize() + Queue.GetAllocatedSize();
+}
@@ -0,0 +1,261 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavBatchSearch.h"
+#include "Planning/SpiderNavBidirectionalSearch.h"
+#include "Planning/SpiderNavAnytimeSearch.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "Structs/SpiderNavPathResult.h"
+#include "Structs/SpiderNavQueryParams.h"
+#include "SpiderNavigationStats.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+
+namespace SpiderNavBatchSearchPrivate
+{
+	// From this many queries to the same goal on, one Dijkstra from the goal beats separate A* searches
+	static constexpr int32 MIN_GROUP_SIZE = 4;
+
+	struct FQueueEntry
+	{
+		float Cost = 0.f;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FQueueEntry& Other) const { return Cost < Other.Cost; }
+	};
+}
+
+struct FSpiderNavBatchSearch::FScratch
+{
+	FSpiderNavBidirectionalSearch Bidirectional;
+	FSpiderNavAnytimeSearch Anytime;
+
+	/** Reverse Dijkstra of a goal group: Costs and NextEdges valid if Visited == Stamp */
+	TArray<float> Costs;
+	TArray<int32> NextEdges;
+	TArray<uint32> Visited;
+	/** Start node of the group not settled yet if StartMark == Stamp */
+	TArray<uint32> StartMark;
+	TArray<SpiderNavBatchSearchPrivate::FQueueEntry> Queue;
+	uint32 Stamp = 0;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Bidirectional.GetAllocatedSize() + Anytime.GetAllocatedSize() + Costs.GetAllocatedSize()
+			+ NextEdges.GetAllocatedSize() + Visited.GetAllocatedSize() + StartMark.GetAllocatedSize() + Queue.GetAllocatedSize();
+	}
+
+	/** Search of the query's mode, as in UNavGridComponent::FindNodesPath. Returns the expansions */
+	int32 SearchSingle(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FSpiderNavQueryParams& Params,
+		int32 Start, int32 Goal, FSpiderNavPathResult& OutResult, int32& OutOpenListPeak)
+	{
+		bool bComplete = false;
+		int32 Expansions = 0;
+		if (Params.Mode == ESpiderNavSearchMode::Bidirectional)
+		{
+			Bidirectional.Search(Grid, Obstacles, Start, Goal, OutResult.NodeIndices, bComplete);
+			Expansions = Bidirectional.GetLastExpansions();
+			OutOpenListPeak = Bidirectional.GetLastOpenListPeak();
+		}
+		else
+		{
+			// A* and Weighted are the first ARA* pass with epsilon 1 or Epsilon, without improvement
+			const float Epsilon = Params.Mode == ESpiderNavSearchMode::AStar ? 1.f : Params.Epsilon;
+			const double Deadline = Params.Mode == ESpiderNavSearchMode::Anytime ? Params.DeadlineMs / 1000.0 : 0.0;
+			Anytime.Search(Grid, Obstacles, Start, Goal, Epsilon, Deadline, OutResult.NodeIndices, bComplete);
+			Expansions = Anytime.GetLastExpansions();
+			OutOpenListPeak = Anytime.GetLastOpenListPeak();
+		}
+		OutResult.bComplete = bComplete;
+		OutResult.FillFromIndices(Grid);
+		return Expansions;
+	}
+
+	/** One reverse Dijkstra from Goal until all starts of Queries are settled, then follows it per query */
+	void SearchGroup(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FSpiderNavQueryParams& Params,
+		TConstArrayView<int32> Queries, TConstArrayView<int32> Starts, int32 Goal,
+		TArray<FSpiderNavPathResult>& OutResults, TArray<int32>& OutExpansions, TArray<int32>& OutOpenListPeaks)
+	{
+		using namespace SpiderNavBatchSearchPrivate;
+
+		const int32 NumNodes = Grid.NavNodes.Num();
+		if (Visited.Num() != NumNodes)
+		{
+			Costs.SetNumUninitialized(NumNodes);
+			NextEdges.SetNumUninitialized(NumNodes);
+			Visited.Init(0, NumNodes);
+			StartMark.Init(0, NumNodes);
+			Stamp = 0;
+		}
+		if (++Stamp == 0)
+		{
+			Visited.Init(0, NumNodes);
+			StartMark.Init(0, NumNodes);
+			Stamp = 1;
+		}
+
+		int32 Remaining = 0;
+		for (const int32 Query : Queries)
+		{
+			if (StartMark[Starts[Query]] != Stamp)
+			{
+				StartMark[Starts[Query]] = Stamp;
+				++Remaining;
+			}
+		}
+
+		Queue.Reset();
+		Costs[Goal] = 0.f;
+		NextEdges[Goal] = INDEX_NONE;
+		Visited[Goal] = Stamp;
+		Queue.HeapPush({ 0.f, Goal });
+
+		int32 Expansions = 0;
+		int32 OpenListPeak = 1;
+		while (Queue.Num() > 0 && Remaining > 0)
+		{
+			FQueueEntry Top;
+			Queue.HeapPop(Top);
+			if (Top.Cost > Costs[Top.Node])
+				continue;
+
+			if (StartMark[Top.Node] == Stamp)
+			{
+				StartMark[Top.Node] = 0;
+				if (--Remaining == 0)
+					break;
+			}
+			++Expansions;
+
+			// Backwards over incoming edges, like the flow field
+			for (int32 i = Grid.ReverseEdgeOffsets[Top.Node]; i < Grid.ReverseEdgeOffsets[Top.Node + 1]; ++i)
+			{
+				const int32 Edge = Grid.ReverseEdges[i];
+				if (Obstacles.IsEdgeBlocked(Edge))
+					continue;
+
+				const int32 Source = Grid.EdgeSources[Edge];
+				const float NewCost = Top.Cost + Grid.EdgeCosts[Edge];
+				if (Visited[Source] != Stamp || NewCost < Costs[Source])
+				{
+					Visited[Source] = Stamp;
+					Costs[Source] = NewCost;
+					NextEdges[Source] = Edge;
+					Queue.HeapPush({ NewCost, Source });
+				}
+			}
+			OpenListPeak = FMath::Max(OpenListPeak, Queue.Num());
+		}
+		OutExpansions[Queries[0]] = Expansions;
+		OutOpenListPeaks[Queries[0]] = OpenListPeak;
+
+		for (const int32 Query : Queries)
+		{
+			FSpiderNavPathResult& Result = OutResults[Query];
+			const int32 Start = Starts[Query];
+
+			// Unset means unreachable (obstacle): own search for the partial path
+			if (Visited[Start] != Stamp || StartMark[Start] == Stamp)
+			{
+				int32 SinglePeak = 0;
+				OutExpansions[Query] += SearchSingle(Grid, Obstacles, Params, Start, Goal, Result, SinglePeak);
+				OutOpenListPeaks[Query] = FMath::Max(OutOpenListPeaks[Query], SinglePeak);
+				continue;
+			}
+
+			Result.NodeIndices.Reset();
+			for (int32 Node = Start; ; Node = Grid.EdgeTargets[NextEdges[Node]])
+			{
+				Result.NodeIndices.Add(Node);
+				if (Node == Goal)
+					break;
+			}
+			Result.bComplete = true;
+			Result.FillFromIndices(Grid);
+		}
+	}
+};
+
+FSpiderNavBatchSearch::FSpiderNavBatchSearch() = default;
+FSpiderNavBatchSearch::~FSpiderNavBatchSearch() = default;
+
+void FSpiderNavBatchSearch::Run(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FSpiderNavQueryParams& Params,
+	TConstArrayView<int32> Queries, TConstArrayView<int32> Starts, TConstArrayView<int32> Goals,
+	TArray<FSpiderNavPathResult>& OutResults, TArray<int32>& OutExpansions, TArray<int32>& OutOpenListPeaks)
+{
+	using namespace SpiderNavBatchSearchPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_BatchSearch);
+
+	check(OutResults.Num() == Starts.Num() && Goals.Num() == Starts.Num());
+	OutExpansions.Reset();
+	OutExpansions.SetNumZeroed(Starts.Num());
+	OutOpenListPeaks.Reset();
+	OutOpenListPeaks.SetNumZeroed(Starts.Num());
+	if (Queries.Num() == 0 || Grid.ReverseEdgeOffsets.Num() != Grid.NavNodes.Num() + 1)
+		return;
+
+	// Sort by goal so equal goals are adjacent
+	GroupedQueries.Reset();
+	GroupedQueries.Append(Queries.GetData(), Queries.Num());
+	GroupedQueries.StableSort([Goals](int32 A, int32 B) { return Goals[A] < Goals[B]; });
+
+	Tasks.Reset();
+	for (int32 First = 0; First < GroupedQueries.Num();)
+	{
+		int32 Count = 1;
+		while (First + Count < GroupedQueries.Num() && Goals[GroupedQueries[First + Count]] == Goals[GroupedQueries[First]])
+			++Count;
+
+		if (Count >= MIN_GROUP_SIZE)
+		{
+			Tasks.Add({ First, Count });
+		}
+		else
+		{
+			for (int32 i = 0; i < Count; ++i)
+				Tasks.Add({ First + i, 1 });
+		}
+		First += Count;
+	}
+
+	// One scratch per worker task, taken from the pool and put back afterwards
+	TArray<TUniquePtr<FScratch>> Contexts;
+	ParallelForWithTaskContext(Contexts, Tasks.Num(), [&](TUniquePtr<FScratch>& Scratch, int32 TaskIndex)
+	{
+		if (!Scratch)
+			Scratch = ClaimScratch();
+
+		const FTask& Task = Tasks[TaskIndex];
+		if (Task.Count == 1)
+		{
+			const int32 Query = GroupedQueries[Task.First];
+			OutExpansions[Query] = Scratch->SearchSingle(Grid, Obstacles, Params, Starts[Query], Goals[Query], OutResults[Query], OutOpenListPeaks[Query]);
+		}
+		else
+		{
+			const TConstArrayView<int32> Group(GroupedQueries.GetData() + Task.First, Task.Count);
+			Scratch->SearchGroup(Grid, Obstacles, Params, Group, Starts, Goals[Group[0]], OutResults, OutExpansions, OutOpenListPeaks);
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	FScopeLock Lock(&ScratchLock);
+	for (TUniquePtr<FScratch>& Scratch : Contexts)
+	{
+		if (Scratch)
+			ScratchPool.Add(MoveTemp(Scratch));
+	}
+}
+
+TUniquePtr<FSpiderNavBatchSearch::FScratch> FSpiderNavBatchSearch::ClaimScratch()
+{
+	FScopeLock Lock(&ScratchLock);
+	return ScratchPool.Num() > 0 ? ScratchPool.Pop() : MakeUnique<FScratch>();
+}
+
+SIZE_T FSpiderNavBatchSearch::GetAllocatedSize() const
+{
+	SIZE_T Size = Tasks.GetAllocatedSize() + GroupedQueries.GetAllocatedSize() + ScratchPool.GetAllocatedSize();
+	for (const TUniquePtr<FScratch>& Scratch : ScratchPool)
+		Size += Scratch->GetAllocatedSize();
+	return Size;
+}
@@ -0,0 +1,199 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavBidirectionalSearch.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "SpiderNavigationStats.h"
+#include "Algo/Reverse.h"
+
+bool FSpiderNavBidirectionalSearch::Search(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Start, int32 Goal, TArray<int32>& OutPath, bool& bOutComplete)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_BidirectionalSearch);
+
+	static constexpr float INF = TNumericLimits<float>::Max();
+
+	OutPath.Reset();
+	bOutComplete = false;
+	LastExpansions = 0;
+	LastOpenListPeak = 0;
+
+	const int32 NumNodes = Grid.NavNodes.Num();
+	if (!Grid.NavNodes.IsValidIndex(Start) || !Grid.NavNodes.IsValidIndex(Goal)
+		|| Grid.EdgeOffsets.Num() != NumNodes + 1 || Grid.ReverseEdgeOffsets.Num() != NumNodes + 1)
+		return false;
+
+	if (Start == Goal)
+	{
+		OutPath.Add(Start);
+		bOutComplete = true;
+		return true;
+	}
+
+	Prepare(NumNodes);
+
+	const FVector StartLocation = Grid.NavNodes[Start].Location;
+	const FVector GoalLocation = Grid.NavNodes[Goal].Location;
+	const float Scale = Grid.HeuristicScale;
+
+	// Balanced potential: forward +P, backward -P -> both directions consistent
+	auto Potential = [&](int32 Node)
+		{
+			const FVector& Location = Grid.NavNodes[Node].Location;
+			return 0.5f * ((Location - GoalLocation).Size() - (Location - StartLocation).Size()) * Scale;
+		};
+
+	auto Open = [this](FSide& Side, int32 Node, int32 Parent, float G, float Key)
+		{
+			Side.G[Node] = G;
+			Side.Parent[Node] = Parent;
+			Side.Visited[Node] = Stamp;
+			Side.Queue.HeapPush({ Key, G, Node });
+		};
+
+	Open(Forward, Start, INDEX_NONE, 0.f, Potential(Start));
+	Open(Backward, Goal, INDEX_NONE, 0.f, -Potential(Goal));
+
+	float Mu = INF;
+	int32 Meet = INDEX_NONE;
+	int32 BestPartial = Start;
+	float BestPartialDistance = (StartLocation - GoalLocation).SizeSquared();
+
+	while (true)
+	{
+		Forward.Prune(Stamp);
+		Backward.Prune(Stamp);
+		const bool bForwardOpen = Forward.Queue.Num() > 0;
+		const bool bBackwardOpen = Backward.Queue.Num() > 0;
+
+		if (Mu < INF)
+		{
+			// One side exhausted or the frontiers can no longer beat Mu
+			if (!bForwardOpen || !bBackwardOpen || Forward.Queue.HeapTop().Key + Backward.Queue.HeapTop().Key >= Mu)
+				break;
+		}
+		else if (!bForwardOpen)
+		{
+			break;
+		}
+
+		// Expand the smaller frontier; if the goal is enclosed, only the forward search keeps running for the partial path
+		const bool bExpandForward = !bBackwardOpen || Forward.Queue.Num() <= Backward.Queue.Num();
+		FSide& Side = bExpandForward ? Forward : Backward;
+		const FSide& Other = bExpandForward ? Backward : Forward;
+
+		FQueueEntry Top;
+		Side.Queue.HeapPop(Top);
+		const int32 Node = Top.Node;
+		Side.Closed[Node] = Stamp;
+		++LastExpansions;
+
+		if (bExpandForward)
+		{
+			const float Distance = (Grid.NavNodes[Node].Location - GoalLocation).SizeSquared();
+			if (Distance < BestPartialDistance)
+			{
+				BestPartialDistance = Distance;
+				BestPartial = Node;
+			}
+		}
+
+		auto Relax = [&](int32 Edge, int32 Next)
+			{
+				if (Obstacles.IsEdgeBlocked(Edge) || Side.IsClosed(Next, Stamp))
+					return;
+
+				const float NewG = Top.G + Grid.EdgeCosts[Edge];
+				if (Side.IsVisited(Next, Stamp) && NewG >= Side.G[Next])
+					return;
+
+				const float P = Potential(Next);
+				Open(Side, Next, Node, NewG, NewG + (bExpandForward ? P : -P));
+
+				if (Other.IsVisited(Next, Stamp) && NewG + Other.G[Next] < Mu)
+				{
+					Mu = NewG + Other.G[Next];
+					Meet = Next;
+				}
+			};
+
+		if (bExpandForward)
+		{
+			for (int32 Edge = Grid.EdgeOffsets[Node]; Edge < Grid.EdgeOffsets[Node + 1]; ++Edge)
+				Relax(Edge, Grid.EdgeTargets[Edge]);
+		}
+		else
+		{
+			for (int32 i = Grid.ReverseEdgeOffsets[Node]; i < Grid.ReverseEdgeOffsets[Node + 1]; ++i)
+			{
+				const int32 Edge = Grid.ReverseEdges[i];
+				Relax(Edge, Grid.EdgeSources[Edge]);
+			}
+		}
+
+		LastOpenListPeak = FMath::Max(LastOpenListPeak, Forward.Queue.Num() + Backward.Queue.Num());
+	}
+
+	const int32 End = Meet != INDEX_NONE ? Meet : BestPartial;
+	for (int32 Node = End; Node != INDEX_NONE; Node = Forward.Parent[Node])
+		OutPath.Add(Node);
+	Algo::Reverse(OutPath);
+
+	if (Meet != INDEX_NONE)
+	{
+		for (int32 Node = Backward.Parent[Meet]; Node != INDEX_NONE; Node = Backward.Parent[Node])
+			OutPath.Add(Node);
+		bOutComplete = true;
+	}
+	return OutPath.Num() > 0;
+}
+
+SIZE_T FSpiderNavBidirectionalSearch::GetAllocatedSize() const
+{
+	return Forward.GetAllocatedSize() + Backward.GetAllocatedSize();
+}
+
+void FSpiderNavBidirectionalSearch::Prepare(int32 NumNodes)
+{
+	if (Forward.G.Num() != NumNodes)
+	{
+		Forward.Prepare(NumNodes);
+		Backward.Prepare(NumNodes);
+		Stamp = 0;
+	}
+
+	// Overflow: reset the stamps
+	if (++Stamp == 0)
+	{
+		Forward.Prepare(NumNodes);
+		Backward.Prepare(NumNodes);
+		Stamp = 1;
+	}
+
+	Forward.Queue.Reset();
+	Backward.Queue.Reset();
+}
+
+void FSpiderNavBidirectionalSearch::FSide::Prepare(int32 NumNodes)
+{
+	G.SetNumUninitialized(NumNodes);
+	Parent.SetNumUninitialized(NumNodes);
+	Visited.Init(0, NumNodes);
+	Closed.Init(0, NumNodes);
+	Queue.Reset();
+}
+
+void FSpiderNavBidirectionalSearch::FSide::Prune(uint32 Stamp)
+{
+	while (Queue.Num() > 0)
+	{
+		const FQueueEntry& Top = Queue.HeapTop();
+		if (!IsClosed(Top.Node, Stamp) && Top.G == G[Top.Node])
+			return;
+		Queue.HeapPopDiscard();
+	}
+}
+
+SIZE_T FSpiderNavBidirectionalSearch::FSide::GetAllocatedSize() const
+{
+	return G.GetAllocatedSize() + Parent.GetAllocatedSize() + Visited.GetAllocatedSize() + Closed.GetAllocatedSize() + Queue.GetAllocatedSize();
+}
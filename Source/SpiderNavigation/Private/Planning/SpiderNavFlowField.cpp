@@ -0,0 +1,120 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavFlowField.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "SpiderNavigationStats.h"
+
+void FSpiderNavFlowField::Start(const FSavedSpiderNavGrid& Grid, int32 TargetNode)
+{
+	Queue.Reset();
+	BuildTarget = INDEX_NONE;
+	if (!Grid.NavNodes.IsValidIndex(TargetNode) || Grid.EdgeOffsets.Num() != Grid.NavNodes.Num() + 1)
+		return;
+
+	BuildTarget = TargetNode;
+	BuildNumEdges = Grid.EdgeTargets.Num();
+	BuildNextEdges.Init(INDEX_NONE, Grid.NavNodes.Num());
+	BuildCosts.Init(TNumericLimits<float>::Max(), Grid.NavNodes.Num());
+
+	BuildCosts[TargetNode] = 0.f;
+	Queue.HeapPush({ 0.f, TargetNode });
+}
+
+bool FSpiderNavFlowField::Step(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32& InOutBudget)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FlowFieldStep);
+
+	if (!IsBuilding())
+		return false;
+
+	// Grid was replaced during the build
+	if (BuildCosts.Num() != Grid.NavNodes.Num() || BuildNumEdges != Grid.EdgeTargets.Num() || Grid.ReverseEdgeOffsets.Num() != Grid.NavNodes.Num() + 1)
+	{
+		Queue.Reset();
+		BuildTarget = INDEX_NONE;
+		return false;
+	}
+
+	int32 Expansions = 0;
+	while (Queue.Num() > 0 && Expansions < InOutBudget)
+	{
+		FQueueEntry Top;
+		Queue.HeapPop(Top);
+		// stale entry (node has been reached cheaper since)
+		if (Top.Cost > BuildCosts[Top.Node])
+			continue;
+
+		++Expansions;
+
+		// Backwards over incoming edges: source -> Top.Node
+		for (int32 i = Grid.ReverseEdgeOffsets[Top.Node]; i < Grid.ReverseEdgeOffsets[Top.Node + 1]; ++i)
+		{
+			const int32 Edge = Grid.ReverseEdges[i];
+			if (Obstacles.IsEdgeBlocked(Edge))
+				continue;
+
+			const int32 Source = Grid.EdgeSources[Edge];
+			const float NewCost = Top.Cost + Grid.EdgeCosts[Edge];
+			if (NewCost < BuildCosts[Source])
+			{
+				BuildCosts[Source] = NewCost;
+				BuildNextEdges[Source] = Edge;
+				Queue.HeapPush({ NewCost, Source });
+			}
+		}
+	}
+	InOutBudget -= Expansions;
+	INC_DWORD_STAT_BY(STAT_SpiderNav_Expansions, Expansions);
+
+	if (Queue.Num() > 0)
+		return false;
+
+	// Done: publish, the old arrays serve the next build
+	Target = BuildTarget;
+	NumEdges = BuildNumEdges;
+	BuildTarget = INDEX_NONE;
+	Swap(NextEdges, BuildNextEdges);
+	Swap(Costs, BuildCosts);
+	return true;
+}
+
+float FSpiderNavFlowField::GetCostToTarget(int32 Node) const
+{
+	if (!Costs.IsValidIndex(Node) || Costs[Node] == TNumericLimits<float>::Max())
+		return -1.f;
+	return Costs[Node];
+}
+
+bool FSpiderNavFlowField::Follow(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Node, int32 MaxNodes, TArray<int32>& OutNodes) const
+{
+	OutNodes.Reset();
+	if (!IsReady() || NextEdges.Num() != Grid.NavNodes.Num() || NumEdges != Grid.EdgeTargets.Num() || GetCostToTarget(Node) < 0.f)
+		return false;
+
+	OutNodes.Add(Node);
+	while (Node != Target && OutNodes.Num() < MaxNodes)
+	{
+		const int32 Edge = NextEdges[Node];
+		// Blocked since the build -> the caller searches itself
+		if (Edge == INDEX_NONE || Obstacles.IsEdgeBlocked(Edge))
+			return false;
+
+		Node = Grid.EdgeTargets[Edge];
+		OutNodes.Add(Node);
+	}
+	return true;
+}
+
+void FSpiderNavFlowField::Reset()
+{
+	Target = INDEX_NONE;
+	BuildTarget = INDEX_NONE;
+	NumEdges = 0;
+	BuildNumEdges = 0;
+	NextEdges.Reset();
+	Costs.Reset();
+	BuildNextEdges.Reset();
+	BuildCosts.Reset();
+	Queue.Reset();
+}
@@ -0,0 +1,370 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavIncrementalPlanner.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "SpiderNavigationStats.h"
+#include "Algo/Reverse.h"
+
+namespace SpiderNavIncrementalPlannerPrivate
+{
+	static constexpr float INF = TNumericLimits<float>::Max();
+
+	// Once the agent has walked this far along the path, a new tree from its node pays off
+	static constexpr int32 MAX_ROOT_LAG = 32;
+
+	// Stale heap entries before the heap is rebuilt
+	static constexpr int32 STALE_QUEUE_FACTOR = 4;
+	static constexpr int32 STALE_QUEUE_SLACK = 1024;
+}
+
+void FSpiderNavIncrementalPlanner::Reset()
+{
+	States.Reset();
+	Queue.Reset();
+	NumQueued = 0;
+	Root = INDEX_NONE;
+	Goal = INDEX_NONE;
+}
+
+bool FSpiderNavIncrementalPlanner::Plan(const FSavedSpiderNavGrid& InGrid, const FSpiderNavObstacleLayer& InObstacles, int32 Start, int32 NewGoal, TArray<int32>& OutPath, bool& bOutComplete)
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_IncrementalPlan);
+
+	OutPath.Reset();
+	bOutComplete = false;
+	LastExpansions = 0;
+	LastOpenListPeak = 0;
+
+	if (!InGrid.NavNodes.IsValidIndex(Start) || !InGrid.NavNodes.IsValidIndex(NewGoal) || InGrid.EdgeOffsets.Num() != InGrid.NavNodes.Num() + 1)
+		return false;
+
+	Bind(InGrid, InObstacles);
+
+	bLastPlanIncremental = HasTree();
+	if (!HasTree())
+		StartTree(Start);
+	SetGoal(NewGoal);
+	ComputeShortestPath();
+	ExtractPath(OutPath, bOutComplete);
+
+	// The agent has to stand on the path from the root, otherwise rebuild
+	const int32 StartPosition = OutPath.Find(Start);
+	if (StartPosition == INDEX_NONE || StartPosition > MAX_ROOT_LAG)
+	{
+		bLastPlanIncremental = false;
+		StartTree(Start);
+		SetGoal(NewGoal);
+		ComputeShortestPath();
+		ExtractPath(OutPath, bOutComplete);
+	}
+	else if (StartPosition > 0)
+	{
+		OutPath.RemoveAt(0, StartPosition);
+	}
+
+	Unbind();
+	return OutPath.Num() > 0;
+}
+
+void FSpiderNavIncrementalPlanner::NotifyChanged(const FSavedSpiderNavGrid& InGrid, const FSpiderNavObstacleLayer& InObstacles, const FBox& Bounds)
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	if (!HasTree() || !Bounds.IsValid)
+		return;
+
+	Bind(InGrid, InObstacles);
+
+	// Changed edges cross Bounds -> both endpoints lie at most one edge length away
+	InGrid.SpatialIndex.ForEachInBox(Bounds.ExpandBy(InGrid.MaxEdgeLength), [this](int32 Node)
+		{
+			if (Node == Root)
+				return;
+
+			const float Rhs = ComputeRhs(Node);
+			if (!States.Contains(Node) && Rhs == INF)
+				return;
+
+			FState& State = GetState(Node);
+			if (State.Rhs != Rhs)
+			{
+				State.Rhs = Rhs;
+				UpdateQueue(Node, State);
+			}
+		});
+
+	Unbind();
+}
+
+void FSpiderNavIncrementalPlanner::Bind(const FSavedSpiderNavGrid& InGrid, const FSpiderNavObstacleLayer& InObstacles)
+{
+	Grid = &InGrid;
+	Obstacles = &InObstacles;
+}
+
+void FSpiderNavIncrementalPlanner::Unbind()
+{
+	Grid = nullptr;
+	Obstacles = nullptr;
+}
+
+void FSpiderNavIncrementalPlanner::StartTree(int32 Start)
+{
+	Reset();
+	Root = Start;
+
+	// Key is computed in SetGoal
+	FState& State = GetState(Start);
+	State.Rhs = 0.f;
+	State.bInQueue = true;
+	NumQueued = 1;
+}
+
+void FSpiderNavIncrementalPlanner::SetGoal(int32 NewGoal)
+{
+	if (NewGoal == Goal)
+		return;
+
+	Goal = NewGoal;
+	GoalLocation = Grid->NavNodes[Goal].Location;
+	RebuildQueue();
+}
+
+void FSpiderNavIncrementalPlanner::ComputeShortestPath()
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	while (true)
+	{
+		PruneQueue();
+		if (Queue.Num() == 0)
+			break;
+
+		const FState GoalState = States.FindRef(Goal);
+		if (!(Queue.HeapTop().Key < CalculateKey(Goal, GoalState)) && GoalState.G == GoalState.Rhs)
+			break;
+
+		FQueueEntry Top;
+		Queue.HeapPop(Top);
+		const int32 Node = Top.Node;
+		++LastExpansions;
+
+		FState& State = States.FindChecked(Node);
+		State.bInQueue = false;
+		--NumQueued;
+
+		if (State.G > State.Rhs)
+		{
+			// Overconsistent: take g, successors can only get cheaper
+			State.G = State.Rhs;
+			const float G = State.G;
+			for (int32 Edge = Grid->EdgeOffsets[Node]; Edge < Grid->EdgeOffsets[Node + 1]; ++Edge)
+			{
+				const int32 Next = Grid->EdgeTargets[Edge];
+				const float Cost = EdgeCost(Edge);
+				if (Next == Root || Cost == INF)
+					continue;
+
+				FState& NextState = GetState(Next);
+				if (G + Cost < NextState.Rhs)
+				{
+					NextState.Rhs = G + Cost;
+					UpdateQueue(Next, NextState);
+				}
+			}
+		}
+		else
+		{
+			// Underconsistent: drop g, re-evaluate all successors that went through it
+			const float OldG = State.G;
+			State.G = INF;
+			if (Node != Root)
+				State.Rhs = ComputeRhs(Node);
+			UpdateQueue(Node, State);
+
+			for (int32 Edge = Grid->EdgeOffsets[Node]; Edge < Grid->EdgeOffsets[Node + 1]; ++Edge)
+			{
+				const int32 Next = Grid->EdgeTargets[Edge];
+				const float Cost = EdgeCost(Edge);
+				FState* NextState = States.Find(Next);
+				if (Next == Root || Cost == INF || !NextState || NextState->Rhs != OldG + Cost)
+					continue;
+
+				NextState->Rhs = ComputeRhs(Next);
+				UpdateQueue(Next, *NextState);
+			}
+		}
+	}
+}
+
+bool FSpiderNavIncrementalPlanner::ExtractPath(TArray<int32>& OutPath, bool& bOutComplete) const
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	OutPath.Reset();
+	bOutComplete = false;
+
+	int32 End = Goal;
+	const FState* GoalState = FindState(Goal);
+	if (GoalState && GoalState->G != INF)
+	{
+		bOutComplete = true;
+	}
+	else
+	{
+		// Goal unreachable: take the reached node closest to the goal
+		End = INDEX_NONE;
+		float BestH = INF;
+		for (const TPair<int32, FState>& Pair : States)
+		{
+			if (Pair.Value.G == INF || Pair.Value.G != Pair.Value.Rhs)
+				continue;
+
+			const float H = Heuristic(Pair.Key);
+			if (H < BestH || (H == BestH && Pair.Key < End))
+			{
+				BestH = H;
+				End = Pair.Key;
+			}
+		}
+		if (End == INDEX_NONE)
+			return false;
+	}
+
+	// Backwards over the predecessor with minimal g + c
+	OutPath.Add(End);
+	int32 Node = End;
+	while (Node != Root && OutPath.Num() <= States.Num())
+	{
+		int32 BestPrevious = INDEX_NONE;
+		float BestCost = INF;
+		for (int32 i = Grid->ReverseEdgeOffsets[Node]; i < Grid->ReverseEdgeOffsets[Node + 1]; ++i)
+		{
+			const int32 Edge = Grid->ReverseEdges[i];
+			const FState* Previous = FindState(Grid->EdgeSources[Edge]);
+			const float Cost = EdgeCost(Edge);
+			if (!Previous || Previous->G == INF || Cost == INF)
+				continue;
+
+			if (Previous->G + Cost < BestCost)
+			{
+				BestCost = Previous->G + Cost;
+				BestPrevious = Grid->EdgeSources[Edge];
+			}
+		}
+		if (BestPrevious == INDEX_NONE)
+		{
+			OutPath.Reset();
+			bOutComplete = false;
+			return false;
+		}
+
+		OutPath.Add(BestPrevious);
+		Node = BestPrevious;
+	}
+
+	if (Node != Root)
+	{
+		OutPath.Reset();
+		bOutComplete = false;
+		return false;
+	}
+
+	Algo::Reverse(OutPath);
+	return true;
+}
+
+float FSpiderNavIncrementalPlanner::Heuristic(int32 Node) const
+{
+	return (Grid->NavNodes[Node].Location - GoalLocation).Size() * Grid->HeuristicScale;
+}
+
+float FSpiderNavIncrementalPlanner::EdgeCost(int32 Edge) const
+{
+	return Obstacles->IsEdgeBlocked(Edge) ? SpiderNavIncrementalPlannerPrivate::INF : Grid->EdgeCosts[Edge];
+}
+
+FSpiderNavIncrementalPlanner::FKey FSpiderNavIncrementalPlanner::CalculateKey(int32 Node, const FState& State) const
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	const float Min = FMath::Min(State.G, State.Rhs);
+	FKey Key;
+	Key.K1 = Min == INF ? INF : Min + Heuristic(Node);
+	Key.K2 = Min;
+	return Key;
+}
+
+float FSpiderNavIncrementalPlanner::ComputeRhs(int32 Node) const
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	float Rhs = INF;
+	for (int32 i = Grid->ReverseEdgeOffsets[Node]; i < Grid->ReverseEdgeOffsets[Node + 1]; ++i)
+	{
+		const int32 Edge = Grid->ReverseEdges[i];
+		const FState* Previous = FindState(Grid->EdgeSources[Edge]);
+		const float Cost = EdgeCost(Edge);
+		if (Previous && Previous->G != INF && Cost != INF)
+			Rhs = FMath::Min(Rhs, Previous->G + Cost);
+	}
+	return Rhs;
+}
+
+void FSpiderNavIncrementalPlanner::UpdateQueue(int32 Node, FState& State)
+{
+	using namespace SpiderNavIncrementalPlannerPrivate;
+
+	if (State.G != State.Rhs)
+	{
+		State.Key = CalculateKey(Node, State);
+		if (!State.bInQueue)
+		{
+			State.bInQueue = true;
+			++NumQueued;
+			LastOpenListPeak = FMath::Max(LastOpenListPeak, NumQueued);
+		}
+		// Old entries stay in the heap and are recognised as stale by their key
+		Queue.HeapPush({ State.Key, Node });
+
+		if (Queue.Num() > STALE_QUEUE_FACTOR * NumQueued + STALE_QUEUE_SLACK)
+			RebuildQueue();
+	}
+	else if (State.bInQueue)
+	{
+		State.bInQueue = false;
+		--NumQueued;
+	}
+}
+
+void FSpiderNavIncrementalPlanner::PruneQueue()
+{
+	while (Queue.Num() > 0)
+	{
+		const FQueueEntry& Top = Queue.HeapTop();
+		const FState* State = FindState(Top.Node);
+		if (State && State->bInQueue && State->Key == Top.Key)
+			return;
+
+		Queue.HeapPopDiscard();
+	}
+}
+
+void FSpiderNavIncrementalPlanner::RebuildQueue()
+{
+	Queue.Reset();
+	NumQueued = 0;
+	for (TPair<int32, FState>& Pair : States)
+	{
+		if (!Pair.Value.bInQueue)
+			continue;
+
+		Pair.Value.Key = CalculateKey(Pair.Key, Pair.Value);
+		Queue.Add({ Pair.Value.Key, Pair.Key });
+		++NumQueued;
+	}
+	Queue.Heapify();
+	LastOpenListPeak = FMath::Max(LastOpenListPeak, NumQueued);
+}
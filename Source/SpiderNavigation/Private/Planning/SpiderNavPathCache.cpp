@@ -0,0 +1,216 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavPathCache.h"
+#include "SpiderNavigationStats.h"
+
+bool FSpiderNavPathCache::Find(int32 Start, int32 Goal, uint32 GridVersion, TArray<int32>& OutPath, bool& bOutComplete)
+{
+	SyncVersion(GridVersion);
+	if (Capacity <= 0)
+		return false;
+
+	if (const int32* EntryIndex = ByKey.Find(MakeKey(Start, Goal)))
+	{
+		const FEntry& Entry = Entries[*EntryIndex];
+		// Reset + Append instead of assignment: keeps the caller's buffer
+		OutPath.Reset(Entry.Path.Num());
+		OutPath.Append(Entry.Path);
+		bOutComplete = Entry.bComplete;
+		Touch(*EntryIndex);
+		++Hits;
+		INC_DWORD_STAT(STAT_SpiderNav_PathCacheHits);
+		return true;
+	}
+
+	// Start lies on a complete path to the same goal -> take the rest
+	if (const FPathPosition* Position = ByNode.Find(MakeKey(Start, Goal)))
+	{
+		const FEntry& Entry = Entries[Position->Entry];
+		OutPath.Reset(Entry.Path.Num() - Position->Position);
+		OutPath.Append(Entry.Path.GetData() + Position->Position, Entry.Path.Num() - Position->Position);
+		bOutComplete = true;
+		Touch(Position->Entry);
+		++SuffixHits;
+		INC_DWORD_STAT(STAT_SpiderNav_PathCacheSuffixHits);
+		return true;
+	}
+
+	++Misses;
+	INC_DWORD_STAT(STAT_SpiderNav_PathCacheMisses);
+	return false;
+}
+
+bool FSpiderNavPathCache::FindNextNode(int32 Start, int32 Goal, uint32 GridVersion, int32& OutNext)
+{
+	SyncVersion(GridVersion);
+	if (Capacity <= 0)
+		return false;
+
+	if (const int32* EntryIndex = ByKey.Find(MakeKey(Start, Goal)))
+	{
+		const FEntry& Entry = Entries[*EntryIndex];
+		if (Entry.Path.Num() > 1)
+		{
+			OutNext = Entry.Path[1];
+			Touch(*EntryIndex);
+			++Hits;
+			INC_DWORD_STAT(STAT_SpiderNav_PathCacheHits);
+			return true;
+		}
+	}
+
+	if (const FPathPosition* Position = ByNode.Find(MakeKey(Start, Goal)))
+	{
+		const FEntry& Entry = Entries[Position->Entry];
+		if (Position->Position + 1 < Entry.Path.Num())
+		{
+			OutNext = Entry.Path[Position->Position + 1];
+			Touch(Position->Entry);
+			++SuffixHits;
+			INC_DWORD_STAT(STAT_SpiderNav_PathCacheSuffixHits);
+			return true;
+		}
+	}
+	return false;
+}
+
+void FSpiderNavPathCache::Add(int32 Start, int32 Goal, uint32 GridVersion, const TArray<int32>& Path, bool bComplete)
+{
+	SyncVersion(GridVersion);
+	if (Capacity <= 0 || Path.Num() == 0 || ByKey.Contains(MakeKey(Start, Goal)))
+		return;
+
+	while (ByKey.Num() >= Capacity && Tail != INDEX_NONE)
+		Evict(Tail);
+
+	int32 EntryIndex;
+	if (FreeEntries.Num() > 0)
+		EntryIndex = FreeEntries.Pop();
+	else
+		EntryIndex = Entries.AddDefaulted();
+
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Start = Start;
+	Entry.Goal = Goal;
+	Entry.Path = Path;
+	Entry.bComplete = bComplete;
+	LinkFront(EntryIndex);
+	ByKey.Add(MakeKey(Start, Goal), EntryIndex);
+
+	// Subpaths only from complete (optimal) paths; existing entries stay
+	if (bComplete)
+	{
+		for (int32 i = 0; i < Path.Num(); ++i)
+		{
+			const uint64 Key = MakeKey(Path[i], Goal);
+			if (!ByNode.Contains(Key))
+				ByNode.Add(Key, { EntryIndex, i });
+		}
+	}
+}
+
+void FSpiderNavPathCache::SetCapacity(int32 InCapacity)
+{
+	Capacity = FMath::Max(0, InCapacity);
+	while (ByKey.Num() > Capacity && Tail != INDEX_NONE)
+		Evict(Tail);
+}
+
+void FSpiderNavPathCache::Reset()
+{
+	Entries.Reset();
+	FreeEntries.Reset();
+	ByKey.Reset();
+	ByNode.Reset();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+	Hits = 0;
+	SuffixHits = 0;
+	Misses = 0;
+}
+
+float FSpiderNavPathCache::GetHitRate() const
+{
+	const uint64 Lookups = Hits + SuffixHits + Misses;
+	return Lookups > 0 ? float(double(Hits + SuffixHits) / double(Lookups)) : 0.f;
+}
+
+SIZE_T FSpiderNavPathCache::GetAllocatedSize() const
+{
+	SIZE_T Size = Entries.GetAllocatedSize() + FreeEntries.GetAllocatedSize() + ByKey.GetAllocatedSize() + ByNode.GetAllocatedSize();
+	for (const FEntry& Entry : Entries)
+		Size += Entry.Path.GetAllocatedSize();
+	return Size;
+}
+
+void FSpiderNavPathCache::Unlink(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (Entry.Prev != INDEX_NONE)
+		Entries[Entry.Prev].Next = Entry.Next;
+	else
+		Head = Entry.Next;
+
+	if (Entry.Next != INDEX_NONE)
+		Entries[Entry.Next].Prev = Entry.Prev;
+	else
+		Tail = Entry.Prev;
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FSpiderNavPathCache::LinkFront(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+		Entries[Head].Prev = EntryIndex;
+	Head = EntryIndex;
+	if (Tail == INDEX_NONE)
+		Tail = EntryIndex;
+}
+
+void FSpiderNavPathCache::Evict(int32 EntryIndex)
+{
+	Unlink(EntryIndex);
+
+	FEntry& Entry = Entries[EntryIndex];
+	ByKey.Remove(MakeKey(Entry.Start, Entry.Goal));
+	if (Entry.bComplete)
+	{
+		for (const int32 Node : Entry.Path)
+		{
+			const uint64 Key = MakeKey(Node, Entry.Goal);
+			const FPathPosition* Position = ByNode.Find(Key);
+			if (Position && Position->Entry == EntryIndex)
+				ByNode.Remove(Key);
+		}
+	}
+
+	Entry.Path.Empty();
+	FreeEntries.Add(EntryIndex);
+}
+
+void FSpiderNavPathCache::Touch(int32 EntryIndex)
+{
+	if (Head == EntryIndex)
+		return;
+	Unlink(EntryIndex);
+	LinkFront(EntryIndex);
+}
+
+void FSpiderNavPathCache::SyncVersion(uint32 GridVersion)
+{
+	if (GridVersion == CachedGridVersion)
+		return;
+
+	// Keep the statistics across versions
+	const uint64 KeepHits = Hits, KeepSuffixHits = SuffixHits, KeepMisses = Misses;
+	Reset();
+	Hits = KeepHits;
+	SuffixHits = KeepSuffixHits;
+	Misses = KeepMisses;
+	CachedGridVersion = GridVersion;
+}
@@ -0,0 +1,108 @@
+// Copyright Yves Tanas 2025
+
+#include "Planning/SpiderNavPathSmoothing.h"
+#include "Structs/SpiderNavPathResult.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "Structs/SpiderNavNode.h"
+#include "SpiderNavigationStats.h"
+
+namespace SpiderNavPathSmoothingPrivate
+{
+	// Longest stretch tested from one anchor (keeps the cost bounded)
+	static constexpr int32 MAX_STRETCH = 64;
+
+	struct FAnchorPlane
+	{
+		FVector Location;
+		FVector Normal;
+		int32 ComponentId;
+		float MinNormalDot;
+		float Tolerance;
+
+		bool Contains(const FVector& InLocation, const FVector& InNormal) const
+		{
+			return FVector::DotProduct(Normal, InNormal) >= MinNormalDot
+				&& FMath::Abs(FVector::DotProduct(InLocation - Location, Normal)) <= Tolerance;
+		}
+	};
+
+	/** An unblocked node of the anchor's component lies on its plane within Radius of Sample */
+	static bool HasSupport(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FAnchorPlane& Plane,
+		const FVector& Sample, double Radius)
+	{
+		const double RadiusSquared = FMath::Square(Radius);
+		bool bFound = false;
+		Grid.SpatialIndex.ForEachInBox(FBox(Sample - FVector(Radius), Sample + FVector(Radius)), [&](int32 NodeIndex)
+			{
+				if (bFound)
+					return;
+				const FSpiderNavNode& Node = Grid.NavNodes[NodeIndex];
+				bFound = FVector::DistSquared(Node.Location, Sample) <= RadiusSquared
+					&& Node.ComponentId == Plane.ComponentId
+					&& !Obstacles.IsNodeBlocked(NodeIndex)
+					&& Plane.Contains(Node.Location, Node.Normal);
+			});
+		return bFound;
+	}
+
+	/** Walks the segment from the anchor to Target; every sample needs support, the endpoints are path nodes */
+	static bool IsVisible(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FAnchorPlane& Plane,
+		const FVector& Target, double Radius)
+	{
+		const FVector Delta = Target - Plane.Location;
+		const int32 NumSteps = FMath::CeilToInt32(Delta.Size() / Radius);
+		for (int32 Step = 1; Step < NumSteps; ++Step)
+		{
+			if (!HasSupport(Grid, Obstacles, Plane, Plane.Location + Delta * (double(Step) / NumSteps), Radius))
+				return false;
+		}
+		return true;
+	}
+}
+
+int32 FSpiderNavPathSmoothing::Smooth(FSpiderNavPathResult& Path, const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles,
+	float MaxNormalAngleDegrees, float Tolerance)
+{
+	using namespace SpiderNavPathSmoothingPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_SmoothPath);
+
+	// Without query data there is nothing to test visibility against
+	if (Path.Num() < 3 || Grid.SpatialIndex.IsEmpty() || Grid.MaxEdgeLength <= 0.f)
+		return 0;
+
+	// Half the longest (diagonal) edge: every point of a covered lattice cell is that close to one of its nodes
+	const double Radius = FMath::Max(0.5 * Grid.MaxEdgeLength, (double)Tolerance);
+	const float MinNormalDot = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(MaxNormalAngleDegrees, 0.f, 90.f)));
+
+	int32 Write = 1;
+	int32 Anchor = 0;
+	while (Anchor < Path.Num() - 1)
+	{
+		const FAnchorPlane Plane{ Path.Locations[Anchor], Path.Normals[Anchor],
+			Grid.NavNodes[Path.NodeIndices[Anchor]].ComponentId, MinNormalDot, Tolerance };
+
+		// Pull as far as possible: End is the last node directly visible from Anchor
+		int32 End = Anchor + 1;
+		for (int32 Candidate = Anchor + 2; Candidate < Path.Num() && Candidate - Anchor <= MAX_STRETCH; ++Candidate)
+		{
+			if (!Plane.Contains(Path.Locations[Candidate], Path.Normals[Candidate]))
+				break;
+			if (!IsVisible(Grid, Obstacles, Plane, Path.Locations[Candidate], Radius))
+				break;
+
+			End = Candidate;
+		}
+
+		Path.NodeIndices[Write] = Path.NodeIndices[End];
+		Path.Locations[Write] = Path.Locations[End];
+		Path.Normals[Write] = Path.Normals[End];
+		Path.CumulativeCosts[Write] = Path.CumulativeCosts[End];
+		++Write;
+		Anchor = End;
+	}
+
+	const int32 Removed = Path.Num() - Write;
+	Path.Truncate(Write);
+	return Removed;
+}
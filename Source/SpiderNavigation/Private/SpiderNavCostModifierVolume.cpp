@@ -0,0 +1,16 @@
+// Copyright Yves Tanas 2025
+
+#include "SpiderNavCostModifierVolume.h"
+
+#include "Components/BoxComponent.h"
+
+ASpiderNavCostModifierVolume::ASpiderNavCostModifierVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Volume = CreateDefaultSubobject<UBoxComponent>(FName("Volume"));
+	Volume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Volume->SetCanEverAffectNavigation(false);
+
+	RootComponent = Volume;
+}
@@ -3,6 +3,10 @@
 #include "SpiderNavGridBlockingVolume.h"
 
 #include "Components/BoxComponent.h"
+#include "Components/NavGridComponent.h"
+#include "Interfaces/SpiderNavigationInterface.h"
+#include "GameFramework/GameStateBase.h"
+#include "Engine/World.h"
 
 ASpiderNavGridBlockingVolume::ASpiderNavGridBlockingVolume()
 { 	
@@ -19,5 +23,77 @@ UBoxComponent* ASpiderNavGridBlockingVolume::GetBlockingVolume() const
 	return BlockingVolume;
 }
 
+void ASpiderNavGridBlockingVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (BlockingVolume)
+		BlockingVolume->TransformUpdated.AddUObject(this, &ASpiderNavGridBlockingVolume::OnVolumeTransformUpdated);
+
+	UpdateGrid();
+}
+
+void ASpiderNavGridBlockingVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (BlockingVolume)
+		BlockingVolume->TransformUpdated.RemoveAll(this);
+
+	if (NavGrid)
+		NavGrid->RemoveObstacle(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASpiderNavGridBlockingVolume::SetBlocking(bool bNewBlocking)
+{
+	if (bBlocking == bNewBlocking)
+		return;
+
+	bBlocking = bNewBlocking;
+	UpdateGrid();
+}
+
+void ASpiderNavGridBlockingVolume::OnVolumeTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UpdateGrid();
+}
+
+void ASpiderNavGridBlockingVolume::UpdateGrid()
+{
+	if (!HasActorBegunPlay() || !ResolveNavGrid() || !BlockingVolume)
+		return;
+
+	if (!bBlocking)
+	{
+		NavGrid->RemoveObstacle(this);
+		return;
+	}
+
+	// Scale is in the extent, the box itself is transformed without scale
+	FTransform Transform = BlockingVolume->GetComponentTransform();
+	Transform.SetScale3D(FVector::OneVector);
+	NavGrid->UpdateObstacle(this, Transform, BlockingVolume->GetScaledBoxExtent());
+}
+
+UNavGridComponent* ASpiderNavGridBlockingVolume::ResolveNavGrid()
+{
+	if (NavGrid)
+		return NavGrid;
+
+	// Same lookup as ASpiderAIController: navigation lives on the GameState
+	if (AGameStateBase* GameState = GetWorld() ? GetWorld()->GetGameState() : nullptr)
+	{
+		for (UActorComponent* Component : GameState->GetComponentsByInterface(USpiderNavigationInterface::StaticClass()))
+		{
+			if (UNavGridComponent* Grid = Cast<UNavGridComponent>(Component))
+			{
+				NavGrid = Grid;
+				break;
+			}
+		}
+	}
+	return NavGrid;
+}
+
 
 
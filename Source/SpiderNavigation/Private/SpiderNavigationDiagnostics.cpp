@@ -0,0 +1,75 @@
+// Copyright Yves Tanas 2025
+
+#include "SpiderNavigationDiagnostics.h"
+
+#if SPIDERNAV_DIAGNOSTICS
+
+#include "Controllers/SpiderAIController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+namespace SpiderNavDiagnostics
+{
+	static TAutoConsoleVariable<int32> CVarSpiderDebugLog(
+		TEXT("spider.Debug.Log"),
+		0,
+		TEXT("Spider navigation diagnostics logging. 0 = off, 1 = agents with bDebug, 2 = all agents"),
+		ECVF_Cheat);
+
+	static TAutoConsoleVariable<int32> CVarSpiderDebugDraw(
+		TEXT("spider.Debug.Draw"),
+		0,
+		TEXT("Spider navigation debug drawing. 0 = off, 1 = agents with bDebug, 2 = all agents"),
+		ECVF_Cheat);
+
+	static bool IsAgentFlagged(const UObject* Agent)
+	{
+		if (const APawn* Pawn = Cast<APawn>(Agent))
+			Agent = Pawn->GetController();
+
+		const ASpiderAIController* Controller = Cast<ASpiderAIController>(Agent);
+		return Controller && Controller->bDebug;
+	}
+
+	static bool IsEnabled(int32 Level, const UObject* Agent)
+	{
+		// Level 0 -> no lookup, no formatting
+		if (Level <= 0)
+			return false;
+		return Level >= 2 || IsAgentFlagged(Agent);
+	}
+
+	bool IsLogEnabled(const UObject* Agent)
+	{
+		return IsEnabled(CVarSpiderDebugLog.GetValueOnAnyThread(), Agent);
+	}
+
+	bool IsDrawEnabled(const UObject* Agent)
+	{
+		return IsEnabled(CVarSpiderDebugDraw.GetValueOnAnyThread(), Agent);
+	}
+
+	/** spider.Debug.Agent <Name> [0|1] toggles bDebug on controllers whose own or pawn name contains Name */
+	static FAutoConsoleCommandWithWorldAndArgs CmdSpiderDebugAgent(
+		TEXT("spider.Debug.Agent"),
+		TEXT("Toggles per-agent diagnostics. Usage: spider.Debug.Agent <Name> [0|1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+			{
+				if (!World || Args.Num() == 0)
+					return;
+
+				for (TActorIterator<ASpiderAIController> It(World); It; ++It)
+				{
+					ASpiderAIController* Controller = *It;
+					const APawn* Pawn = Controller->GetPawn();
+					if (!Controller->GetName().Contains(Args[0]) && !(Pawn && Pawn->GetName().Contains(Args[0])))
+						continue;
+
+					Controller->bDebug = Args.Num() > 1 ? FCString::Atoi(*Args[1]) != 0 : !Controller->bDebug;
+					UE_LOG(LogSpiderNavigation, Display, TEXT("%s: bDebug = %d"), *Controller->GetName(), Controller->bDebug);
+				}
+			}));
+}
+
+#endif
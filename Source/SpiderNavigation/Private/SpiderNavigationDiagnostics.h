@@ -0,0 +1,48 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpiderNavigationPrivate.h"
+
+/** Diagnostics are compiled out of shipping and test builds */
+#define SPIDERNAV_DIAGNOSTICS !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+#if SPIDERNAV_DIAGNOSTICS
+
+namespace SpiderNavDiagnostics
+{
+	/**
+	 * spider.Debug.Log / spider.Debug.Draw: 0 = off, 1 = agents with bDebug, 2 = all agents.
+	 * Agent may be a spider controller, its pawn or nullptr (only logged on level 2).
+	 */
+	bool IsLogEnabled(const UObject* Agent);
+	bool IsDrawEnabled(const UObject* Agent);
+}
+
+/** Logs to LogSpiderNavigation. Arguments are only evaluated when logging is enabled for Agent */
+#define SPIDERNAV_LOG(Agent, Verbosity, Format, ...) \
+	do \
+	{ \
+		if (SpiderNavDiagnostics::IsLogEnabled(Agent)) \
+		{ \
+			UE_LOG(LogSpiderNavigation, Verbosity, TEXT("[%s] %s(): ") Format, *GetNameSafe(Agent), ANSI_TO_TCHAR(__FUNCTION__), ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+/** Runs the draw statement only when drawing is enabled for Agent */
+#define SPIDERNAV_DRAW(Agent, ...) \
+	do \
+	{ \
+		if (SpiderNavDiagnostics::IsDrawEnabled(Agent)) \
+		{ \
+			__VA_ARGS__; \
+		} \
+	} while (0)
+
+#else
+
+#define SPIDERNAV_LOG(Agent, Verbosity, Format, ...) do {} while (0)
+#define SPIDERNAV_DRAW(Agent, ...) do {} while (0)
+
+#endif
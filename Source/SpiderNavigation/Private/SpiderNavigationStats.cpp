@@ -0,0 +1,70 @@
+// Copyright Yves Tanas 2025
+
+#include "SpiderNavigationStats.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_SpiderNav_FindPath);
+DEFINE_STAT(STAT_SpiderNav_FindClosestNode);
+DEFINE_STAT(STAT_SpiderNav_LoadGrid);
+
+DEFINE_STAT(STAT_SpiderNav_ClosestNodeLookups);
+DEFINE_STAT(STAT_SpiderNav_Searches);
+DEFINE_STAT(STAT_SpiderNav_PartialPaths);
+DEFINE_STAT(STAT_SpiderNav_CrossComponent);
+DEFINE_STAT(STAT_SpiderNav_Expansions);
+DEFINE_STAT(STAT_SpiderNav_OpenListPeak);
+DEFINE_STAT(STAT_SpiderNav_PathNodes);
+DEFINE_STAT(STAT_SpiderNav_PathLength);
+DEFINE_STAT(STAT_SpiderNav_PathCacheHits);
+DEFINE_STAT(STAT_SpiderNav_PathCacheSuffixHits);
+DEFINE_STAT(STAT_SpiderNav_PathCacheMisses);
+DEFINE_STAT(STAT_SpiderNav_NextHops);
+DEFINE_STAT(STAT_SpiderNav_NextHopSearches);
+DEFINE_STAT(STAT_SpiderNav_CoarseUpdates);
+
+DEFINE_STAT(STAT_SpiderNav_LoadTimeMs);
+DEFINE_STAT(STAT_SpiderNav_LoadedNodes);
+DEFINE_STAT(STAT_SpiderNav_CoarseAgents);
+DEFINE_STAT(STAT_SpiderNav_GridMemory);
+
+UE_TRACE_CHANNEL_DEFINE(SpiderNavChannel);
+
+namespace SpiderNavStats
+{
+	void ReportOpenListPeak(int32 OpenListSize)
+	{
+#if STATS
+		static std::atomic<uint64> PeakFrame{ 0 };
+		static std::atomic<int32> Peak{ 0 };
+
+		// New frame -> reset the maximum
+		const uint64 Frame = GFrameCounter;
+		if (PeakFrame.exchange(Frame, std::memory_order_relaxed) != Frame)
+			Peak.store(0, std::memory_order_relaxed);
+
+		int32 Current = Peak.load(std::memory_order_relaxed);
+		while (OpenListSize > Current && !Peak.compare_exchange_weak(Current, OpenListSize, std::memory_order_relaxed))
+		{
+		}
+		SET_DWORD_STAT(STAT_SpiderNav_OpenListPeak, FMath::Max(Current, OpenListSize));
+#endif
+	}
+
+	void ReportSearch(int32 Expansions, int32 OpenListPeak, const TArray<FVector>& PathLocations, bool bComplete)
+	{
+#if STATS
+		INC_DWORD_STAT(STAT_SpiderNav_Searches);
+		INC_DWORD_STAT_BY(STAT_SpiderNav_Expansions, Expansions);
+		INC_DWORD_STAT_BY(STAT_SpiderNav_PathNodes, PathLocations.Num());
+		if (!bComplete)
+			INC_DWORD_STAT(STAT_SpiderNav_PartialPaths);
+
+		float Length = 0.f;
+		for (int32 i = 1; i < PathLocations.Num(); ++i)
+			Length += FVector::Dist(PathLocations[i - 1], PathLocations[i]);
+		INC_FLOAT_STAT_BY(STAT_SpiderNav_PathLength, Length);
+
+		ReportOpenListPeak(OpenListPeak);
+#endif
+	}
+}
@@ -0,0 +1,152 @@
+// Copyright Yves Tanas 2025
+
+#include "Structs/SavedSpiderNavGrid.h"
+
+namespace SavedSpiderNavGridPrivate
+{
+	// Normal.Z limits between floor, wall and ceiling
+	static constexpr float CEILING_NORMAL_Z = -0.7f;
+	static constexpr float FLOOR_NORMAL_Z = 0.7f;
+	// Lower bound so costs and heuristic stay positive
+	static constexpr float MIN_COST_MULTIPLIER = 0.01f;
+}
+
+void FSavedSpiderNavGrid::BuildQueryData(const FSpiderNavCostSettings& Costs)
+{
+	const int32 NumNodes = NavNodes.Num();
+
+	// Union-find with path halving over all edges
+	TArray<int32> Parent;
+	Parent.SetNumUninitialized(NumNodes);
+	for (int32 i = 0; i < NumNodes; ++i)
+		Parent[i] = i;
+
+	auto FindRoot = [&Parent](int32 Node)
+		{
+			while (Parent[Node] != Node)
+			{
+				Parent[Node] = Parent[Parent[Node]];
+				Node = Parent[Node];
+			}
+			return Node;
+		};
+
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		for (const FSpiderNavNode* Neighbor : NavNodes[i].Neighbors)
+		{
+			const int32 A = FindRoot(i);
+			const int32 B = FindRoot(Neighbor->Index);
+			if (A != B)
+				Parent[FMath::Max(A, B)] = FMath::Min(A, B);
+		}
+	}
+
+	// Dense IDs in order of their first node
+	TArray<int32> RootToComponent;
+	RootToComponent.Init(INDEX_NONE, NumNodes);
+	ComponentSizes.Reset();
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		int32& Component = RootToComponent[FindRoot(i)];
+		if (Component == INDEX_NONE)
+			Component = ComponentSizes.Add(0);
+
+		NavNodes[i].ComponentId = Component;
+		++ComponentSizes[Component];
+	}
+
+	SpatialIndex.Build(NavNodes);
+
+	// Compute edge costs once -> only a table lookup in the A* loop
+	TArray<float> NodeMultipliers;
+	NodeMultipliers.SetNumUninitialized(NumNodes);
+	int32 NumEdges = 0;
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		NodeMultipliers[i] = GetNodeCostMultiplier(NavNodes[i], Costs);
+		NumEdges += NavNodes[i].Neighbors.Num();
+	}
+
+	EdgeOffsets.SetNumUninitialized(NumNodes + 1);
+	EdgeTargets.Reset(NumEdges);
+	EdgeCosts.Reset(NumEdges);
+	float MinMultiplier = TNumericLimits<float>::Max();
+	MaxEdgeLength = 0.f;
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		EdgeOffsets[i] = EdgeTargets.Num();
+		for (const FSpiderNavNode* Neighbor : NavNodes[i].Neighbors)
+		{
+			const float Multiplier = 0.5f * (NodeMultipliers[i] + NodeMultipliers[Neighbor->Index]);
+			const float Length = (Neighbor->Location - NavNodes[i].Location).Size();
+			EdgeTargets.Add(Neighbor->Index);
+			EdgeCosts.Add(Length * Multiplier);
+			MinMultiplier = FMath::Min(MinMultiplier, Multiplier);
+			MaxEdgeLength = FMath::Max(MaxEdgeLength, Length);
+		}
+	}
+	EdgeOffsets[NumNodes] = EdgeTargets.Num();
+	HeuristicScale = NumEdges > 0 ? FMath::Min(MinMultiplier, 1.f) : 1.f;
+
+	// Incoming edges for incremental planners (rhs over predecessors)
+	EdgeSources.SetNumUninitialized(NumEdges);
+	ReverseEdgeOffsets.Init(0, NumNodes + 1);
+	for (int32 i = 0; i < NumNodes; ++i)
+	{
+		for (int32 Edge = EdgeOffsets[i]; Edge < EdgeOffsets[i + 1]; ++Edge)
+		{
+			EdgeSources[Edge] = i;
+			++ReverseEdgeOffsets[EdgeTargets[Edge] + 1];
+		}
+	}
+	for (int32 i = 0; i < NumNodes; ++i)
+		ReverseEdgeOffsets[i + 1] += ReverseEdgeOffsets[i];
+
+	TArray<int32> Fill(ReverseEdgeOffsets.GetData(), NumNodes);
+	ReverseEdges.SetNumUninitialized(NumEdges);
+	for (int32 Edge = 0; Edge < NumEdges; ++Edge)
+		ReverseEdges[Fill[EdgeTargets[Edge]]++] = Edge;
+}
+
+float FSavedSpiderNavGrid::GetNodeCostMultiplier(const FSpiderNavNode& Node, const FSpiderNavCostSettings& Costs)
+{
+	using namespace SavedSpiderNavGridPrivate;
+
+	float Multiplier = 1.f;
+	if (Node.Normal.Z < CEILING_NORMAL_Z)
+		Multiplier = Costs.CeilingCostMultiplier;
+	else if (Node.Normal.Z < FLOOR_NORMAL_Z)
+		Multiplier = Costs.WallCostMultiplier;
+
+	for (const FSpiderNavCostSettings::FArea& Area : Costs.Areas)
+	{
+		const FVector Local = Area.Transform.InverseTransformPosition(Node.Location);
+		if (FMath::Abs(Local.X) <= Area.Extent.X && FMath::Abs(Local.Y) <= Area.Extent.Y && FMath::Abs(Local.Z) <= Area.Extent.Z)
+			Multiplier *= Area.Multiplier;
+	}
+	return FMath::Max(Multiplier, MIN_COST_MULTIPLIER);
+}
+
+int32 FSavedSpiderNavGrid::FindClosestNodeIndex(const FVector& Location, int32 ComponentId) const
+{
+	if (!SpatialIndex.IsEmpty())
+		return SpatialIndex.FindClosest(NavNodes, Location, ComponentId);
+
+	// Without index (BuildQueryData has not run): linear scan
+	int32 Best = INDEX_NONE;
+	double BestDistSq = TNumericLimits<double>::Max();
+	for (int32 i = 0; i < NavNodes.Num(); ++i)
+	{
+		if (ComponentId != INDEX_NONE && NavNodes[i].ComponentId != ComponentId)
+			continue;
+
+		const double DistSq = FVector::DistSquared(NavNodes[i].Location, Location);
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			Best = i;
+		}
+	}
+	return Best;
+}
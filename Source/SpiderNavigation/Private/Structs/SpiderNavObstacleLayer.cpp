@@ -0,0 +1,112 @@
+// Copyright Yves Tanas 2025
+
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "Structs/SavedSpiderNavGrid.h"
+
+void FSpiderNavObstacleLayer::Rebuild(const FSavedSpiderNavGrid& Grid)
+{
+	NodeBlockCount.Init(0, Grid.NavNodes.Num());
+	EdgeBlockCount.Init(0, Grid.EdgeTargets.Num());
+	BlockedNodes.Init(false, Grid.NavNodes.Num());
+	BlockedEdges.Init(false, Grid.EdgeTargets.Num());
+
+	for (TPair<FObjectKey, FObstacle>& Pair : Obstacles)
+	{
+		Collect(Grid, Pair.Value);
+		Apply(Pair.Value, 1);
+	}
+}
+
+FBox FSpiderNavObstacleLayer::Update(const FSavedSpiderNavGrid& Grid, FObjectKey Obstacle, const FTransform& Transform, const FVector& Extent)
+{
+	FObstacle* Existing = Obstacles.Find(Obstacle);
+	if (Existing && Existing->Transform.Equals(Transform) && Existing->Extent.Equals(Extent))
+		return FBox(ForceInit);
+
+	FObstacle Updated;
+	Updated.Transform = Transform;
+	Updated.Extent = Extent;
+	Collect(Grid, Updated);
+
+	// Count the new bounds first, then subtract the old -> the overlap stays blocked throughout
+	bool bChanged = Apply(Updated, 1);
+	FBox Changed = Updated.Bounds;
+	if (Existing)
+	{
+		bChanged |= Apply(*Existing, -1);
+		Changed += Existing->Bounds;
+	}
+
+	Obstacles.Add(Obstacle, MoveTemp(Updated));
+	return bChanged ? Changed : FBox(ForceInit);
+}
+
+FBox FSpiderNavObstacleLayer::Remove(FObjectKey Obstacle)
+{
+	FObstacle Removed;
+	if (!Obstacles.RemoveAndCopyValue(Obstacle, Removed))
+		return FBox(ForceInit);
+
+	return Apply(Removed, -1) ? Removed.Bounds : FBox(ForceInit);
+}
+
+SIZE_T FSpiderNavObstacleLayer::GetAllocatedSize() const
+{
+	SIZE_T Size = Obstacles.GetAllocatedSize() + NodeBlockCount.GetAllocatedSize() + EdgeBlockCount.GetAllocatedSize()
+		+ BlockedNodes.GetAllocatedSize() + BlockedEdges.GetAllocatedSize();
+	for (const TPair<FObjectKey, FObstacle>& Pair : Obstacles)
+		Size += Pair.Value.Nodes.GetAllocatedSize() + Pair.Value.Edges.GetAllocatedSize();
+	return Size;
+}
+
+void FSpiderNavObstacleLayer::Collect(const FSavedSpiderNavGrid& Grid, FObstacle& Obstacle)
+{
+	Obstacle.Nodes.Reset();
+	Obstacle.Edges.Reset();
+	Obstacle.Bounds = FBox(-Obstacle.Extent, Obstacle.Extent).TransformBy(Obstacle.Transform);
+
+	if (Grid.EdgeOffsets.Num() != Grid.NavNodes.Num() + 1)
+		return;
+
+	const FBox LocalBox(-Obstacle.Extent, Obstacle.Extent);
+
+	// Edges crossing the box have both endpoints at most one edge length away from it
+	Grid.SpatialIndex.ForEachInBox(Obstacle.Bounds.ExpandBy(Grid.MaxEdgeLength), [&](int32 NodeIndex)
+		{
+			const FVector A = Obstacle.Transform.InverseTransformPosition(Grid.NavNodes[NodeIndex].Location);
+			if (LocalBox.IsInsideOrOn(A))
+				Obstacle.Nodes.Add(NodeIndex);
+
+			for (int32 Edge = Grid.EdgeOffsets[NodeIndex]; Edge < Grid.EdgeOffsets[NodeIndex + 1]; ++Edge)
+			{
+				const FVector B = Obstacle.Transform.InverseTransformPosition(Grid.NavNodes[Grid.EdgeTargets[Edge]].Location);
+				if (LocalBox.IsInsideOrOn(A) || LocalBox.IsInsideOrOn(B) || FMath::LineBoxIntersection(LocalBox, A, B, B - A))
+					Obstacle.Edges.Add(Edge);
+			}
+		});
+}
+
+bool FSpiderNavObstacleLayer::Apply(const FObstacle& Obstacle, int32 Delta)
+{
+	bool bChanged = false;
+	auto ApplyTo = [Delta, &bChanged](const TArray<int32>& Indices, TArray<uint16>& Counts, TBitArray<>& Bits)
+		{
+			for (const int32 Index : Indices)
+			{
+				if (!Counts.IsValidIndex(Index))
+					continue;
+
+				Counts[Index] = (uint16)FMath::Clamp<int32>(Counts[Index] + Delta, 0, MAX_uint16);
+				const bool bBlocked = Counts[Index] > 0;
+				if ((bool)Bits[Index] != bBlocked)
+				{
+					Bits[Index] = bBlocked;
+					bChanged = true;
+				}
+			}
+		};
+
+	ApplyTo(Obstacle.Nodes, NodeBlockCount, BlockedNodes);
+	ApplyTo(Obstacle.Edges, EdgeBlockCount, BlockedEdges);
+	return bChanged;
+}
@@ -0,0 +1,45 @@
+// Copyright Yves Tanas 2025
+
+#include "Structs/SpiderNavPathResult.h"
+#include "Structs/SavedSpiderNavGrid.h"
+
+void FSpiderNavPathResult::FillFromIndices(const FSavedSpiderNavGrid& Grid)
+{
+	const int32 Count = NodeIndices.Num();
+	Locations.SetNumUninitialized(Count);
+	Normals.SetNumUninitialized(Count);
+	CumulativeCosts.SetNumUninitialized(Count);
+
+	float Cost = 0.f;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FSpiderNavNode& Node = Grid.NavNodes[NodeIndices[i]];
+		if (i > 0)
+		{
+			// Look the edge up in the CSR (few neighbours); not adjacent -> straight line with the minimal cost factor
+			const int32 From = NodeIndices[i - 1];
+			float EdgeCost = -1.f;
+			for (int32 Edge = Grid.EdgeOffsets[From]; Edge < Grid.EdgeOffsets[From + 1]; ++Edge)
+			{
+				if (Grid.EdgeTargets[Edge] == NodeIndices[i])
+				{
+					EdgeCost = Grid.EdgeCosts[Edge];
+					break;
+				}
+			}
+			Cost += EdgeCost >= 0.f ? EdgeCost : FVector::Dist(Locations[i - 1], Node.Location) * Grid.HeuristicScale;
+		}
+
+		Locations[i] = Node.Location;
+		Normals[i] = Node.Normal;
+		CumulativeCosts[i] = Cost;
+	}
+}
+
+void FSpiderNavPathResult::Truncate(int32 NewNum)
+{
+	NodeIndices.SetNum(NewNum, EAllowShrinking::No);
+	Locations.SetNum(NewNum, EAllowShrinking::No);
+	Normals.SetNum(NewNum, EAllowShrinking::No);
+	CumulativeCosts.SetNum(NewNum, EAllowShrinking::No);
+}
@@ -0,0 +1,174 @@
+// Copyright Yves Tanas 2025
+
+#include "Structs/SpiderNavSpatialIndex.h"
+#include "Structs/SpiderNavNode.h"
+
+namespace SpiderNavSpatialIndexPrivate
+{
+	// Sample for the average edge length
+	static constexpr int32 EDGE_SAMPLE_NODES = 1024;
+	// Cell size relative to the average edge length -> few nodes per cell
+	static constexpr double CELL_EDGE_MULTIPLIER = 2.0;
+	static constexpr double DEFAULT_CELL_SIZE = 100.0;
+}
+
+void FSpiderNavSpatialIndex::Build(const TArray<FSpiderNavNode>& Nodes)
+{
+	using namespace SpiderNavSpatialIndexPrivate;
+
+	Reset();
+	if (Nodes.Num() == 0)
+		return;
+
+	double EdgeLength = 0.0;
+	int32 EdgeCount = 0;
+	for (int32 i = 0; i < Nodes.Num() && i < EDGE_SAMPLE_NODES; ++i)
+	{
+		for (const FSpiderNavNode* Neighbor : Nodes[i].Neighbors)
+		{
+			EdgeLength += FVector::Dist(Nodes[i].Location, Neighbor->Location);
+			++EdgeCount;
+		}
+	}
+	CellSize = EdgeCount > 0 ? FMath::Max(1.0, CELL_EDGE_MULTIPLIER * EdgeLength / EdgeCount) : DEFAULT_CELL_SIZE;
+
+	// Count, assign offsets, then sort in -> one contiguous array instead of a list per cell
+	TArray<FIntVector> NodeCells;
+	NodeCells.SetNumUninitialized(Nodes.Num());
+	MinCell = FIntVector(MAX_int32);
+	MaxCell = FIntVector(MIN_int32);
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		const FIntVector Cell = GetCell(Nodes[i].Location);
+		NodeCells[i] = Cell;
+		MinCell = FIntVector(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y), FMath::Min(MinCell.Z, Cell.Z));
+		MaxCell = FIntVector(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y), FMath::Max(MaxCell.Z, Cell.Z));
+		++Cells.FindOrAdd(Cell).Num;
+	}
+
+	int32 Offset = 0;
+	for (TPair<FIntVector, FCell>& Pair : Cells)
+	{
+		Pair.Value.Start = Offset;
+		Offset += Pair.Value.Num;
+		Pair.Value.Num = 0;
+	}
+
+	CellNodes.SetNumUninitialized(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		FCell& Cell = Cells.FindChecked(NodeCells[i]);
+		CellNodes[Cell.Start + Cell.Num++] = i;
+	}
+}
+
+void FSpiderNavSpatialIndex::Reset()
+{
+	Cells.Reset();
+	CellNodes.Reset();
+	MinCell = MaxCell = FIntVector::ZeroValue;
+}
+
+FIntVector FSpiderNavSpatialIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void FSpiderNavSpatialIndex::ForEachInBox(const FBox& Box, TFunctionRef<void(int32 NodeIndex)> Visit) const
+{
+	if (Cells.Num() == 0 || !Box.IsValid)
+		return;
+
+	const FIntVector Min = GetCell(Box.Min);
+	const FIntVector Max = GetCell(Box.Max);
+	for (int32 X = FMath::Max(Min.X, MinCell.X); X <= FMath::Min(Max.X, MaxCell.X); ++X)
+	{
+		for (int32 Y = FMath::Max(Min.Y, MinCell.Y); Y <= FMath::Min(Max.Y, MaxCell.Y); ++Y)
+		{
+			for (int32 Z = FMath::Max(Min.Z, MinCell.Z); Z <= FMath::Min(Max.Z, MaxCell.Z); ++Z)
+			{
+				if (const FCell* Cell = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (int32 i = Cell->Start; i < Cell->Start + Cell->Num; ++i)
+						Visit(CellNodes[i]);
+				}
+			}
+		}
+	}
+}
+
+int32 FSpiderNavSpatialIndex::FindClosest(const TArray<FSpiderNavNode>& Nodes, const FVector& Location, int32 ComponentId) const
+{
+	if (Cells.Num() == 0)
+		return INDEX_NONE;
+
+	const FIntVector Center = GetCell(Location);
+
+	int32 Best = INDEX_NONE;
+	double BestDistSq = TNumericLimits<double>::Max();
+
+	auto VisitCell = [&](int32 X, int32 Y, int32 Z)
+		{
+			const FCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+			if (!Cell)
+				return;
+
+			for (int32 i = Cell->Start; i < Cell->Start + Cell->Num; ++i)
+			{
+				const int32 NodeIndex = CellNodes[i];
+				const FSpiderNavNode& Node = Nodes[NodeIndex];
+				if (ComponentId != INDEX_NONE && Node.ComponentId != ComponentId)
+					continue;
+
+				// On a tie the smaller index wins, as in the linear scan
+				const double DistSq = FVector::DistSquared(Node.Location, Location);
+				if (DistSq < BestDistSq || (DistSq == BestDistSq && NodeIndex < Best))
+				{
+					BestDistSq = DistSq;
+					Best = NodeIndex;
+				}
+			}
+		};
+
+	// Skip rings outside the occupied cells
+	auto Gap = [](int32 C, int32 Min, int32 Max) { return C < Min ? Min - C : (C > Max ? C - Max : 0); };
+	auto Far = [](int32 C, int32 Min, int32 Max) { return FMath::Max(FMath::Abs(C - Min), FMath::Abs(C - Max)); };
+	const int32 FirstRing = FMath::Max3(Gap(Center.X, MinCell.X, MaxCell.X), Gap(Center.Y, MinCell.Y, MaxCell.Y), Gap(Center.Z, MinCell.Z, MaxCell.Z));
+	const int32 LastRing = FMath::Max3(Far(Center.X, MinCell.X, MaxCell.X), Far(Center.Y, MinCell.Y, MaxCell.Y), Far(Center.Z, MinCell.Z, MaxCell.Z));
+
+	for (int32 Ring = FirstRing; Ring <= LastRing; ++Ring)
+	{
+		const int32 X0 = FMath::Max(Center.X - Ring, MinCell.X), X1 = FMath::Min(Center.X + Ring, MaxCell.X);
+		const int32 Y0 = FMath::Max(Center.Y - Ring, MinCell.Y), Y1 = FMath::Min(Center.Y + Ring, MaxCell.Y);
+		const int32 Z0 = FMath::Max(Center.Z - Ring, MinCell.Z), Z1 = FMath::Min(Center.Z + Ring, MaxCell.Z);
+
+		for (int32 X = X0; X <= X1; ++X)
+		{
+			for (int32 Y = Y0; Y <= Y1; ++Y)
+			{
+				// Only the shell of the cube, the inside was visited in earlier rings
+				if (FMath::Abs(X - Center.X) == Ring || FMath::Abs(Y - Center.Y) == Ring)
+				{
+					for (int32 Z = Z0; Z <= Z1; ++Z)
+						VisitCell(X, Y, Z);
+				}
+				else
+				{
+					if (Center.Z - Ring >= MinCell.Z)
+						VisitCell(X, Y, Center.Z - Ring);
+					if (Center.Z + Ring <= MaxCell.Z)
+						VisitCell(X, Y, Center.Z + Ring);
+				}
+			}
+		}
+
+		// All later rings are at least Ring * CellSize away
+		if (Best != INDEX_NONE && BestDistSq < FMath::Square(Ring * CellSize))
+			break;
+	}
+
+	return Best;
+}
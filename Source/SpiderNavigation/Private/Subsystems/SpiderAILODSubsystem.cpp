@@ -0,0 +1,214 @@
+// Copyright Yves Tanas 2025
+
+
+#include "Subsystems/SpiderAILODSubsystem.h"
+
+#include "Controllers/SpiderAIController.h"
+#include "SignificanceManager.h"
+#include "SpiderNavigationStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+static TAutoConsoleVariable<int32> CVarSpiderLODEnable(
+	TEXT("spider.LOD.Enable"),
+	1,
+	TEXT("Significance-based LOD of spider controllers. 0 keeps every spider at Full"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSpiderLODUpdateViewpoints(
+	TEXT("spider.LOD.UpdateViewpoints"),
+	1,
+	TEXT("Update the significance manager with the player viewpoints every frame. 0 if the game already updates it"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSpiderLODCoarseInterval(
+	TEXT("spider.LOD.CoarseInterval"),
+	0.25f,
+	TEXT("Seconds between two updates of a coarse spider"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSpiderLODCoarseBudget(
+	TEXT("spider.LOD.CoarseBudget"),
+	64,
+	TEXT("Coarse spiders updated per frame at most"),
+	ECVF_Default);
+
+static const FName SPIDER_AI_SIGNIFICANCE_TAG(TEXT("SpiderAI"));
+
+bool USpiderAILODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USpiderAILODSubsystem::Deinitialize()
+{
+	if (USignificanceManager* Significance = USignificanceManager::Get(GetWorld()))
+	{
+		Significance->UnregisterAll(SPIDER_AI_SIGNIFICANCE_TAG);
+	}
+	Controllers.Reset();
+	CoarseControllers.Reset();
+	Super::Deinitialize();
+}
+
+void USpiderAILODSubsystem::RegisterController(ASpiderAIController* Controller)
+{
+	if (!Controller || Controllers.Contains(Controller))
+		return;
+
+	USignificanceManager* Significance = USignificanceManager::Get(GetWorld());
+	if (!Significance)
+	{
+		// No manager (e.g. disabled on the client) -> the spider stays Full
+		return;
+	}
+
+	Controllers.Add(Controller);
+
+	// Scoring runs in parallel and only reads; applying is sequential on the game thread
+	Significance->RegisterObject(Controller, SPIDER_AI_SIGNIFICANCE_TAG,
+		[](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+		{
+			const ASpiderAIController* SpiderController = Cast<ASpiderAIController>(Info->GetObject());
+			return SpiderController ? SpiderController->CalculateSignificance(Viewpoint) : 0.f;
+		},
+		USignificanceManager::EPostSignificanceType::Sequential,
+		[this](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float Significance, bool bFinal)
+		{
+			ASpiderAIController* SpiderController = Cast<ASpiderAIController>(Info->GetObject());
+			if (bLODActive && SpiderController)
+			{
+				SpiderController->SetLOD(static_cast<ESpiderLOD>(FMath::Clamp(FMath::RoundToInt(Significance), 0, 2)));
+			}
+		});
+}
+
+void USpiderAILODSubsystem::UnregisterController(ASpiderAIController* Controller)
+{
+	if (Controllers.Remove(Controller) == 0)
+		return;
+
+	if (USignificanceManager* Significance = USignificanceManager::Get(GetWorld()))
+	{
+		Significance->UnregisterObject(Controller);
+	}
+	SetCoarse(Controller, false);
+}
+
+void USpiderAILODSubsystem::SetCoarse(ASpiderAIController* Controller, bool bCoarse)
+{
+	const int32 Index = CoarseControllers.IndexOfByPredicate([Controller](const FCoarseEntry& Entry) { return Entry.Controller.Get() == Controller; });
+	if (bCoarse && Index == INDEX_NONE)
+	{
+		CoarseControllers.Add({ Controller, GetWorld()->GetTimeSeconds() });
+	}
+	else if (!bCoarse && Index != INDEX_NONE)
+	{
+		CoarseControllers.RemoveAtSwap(Index);
+	}
+	SET_DWORD_STAT(STAT_SpiderNav_CoarseAgents, CoarseControllers.Num());
+}
+
+void USpiderAILODSubsystem::Tick(float DeltaTime)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_LOD);
+
+	if (CVarSpiderLODEnable.GetValueOnGameThread() == 0)
+	{
+		if (bLODActive)
+		{
+			RestoreFullLOD();
+		}
+		return;
+	}
+	bLODActive = true;
+
+	if (CVarSpiderLODUpdateViewpoints.GetValueOnGameThread() != 0)
+	{
+		UpdateSignificance();
+	}
+	UpdateCoarse();
+}
+
+void USpiderAILODSubsystem::UpdateSignificance()
+{
+	USignificanceManager* Significance = USignificanceManager::Get(GetWorld());
+	if (!Significance)
+		return;
+
+	// All players on the server, so remote clients do not see their spiders coarse
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PC = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PC->GetPlayerViewPoint(Location, Rotation);
+			Viewpoints.Emplace(Rotation, Location);
+		}
+	}
+
+	// Without a viewpoint the last LODs stay
+	if (Viewpoints.Num() > 0)
+	{
+		Significance->Update(Viewpoints);
+	}
+}
+
+void USpiderAILODSubsystem::UpdateCoarse()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double Interval = FMath::Max(0.f, CVarSpiderLODCoarseInterval.GetValueOnGameThread());
+	int32 Budget = FMath::Max(1, CVarSpiderLODCoarseBudget.GetValueOnGameThread());
+
+	// At most one round from the cursor, due entries up to the budget; the rest go first next frame
+	for (int32 Checked = 0; Checked < CoarseControllers.Num() && Budget > 0; ++Checked)
+	{
+		if (CoarseCursor >= CoarseControllers.Num())
+			CoarseCursor = 0;
+
+		FCoarseEntry& Entry = CoarseControllers[CoarseCursor];
+		ASpiderAIController* Controller = Entry.Controller.Get();
+		if (!Controller)
+		{
+			CoarseControllers.RemoveAtSwap(CoarseCursor);
+			continue;
+		}
+		++CoarseCursor;
+
+		const double Elapsed = Now - Entry.LastUpdateTime;
+		if (Elapsed < Interval)
+			continue;
+
+		Entry.LastUpdateTime = Now;
+		--Budget;
+		INC_DWORD_STAT(STAT_SpiderNav_CoarseUpdates);
+
+		// May fire MoveCompleted and end the controller -> do not use Entry afterwards
+		Controller->TickCoarse(static_cast<float>(Elapsed));
+	}
+}
+
+void USpiderAILODSubsystem::RestoreFullLOD()
+{
+	bLODActive = false;
+	for (const TWeakObjectPtr<ASpiderAIController>& Controller : Controllers)
+	{
+		if (Controller.IsValid())
+		{
+			Controller->SetLOD(ESpiderLOD::Full);
+		}
+	}
+}
+
+bool USpiderAILODSubsystem::IsTickable() const
+{
+	return Controllers.Num() > 0;
+}
+
+TStatId USpiderAILODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpiderAILODSubsystem, STATGROUP_Tickables);
+}
@@ -6,8 +6,27 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "SaveGame/SpiderNavGridSaveGame.h"
+#include "Components/NavGridComponent.h"
+#include "SpiderNavigationStats.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY(SpiderNAVSubsystem_LOG);
+
+static TAutoConsoleVariable<int32> CVarSpiderFlowFieldBudget(
+	TEXT("spider.FlowField.Budget"),
+	20000,
+	TEXT("Node expansions per frame shared by all flow field builds"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSpiderPathCacheCapacity(
+	TEXT("spider.PathCache.Capacity"),
+	256,
+	TEXT("Paths cached per navigation grid (LRU). 0 disables the path cache"),
+	ECVF_Default);
+
+// Keep fields without queries this long
+static constexpr double FLOW_FIELD_TIMEOUT = 5.0;
+
 void USpiderNavigationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -15,43 +34,67 @@ void USpiderNavigationSubsystem::Initialize(FSubsystemCollectionBase& Collection
 
 void USpiderNavigationSubsystem::Deinitialize()
 {
+	FlowFields.Reset();
+	PathCaches.Reset();
 	Super::Deinitialize();
 }
 
 FSavedSpiderNavGrid USpiderNavigationSubsystem::LoadGrid(FString GridSaveName, int32 GridIndex)
 {
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_LoadGrid);
+
 	UE_LOG(SpiderNAVSubsystem_LOG, Log, TEXT("Start loading Spider nav data"));
 
-	FVector* NormalRef = NULL;
-	FVector Normal;
 	FSavedSpiderNavGrid SavedGrid;
 
 	USpiderNavGridSaveGame* LoadGameInstance = Cast<USpiderNavGridSaveGame>(UGameplayStatics::CreateSaveGameObject(USpiderNavGridSaveGame::StaticClass()));
 	LoadGameInstance = Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromSlot(LoadGameInstance->SaveSlotName, LoadGameInstance->UserIndex));
 	if (LoadGameInstance) {
 		UE_LOG(SpiderNAVSubsystem_LOG, Log, TEXT("After getting load game instance"));
-		for (auto It = LoadGameInstance->NavLocations.CreateConstIterator(); It; ++It) {
-			NormalRef = LoadGameInstance->NavNormals.Find(It.Key());
-			if (NormalRef) {
-				Normal = *NormalRef;
-			}
-			else {
-				Normal = FVector(0.0f, 0.0f, 1.0f);
-			}
-			AddGridNode(SavedGrid, It.Key(), It.Value(), Normal);
-		}
-		UE_LOG(SpiderNAVSubsystem_LOG, Log, TEXT("After setting locations"));
-
-		for (auto It = LoadGameInstance->NavRelations.CreateConstIterator(); It; ++It) {
-			SetGridNodeNeighbors(SavedGrid, It.Key(), It.Value().Neighbors);
-		}
-		UE_LOG(SpiderNAVSubsystem_LOG, Log, TEXT("After setting relations"));
-
+		BuildGrid(LoadGameInstance, SavedGrid);
 		UE_LOG(SpiderNAVSubsystem_LOG, Log, TEXT("Nav Nodes Loaded: %d"), SavedGrid.GetNavNodesCount());
 	}
 	return SavedGrid;
 }
 
+void USpiderNavigationSubsystem::BuildGrid(const USpiderNavGridSaveGame* SaveGame, FSavedSpiderNavGrid& OutGrid)
+{
+	OutGrid = FSavedSpiderNavGrid();
+	if (!SaveGame)
+		return;
+
+	// Create all nodes first -> Neighbor pointers stay valid
+	OutGrid.NavNodes.Reserve(SaveGame->NavLocations.Num());
+	OutGrid.NodesSavedIndexes.Reserve(SaveGame->NavLocations.Num());
+	for (auto It = SaveGame->NavLocations.CreateConstIterator(); It; ++It) {
+		const FVector* NormalRef = SaveGame->NavNormals.Find(It.Key());
+		AddGridNode(OutGrid, It.Key(), It.Value(), NormalRef ? *NormalRef : FVector(0.0f, 0.0f, 1.0f));
+	}
+
+	for (auto It = SaveGame->NavRelations.CreateConstIterator(); It; ++It) {
+		SetGridNodeNeighbors(OutGrid, It.Key(), It.Value().Neighbors);
+	}
+}
+
+USpiderNavGridSaveGame* USpiderNavigationSubsystem::CreateSaveGame(const FSavedSpiderNavGrid& Grid)
+{
+	USpiderNavGridSaveGame* SaveGame = Cast<USpiderNavGridSaveGame>(UGameplayStatics::CreateSaveGameObject(USpiderNavGridSaveGame::StaticClass()));
+	if (!SaveGame)
+		return nullptr;
+
+	for (const FSpiderNavNode& Node : Grid.NavNodes) {
+		SaveGame->NavLocations.Add(Node.Index, Node.Location);
+		SaveGame->NavNormals.Add(Node.Index, Node.Normal);
+
+		FSpiderNavRelations& Relations = SaveGame->NavRelations.Add(Node.Index);
+		Relations.Neighbors.Reserve(Node.Neighbors.Num());
+		for (const FSpiderNavNode* Neighbor : Node.Neighbors) {
+			Relations.Neighbors.Add(Neighbor->Index);
+		}
+	}
+	return SaveGame;
+}
+
 void USpiderNavigationSubsystem::AddGridNode(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, FVector Location, FVector Normal)
 {
 	FSpiderNavNode NavNode;
@@ -64,11 +107,12 @@ void USpiderNavigationSubsystem::AddGridNode(FSavedSpiderNavGrid& SavedGrid, int
 	SavedGrid.NodesSavedIndexes.Add(SavedIndex, Index);
 }
 
-void USpiderNavigationSubsystem::SetGridNodeNeighbors(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, TArray<int32> NeighborsSavedIndexes)
+void USpiderNavigationSubsystem::SetGridNodeNeighbors(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, const TArray<int32>& NeighborsSavedIndexes)
 {
 	int32* Index = SavedGrid.NodesSavedIndexes.Find(SavedIndex);
 	if (Index) {
 		FSpiderNavNode* NavNode = &(SavedGrid.NavNodes[*Index]);
+		NavNode->Neighbors.Reserve(NeighborsSavedIndexes.Num());
 		for (int32 i = 0; i != NeighborsSavedIndexes.Num(); ++i) {
 			int32* NeighborIndex = SavedGrid.NodesSavedIndexes.Find(NeighborsSavedIndexes[i]);
 			if (NeighborIndex) {
@@ -79,3 +123,138 @@ void USpiderNavigationSubsystem::SetGridNodeNeighbors(FSavedSpiderNavGrid& Saved
 	}
 }
 
+bool USpiderNavigationSubsystem::FindFlowFieldPath(UNavGridComponent* NavGrid, const AActor* Target, const FVector& From, FSpiderNavPathResult& OutPath, int32 MaxPoints)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FindFlowFieldPath);
+
+	OutPath.Reset();
+	if (!NavGrid || !Target)
+		return false;
+
+	FSpiderNavFlowFieldEntry& Entry = FlowFields.FindOrAdd(Target);
+	if (Entry.NavGrid.Get() != NavGrid) {
+		Entry = FSpiderNavFlowFieldEntry();
+		Entry.NavGrid = NavGrid;
+		Entry.Target = Target;
+		Entry.GridLayoutVersion = NavGrid->GetGridLayoutVersion();
+	}
+	Entry.LastUsedTime = FPlatformTime::Seconds();
+	ValidateFlowField(Entry, *NavGrid);
+
+	const FSavedSpiderNavGrid& Grid = NavGrid->GetLoadedGrid();
+	const int32 FromNode = Grid.FindClosestNodeIndex(From);
+	if (FromNode == INDEX_NONE)
+		return false;
+
+	// O(1) per step, no search
+	if (!Entry.Field.Follow(Grid, NavGrid->GetObstacles(), FromNode, MaxPoints, OutPath.NodeIndices)) {
+		OutPath.Reset();
+		return false;
+	}
+
+	OutPath.bComplete = OutPath.NodeIndices.Last() == Entry.Field.GetTarget();
+	OutPath.FillFromIndices(Grid);
+	return true;
+}
+
+const FSpiderNavFlowField* USpiderNavigationSubsystem::GetFlowField(const AActor* Target) const
+{
+	const FSpiderNavFlowFieldEntry* Entry = FlowFields.Find(Target);
+	return Entry ? &Entry->Field : nullptr;
+}
+
+int32 USpiderNavigationSubsystem::FindFlowFieldNextEdge(const UNavGridComponent* NavGrid, int32 Node, int32 GoalNode)
+{
+	if (!NavGrid)
+		return INDEX_NONE;
+
+	// few fields (one per followed actor), linear is enough
+	for (TPair<FObjectKey, FSpiderNavFlowFieldEntry>& Pair : FlowFields) {
+		FSpiderNavFlowFieldEntry& Entry = Pair.Value;
+		if (Entry.NavGrid.Get() != NavGrid)
+			continue;
+
+		ValidateFlowField(Entry, *NavGrid);
+		if (Entry.Field.IsReady() && Entry.Field.GetTarget() == GoalNode) {
+			return Entry.Field.GetNextEdge(Node);
+		}
+	}
+	return INDEX_NONE;
+}
+
+void USpiderNavigationSubsystem::ValidateFlowField(FSpiderNavFlowFieldEntry& Entry, const UNavGridComponent& NavGrid)
+{
+	// Edge indices of a field are only meaningful in the CSR layout it was built on
+	if (Entry.GridLayoutVersion != NavGrid.GetGridLayoutVersion()) {
+		UE_LOG(SpiderNAVSubsystem_LOG, VeryVerbose, TEXT("Flow field for %s dropped, grid was replaced"), *GetNameSafe(Entry.Target.Get()));
+		Entry.Field.Reset();
+		Entry.GridLayoutVersion = NavGrid.GetGridLayoutVersion();
+	}
+}
+
+FSpiderNavPathCache* USpiderNavigationSubsystem::GetPathCache(const UNavGridComponent* NavGrid)
+{
+	const int32 Capacity = CVarSpiderPathCacheCapacity.GetValueOnGameThread();
+	if (!NavGrid || Capacity <= 0)
+		return nullptr;
+
+	FSpiderNavPathCache& Cache = PathCaches.FindOrAdd(NavGrid);
+	Cache.SetCapacity(Capacity);
+	return &Cache;
+}
+
+void USpiderNavigationSubsystem::ReleasePathCache(const UNavGridComponent* NavGrid)
+{
+	PathCaches.Remove(NavGrid);
+}
+
+float USpiderNavigationSubsystem::GetPathCacheHitRate(const UNavGridComponent* NavGrid) const
+{
+	const FSpiderNavPathCache* Cache = PathCaches.Find(NavGrid);
+	return Cache ? Cache->GetHitRate() : 0.f;
+}
+
+void USpiderNavigationSubsystem::Tick(float DeltaTime)
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNav_FlowFields);
+
+	const double Now = FPlatformTime::Seconds();
+	int32 Budget = FMath::Max(1, CVarSpiderFlowFieldBudget.GetValueOnGameThread());
+
+	for (auto It = FlowFields.CreateIterator(); It; ++It) {
+		FSpiderNavFlowFieldEntry& Entry = It.Value();
+		UNavGridComponent* NavGrid = Entry.NavGrid.Get();
+		const AActor* Target = Entry.Target.Get();
+		if (!NavGrid || !Target || Now - Entry.LastUsedTime > FLOW_FIELD_TIMEOUT) {
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FSavedSpiderNavGrid& Grid = NavGrid->GetLoadedGrid();
+		ValidateFlowField(Entry, *NavGrid);
+
+		// A running build is finished, otherwise a goal that changes node every frame would never arrive
+		if (!Entry.Field.IsBuilding()) {
+			const int32 TargetNode = Grid.FindClosestNodeIndex(Target->GetActorLocation());
+			if (TargetNode != INDEX_NONE && (TargetNode != Entry.Field.GetTarget() || Entry.GridVersion != NavGrid->GetGridVersion())) {
+				Entry.Field.Start(Grid, TargetNode);
+				Entry.BuildGridVersion = NavGrid->GetGridVersion();
+			}
+		}
+
+		if (Budget > 0 && Entry.Field.IsBuilding() && Entry.Field.Step(Grid, NavGrid->GetObstacles(), Budget)) {
+			Entry.GridVersion = Entry.BuildGridVersion;
+			UE_LOG(SpiderNAVSubsystem_LOG, VeryVerbose, TEXT("Flow field for %s published, target node %d"), *GetNameSafe(Target), Entry.Field.GetTarget());
+		}
+	}
+}
+
+bool USpiderNavigationSubsystem::IsTickable() const
+{
+	return FlowFields.Num() > 0 && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId USpiderNavigationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpiderNavigationSubsystem, STATGROUP_Tickables);
+}
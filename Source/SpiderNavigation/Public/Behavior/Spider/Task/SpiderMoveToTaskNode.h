@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTTaskNode.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "Structs/SpiderNavQueryParams.h"
 #include "SpiderMoveToTaskNode.generated.h"
 
 /**
@@ -19,6 +20,13 @@ public:
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Value Check", meta = (ExposeOnSpawn = true))
 	FBlackboardKeySelector TargetLocation;
+
+	/** Search options for this move (Spider AI controllers only), e.g. Weighted for wandering */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+	bool bOverrideQueryParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation", meta = (EditCondition = "bOverrideQueryParams"))
+	FSpiderNavQueryParams QueryParams;
 protected:
 	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
@@ -0,0 +1,56 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Structs/SavedSpiderNavGrid.h"
+
+enum class ESpiderNavSyntheticShape : uint8
+{
+	/** Surface of randomly carved tunnels and chambers */
+	Caves,
+	/** Floors stacked on top of each other, connected by walls */
+	StackedFloors,
+	/** Rows of rooms with floors, walls, ceilings and doorways */
+	CubeRooms,
+	/** Uniform random points linked within a radius */
+	RandomGeometric,
+	Num
+};
+
+struct FSpiderNavSyntheticGridParams
+{
+	ESpiderNavSyntheticShape Shape = ESpiderNavSyntheticShape::StackedFloors;
+
+	/** Approximate node count; generators stop at or slightly above it */
+	int32 TargetNodes = 10000;
+
+	/** Lattice spacing, same meaning as the builder's GridStepSize */
+	float Step = 40.f;
+
+	int32 Seed = 1;
+};
+
+/**
+ * Generates navigation grids without a level, straight as FSavedSpiderNavGrid.
+ * Used by the benchmark and validation commandlets; output is deterministic per seed.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavSyntheticGrid
+{
+	static void Generate(const FSpiderNavSyntheticGridParams& Params, FSavedSpiderNavGrid& OutGrid);
+
+	static const TCHAR* GetShapeName(ESpiderNavSyntheticShape Shape);
+	static bool ParseShape(const FString& Name, ESpiderNavSyntheticShape& OutShape);
+
+	/** Number of directed neighbor links */
+	static int64 CountEdges(const FSavedSpiderNavGrid& Grid);
+
+private:
+	static void GenerateCaves(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals);
+	static void GenerateStackedFloors(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals);
+	static void GenerateCubeRooms(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals);
+	static void GenerateRandomGeometric(const FSpiderNavSyntheticGridParams& Params, TArray<FVector>& Locations, TArray<FVector>& Normals, float& OutRadius);
+
+	/** Links every pair closer than Radius and fills OutGrid */
+	static void Link(const TArray<FVector>& Locations, const TArray<FVector>& Normals, float Radius, FSavedSpiderNavGrid& OutGrid);
+};
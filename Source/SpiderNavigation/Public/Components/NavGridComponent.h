@@ -3,15 +3,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include <algorithm>
-#include <vector>         // std::vector
 #include "Components/ActorComponent.h"
 #include "Structs/SavedSpiderNavGrid.h"
+#include "Structs/SpiderNavObstacleLayer.h"
+#include "Planning/SpiderNavIncrementalPlanner.h"
+#include "Planning/SpiderNavBidirectionalSearch.h"
+#include "Planning/SpiderNavAnytimeSearch.h"
+#include "Planning/SpiderNavBatchSearch.h"
+#include "Structs/SpiderNavQueryParams.h"
+#include "Structs/SpiderNavPathResult.h"
 #include "Interfaces/SpiderNavigationInterface.h"
 #include "NavGridComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(NavGridComponent_LOG, Log, All);
 
+/** Counters of the last search, for validation and benchmarks */
+struct FSpiderNavSearchStats
+{
+	int32 Expansions = 0;
+	int32 OpenListPeak = 0;
+	bool bComplete = false;
+};
+
+/** Grid version after the change and the world bounds of all nodes and edges that changed blocking state */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSpiderNavGridChanged, uint32 /*GridVersion*/, const FBox& /*ChangedBounds*/);
+
 UCLASS(BlueprintType, Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SPIDERNAVIGATION_API UNavGridComponent : public UActorComponent, public ISpiderNavigationInterface
 {
@@ -24,7 +40,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
 	TArray<FVector> FindPath(FVector Start, FVector End, bool& bFoundCompletePath);
 
-	/** Draws debug lines between connected nodes */
+	/** FindPath with per-query options, e.g. the search mode */
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
+	TArray<FVector> FindPathWithParams(FVector Start, FVector End, const FSpiderNavQueryParams& Params, bool& bFoundCompletePath);
+
+	/**
+	 * FindPathWithParams into a caller-owned result with node indices, normals and costs. Reuse OutResult between
+	 * queries: it is reset, not reallocated. Returns false if there is no path at all (OutResult.bComplete for partial paths)
+	 */
+	bool FindPathInto(const FVector& Start, const FVector& End, const FSpiderNavQueryParams& Params, FSpiderNavPathResult& OutResult);
+
+	/**
+	 * Many queries at once, e.g. for a wave spawn. Closest nodes are looked up in one parallel pass, queries sharing a goal
+	 * node become one reverse search and the remaining searches run in parallel on worker threads.
+	 * OutResults[i] belongs to Queries[i]; keep the array between batches to reuse its buffers
+	 */
+	void FindPathsBatch(TConstArrayView<FSpiderNavPathQuery> Queries, const FSpiderNavQueryParams& Params, TArray<FSpiderNavPathResult>& OutResults);
+
+	/**
+	 * Like FindPath, but reuses the search tree of a per-agent planner between calls, e.g. while following a moving target.
+	 * Grid changes since the planner's last call are applied incrementally as long as they are still in the change history
+	 */
+	TArray<FVector> FindPathIncremental(FSpiderNavIncrementalPlanner& Planner, FVector Start, FVector End, bool& bFoundCompletePath);
+	bool FindPathIncremental(FSpiderNavIncrementalPlanner& Planner, const FVector& Start, const FVector& End, FSpiderNavPathResult& OutResult);
+
+	/** Draws debug lines between connected nodes. For large grids add a USpiderNavGridVisualizerComponent instead */
 	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
 	void DrawDebugRelations();
 
@@ -36,31 +76,108 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
 	FVector FindClosestNodeNormal(FVector Location);
 
-	/** Finds path between current location and target location and returns location and normal of the next fisrt node in navigation grid */
+	/**
+	 * Location and normal of the next node on the way from the current to the target location. Meant for per-tick steering:
+	 * answered from the path cache (also while walking along a cached path) or a shared flow field, searches only if neither knows the way
+	 */
 	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
 	bool FindNextLocationAndNormal(FVector CurrentLocation, FVector TargetLocation, FVector& NextLocation, FVector& Normal);
 
+	/** Next node index from StartNode towards GoalNode as in FindNextLocationAndNormal, INDEX_NONE if there is none */
+	int32 FindNextHop(int32 StartNode, int32 GoalNode);
+
+	/** Replaces the loaded grid, e.g. with a generated one. Neighbor pointers stay valid because the node array is moved */
+	void SetGrid(FSavedSpiderNavGrid&& Grid);
+
+	const FSavedSpiderNavGrid& GetLoadedGrid() const { return LoadedGrid; }
+
+	const FSpiderNavSearchStats& GetLastSearchStats() const { return LastSearchStats; }
+
+	const FSpiderNavQueryParams& GetDefaultQueryParams() const { return DefaultQueryParams; }
+
+	/** Blocks nodes inside and edges crossing the oriented box until RemoveObstacle. Calling again moves the obstacle incrementally */
+	void UpdateObstacle(const UObject* Obstacle, const FTransform& Transform, const FVector& Extent);
+	void RemoveObstacle(const UObject* Obstacle);
+
+	const FSpiderNavObstacleLayer& GetObstacles() const { return Obstacles; }
+
+	/** Incremented whenever the grid or its blocking changes */
+	uint32 GetGridVersion() const { return GridVersion; }
+
+	/** Incremented only when SetGrid replaces nodes and edges. Node and CSR edge indices stay valid while it is unchanged */
+	uint32 GetGridLayoutVersion() const { return GridLayoutVersion; }
+
+	/** Broadcast after obstacles changed the blocking of nodes or edges */
+	FOnSpiderNavGridChanged OnGridChanged;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	void LoadGrid();
 
 
-	void ResetGridMetrics();
-	TArray<FVector> BuildPathFromEndNode(FSpiderNavNode* EndNode);
+	/** Surface multipliers plus all ASpiderNavCostModifierVolume in the world */
+	FSpiderNavCostSettings MakeCostSettings() const;
 
 	FSpiderNavNode* FindClosestNode(FVector Location);
 
-	TArray<FSpiderNavNode*> FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode, bool& bFoundCompletePath);
-	TArray<FSpiderNavNode*> BuildNodesPathFromEndNode(FSpiderNavNode* EndNode);
+	/** Searches StartNode -> EndNode into OutResult (indices, locations, normals, costs), without smoothing */
+	void FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode, const FSpiderNavQueryParams& Params, FSpiderNavPathResult& OutResult);
+
+	/** Cache of the navigation subsystem for this grid, nullptr without game instance or if disabled */
+	struct FSpiderNavPathCache* GetPathCache() const;
+
+	/** Stores LastSearchStats and feeds STATGROUP_SpiderNav after a search */
+	void ReportSearch(int32 Expansions, int32 OpenListPeak, const FSpiderNavPathResult& Path);
+
+	FSpiderNavSearchStats LastSearchStats;
+
+	/** Result buffer of the queries returning TArray<FVector>, reused between calls */
+	FSpiderNavPathResult QueryResult;
+
+	FSpiderNavObstacleLayer Obstacles;
+	uint32 GridVersion = 0;
+	uint32 GridLayoutVersion = 0;
+
+	/** Scratch state of the single-path searches (Bidirectional; AStar, Weighted and Anytime), kept between queries */
+	FSpiderNavBidirectionalSearch BidirectionalSearch;
+	FSpiderNavAnytimeSearch AnytimeSearch;
+
+	/** FindPathsBatch: worker scratch and per-query node indices, kept between batches */
+	FSpiderNavBatchSearch BatchSearch;
+	TArray<int32> BatchStarts;
+	TArray<int32> BatchEnds;
+	TArray<int32> BatchGoals;
+	TArray<int32> BatchPending;
+	TArray<int32> BatchExpansions;
+	TArray<int32> BatchOpenListPeaks;
+
+	/** Recent (GridVersion, ChangedBounds) pairs, oldest first, so incremental planners can catch up. Cleared by SetGrid */
+	TArray<TPair<uint32, FBox>> GridChanges;
+	void RecordGridChange(const FBox& ChangedBounds);
 
-	TArray<FSpiderNavNode*> OpenList;
-	FSpiderNavNode* GetFromOpenList();
 protected:
 	/** Whether to load the navigation grid on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation")
 	bool bAutoLoadGrid;
 
+	/** Options of queries without explicit params (FindPath, FindPathBetweenPoints). FindNextLocationAndNormal always searches with AStar so its paths are cached */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation")
+	FSpiderNavQueryParams DefaultQueryParams;
+
+	/** Smoothing (FSpiderNavQueryParams::bSmoothPath): max angle between the anchor's normal and the nodes of a shortcut */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation|Smoothing", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float SmoothingMaxNormalAngle;
+
+	/** Smoothing: how far a shortcut's end node and the nodes supporting it may lie from the anchor's plane */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation|Smoothing", meta = (ClampMin = "0.0"))
+	float SmoothingTolerance;
+
+	/** Reuse paths of identical queries and suffixes of cached paths to the same goal. Capacity: spider.PathCache.Capacity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation")
+	bool bUsePathCache;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Spider Navigation|Save")
 	FString SaveGameName;
 	UPROPERTY(EditDefaultsOnly, Category = "Spider Navigation|Save")
@@ -69,6 +186,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Spider Navigation|Save")
 	FSavedSpiderNavGrid LoadedGrid;
 
+	/** Cost per unit of distance for nodes on walls. Applied when the grid is set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation|Costs", meta = (ClampMin = "0.01"))
+	float WallCostMultiplier;
+
+	/** Cost per unit of distance for nodes on ceilings, e.g. above 1 to prefer floors and walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation|Costs", meta = (ClampMin = "0.01"))
+	float CeilingCostMultiplier;
+
 	/** Thickness of debug lines */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavGridBuilder")
 	float DebugLinesThickness;
@@ -81,6 +206,4 @@ private:
 	virtual TArray<FVector> FindPathBetweenPoints_Implementation(FVector StartLocation, FVector EndLocation) override;
 	virtual void RegisterSpiderNavGridActor_Implementation(class AActor* SpiderNavGridActor) override;
 	virtual void UnRegisterSpiderNavGridActor_Implementation(class AActor* SpiderNavGridActor) override;
-
-	TArray<FSpiderNavNode*> FindNodesPath(FSpiderNavNode* StartNode, FSpiderNavNode* EndNode);
 };
@@ -0,0 +1,120 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Structs/SavedSpiderNavGrid.h"
+#include "SpiderNavGridVisualizerComponent.generated.h"
+
+class USpiderNavGridSaveGame;
+
+/** Index range of one line batch in FSpiderNavGridRenderData::Indices */
+struct FSpiderNavGridIndexRange
+{
+	uint32 First = 0;
+	/** Two indices per line */
+	uint32 Num = 0;
+};
+
+/** Culling unit: its lines are drawn as a few batches out of the shared buffers */
+struct FSpiderNavGridRenderChunk
+{
+	FBox Bounds = FBox(ForceInit);
+	/** Every edge once */
+	FSpiderNavGridIndexRange Edges;
+	/** Every LodEdgeStride-th edge, drawn beyond LodDistance */
+	FSpiderNavGridIndexRange LodEdges;
+	FSpiderNavGridIndexRange Normals;
+	/** Small axis crosses, only built with bDrawNodes */
+	FSpiderNavGridIndexRange Nodes;
+};
+
+/**
+ * Line list geometry of a whole grid, built once per SetGrid. The scene proxy uploads it into one static vertex
+ * and index buffer when it is created and draws chunk ranges out of them.
+ * Vertices are node locations followed by normal tips and node crosses, all in world space.
+ */
+struct FSpiderNavGridRenderData
+{
+	TArray<FVector3f> Positions;
+	TArray<uint32> Indices;
+	TArray<FSpiderNavGridRenderChunk> Chunks;
+	FBox Bounds = FBox(ForceInit);
+};
+
+/**
+ * Draws a navigation grid through its own scene proxy.
+ * Geometry is chunked once per SetGrid and uploaded to static GPU buffers when the proxy is created (grid change or
+ * property edit), not per frame. Chunks are frustum and distance culled and far chunks only draw a decimated set of edges.
+ * The component stays at the world origin since the vertices are in world space. Replaces DrawDebugRelations for large grids.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent), hidecategories = (Collision, Physics, Object, Lighting, TextureStreaming, Activation, Cooking))
+class SPIDERNAVIGATION_API USpiderNavGridVisualizerComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	USpiderNavGridVisualizerComponent();
+
+	/** Replaces the displayed grid. Geometry is rebuilt and uploaded once */
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation|Visualization")
+	void SetGrid(const FSavedSpiderNavGrid& Grid);
+
+	/** Displays a grid straight from its save game (e.g. in the editor, where no grid is loaded) */
+	void SetGridFromSaveGame(const USpiderNavGridSaveGame* SaveGame);
+
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation|Visualization")
+	void ClearGrid();
+
+	//~ Begin UPrimitiveComponent Interface
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//~ End UPrimitiveComponent Interface
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization")
+	FColor EdgeColor = FColor::Green;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization")
+	FColor NormalColor = FColor::Cyan;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization")
+	FColor NodeColor = FColor::Yellow;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization")
+	bool bDrawNormals = true;
+
+	/** Applied on the next SetGrid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization")
+	bool bDrawNodes = false;
+
+	/** Applied on the next SetGrid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization", meta = (ClampMin = "0"))
+	float NormalLength = 100.f;
+
+	/** Chunks farther away are not drawn at all */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization", meta = (ClampMin = "0"))
+	float MaxDrawDistance = 20000.f;
+
+	/** Chunks farther away draw only every LodEdgeStride-th edge and no normals or nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization", meta = (ClampMin = "0"))
+	float LodDistance = 5000.f;
+
+	/** Applied on the next SetGrid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization", meta = (ClampMin = "1"))
+	int32 LodEdgeStride = 4;
+
+	/** Edge length of the culling chunks. Applied on the next SetGrid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation|Visualization", meta = (ClampMin = "100"))
+	float ChunkSize = 2000.f;
+
+private:
+	void BuildRenderData(const TArray<FVector>& Locations, const TArray<FVector>& Normals, const TArray<FIntPoint>& Edges);
+
+	TSharedPtr<const FSpiderNavGridRenderData, ESPMode::ThreadSafe> RenderData;
+};
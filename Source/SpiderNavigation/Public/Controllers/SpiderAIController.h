@@ -7,10 +7,38 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Interfaces/SpiderAIControllerInterface.h"
+#include "Planning/SpiderNavIncrementalPlanner.h"
+#include "Structs/SpiderNavQueryParams.h"
+#include "Structs/SpiderNavPathResult.h"
+#include "Misc/Optional.h"
 #include "SpiderAIController.generated.h"
 
 class ISpiderNavigationInterface;
 
+/** How FollowTo keeps up with a moving target */
+UENUM(BlueprintType)
+enum class ESpiderFollowMode : uint8
+{
+	/** Full search via MoveTo whenever the target's node changes */
+	Replan,
+	/** Per-agent LPA* tree that is repaired when the target moves or obstacles change. Needs a UNavGridComponent */
+	Incremental,
+	/** Follows the flow field USpiderNavigationSubsystem builds once for all agents chasing the same actor. FollowActor only */
+	FlowField
+};
+
+/** Update fidelity of a spider, set from its significance by USpiderAILODSubsystem. Higher is more significant */
+UENUM(BlueprintType)
+enum class ESpiderLOD : uint8
+{
+	/** Off-screen or distant: no actor tick, hops along the path in batched updates without sweeps or smooth rotation */
+	Coarse,
+	/** Visible at medium distance: full movement at LODReducedTickInterval */
+	Reduced,
+	/** Close to a viewer: full movement every frame */
+	Full
+};
+
 /**
  * Spider AI Controller
  * - Steuert Knotenbasierte Navigation
@@ -36,8 +64,34 @@ public:
 	virtual FVector GetLocation_Implementation() const override;
 	virtual bool MustCheckTargetVisibility_Implementation() const override;
 
+	/** Moves towards a target that keeps moving, e.g. called every tick by a follow task. Uses FollowMode */
+	UFUNCTION(BlueprintCallable, Category = "Spider|Navigation")
+	void FollowTo(const FVector& TargetLocation);
+
+	/** MoveTo with explicit search options for this move and its repaths, e.g. a cheap Weighted search for ambient wandering */
+	UFUNCTION(BlueprintCallable, Category = "Spider|Navigation")
+	void MoveToWithParams(const FVector& Destination, const FSpiderNavQueryParams& Params);
+
+	/** Like FollowTo, but knows the actor so agents chasing the same one can share its flow field */
+	UFUNCTION(BlueprintCallable, Category = "Spider|Navigation")
+	void FollowActor(AActor* Target);
+
+	UFUNCTION(BlueprintPure, Category = "Spider|LOD")
+	ESpiderLOD GetLOD() const { return CurrentLOD; }
+
+	/** Switches tick rate and movement fidelity. Normally set by USpiderAILODSubsystem from the significance manager */
+	UFUNCTION(BlueprintCallable, Category = "Spider|LOD")
+	void SetLOD(ESpiderLOD NewLOD);
+
+	/** LOD as significance for one viewpoint; the significance manager keeps the highest over all viewpoints */
+	float CalculateSignificance(const FTransform& Viewpoint) const;
+
+	/** Coarse movement over DeltaSeconds, called by USpiderAILODSubsystem while the LOD is Coarse */
+	void TickCoarse(float DeltaSeconds);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnPossess(APawn* InPawn) override;
 	virtual void Tick(float DeltaSeconds) override;
 
@@ -61,8 +115,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Target")
 	bool bFollowPlayer = false;
 
+	/** Per-agent diagnostics for spider.Debug.Log / spider.Debug.Draw level 1. Toggle at runtime with spider.Debug.Agent */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Debug")
-	bool bDebug = true;
+	bool bDebug = false;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Speed", meta = (ClampMin = "1.0"))
 	float MoveSpeed = 800.f;
@@ -79,6 +134,39 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Navigation", meta = (ClampMin = "1.0"))
 	float NodeAcceptanceRadius = 30.f;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Navigation")
+	ESpiderFollowMode FollowMode = ESpiderFollowMode::Replan;
+
+	/** Fewer waypoints on planar stretches: less re-targeting and rotating per node. Needs a UNavGridComponent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Navigation")
+	bool bSmoothPath = true;
+
+	/** Use QueryParams for MoveTo instead of the navigation component's defaults */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Navigation")
+	bool bOverrideQueryParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|Navigation", meta = (EditCondition = "bOverrideQueryParams"))
+	FSpiderNavQueryParams QueryParams;
+
+	/** Opt-in: lower tick rate and coarse movement for distant or off-screen spiders (significance manager). Read on BeginPlay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|LOD")
+	bool bUseSignificanceLOD = false;
+
+	/** Full LOD within this distance of a viewer, visible or not */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|LOD", meta = (EditCondition = "bUseSignificanceLOD", ClampMin = "0.0"))
+	float LODFullDistance = 2500.f;
+
+	/** Reduced LOD within this distance if in view, Coarse beyond or off-screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|LOD", meta = (EditCondition = "bUseSignificanceLOD", ClampMin = "0.0"))
+	float LODReducedDistance = 8000.f;
+
+	/** Half angle of the view cone counting as on-screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|LOD", meta = (EditCondition = "bUseSignificanceLOD", ClampMin = "1.0", ClampMax = "180.0"))
+	float LODViewHalfAngle = 60.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spider|LOD", meta = (EditCondition = "bUseSignificanceLOD", ClampMin = "0.0"))
+	float LODReducedTickInterval = 0.1f;
+
 protected:
 	// ===== Internal Data =====
 	UPROPERTY()
@@ -87,8 +175,12 @@ protected:
 	UPROPERTY()
 	UObject* NavigationComponent = nullptr;
 
-	UPROPERTY()
-	TArray<FVector> CurrentPathPoints;
+	/** Path being followed; CurrentPathIndex is the next point. Reused between moves, normals only from UNavGridComponent */
+	FSpiderNavPathResult CurrentPath;
+	int32 CurrentPathIndex = 0;
+
+	/** Second buffer for paths that may be rejected, swapped with CurrentPath when taken */
+	FSpiderNavPathResult PendingPath;
 
 	UPROPERTY()
 	FVector MoveDestination = FVector::ZeroVector;
@@ -120,12 +212,33 @@ protected:
 	UPROPERTY()
 	bool bLocalPathFound = false;
 
+	/** Set when obstacles invalidated the current path; MoveTo then searches even if the destination is unchanged */
+	bool bRepathRequested = false;
+
+	FDelegateHandle GridChangedHandle;
+
+	/** Options of the current move set by MoveToWithParams; a plain MoveTo clears them */
+	TOptional<FSpiderNavQueryParams> MoveQueryParams;
+	bool bKeepMoveQueryParams = false;
+
+	/** Search tree of the Incremental follow mode */
+	FSpiderNavIncrementalPlanner FollowPlanner;
+	FVector FollowTargetLocation = FVector::ZeroVector;
+	TWeakObjectPtr<AActor> FollowTargetActor;
+	bool bFollowingTarget = false;
+
 	FTimerHandle TimerHandle_FindPathTick;
 	FHandleMoveCompleted HandleMoveCompleted;
 
+	ESpiderLOD CurrentLOD = ESpiderLOD::Full;
+
 private:
 	// ===== Core Logic =====
 	void FindPathTick();
+	/** Starts moving along CurrentPath, broadcasts a failed move if there is nothing to follow */
+	void StartPathMove(const FVector& StartNode);
+	/** Continues a flow field path that was cut before the target with its next stretch. False if there is none */
+	bool ExtendFlowFieldPath();
 	void UpdateLocalMoveDestination();
 	void UpdateRotationParams();
 
@@ -139,7 +252,11 @@ private:
 	void SetTargetActor(AActor* NewTarget);
 
 	// ===== Navigation helpers =====
+	/** Path of MoveTo with MoveQueryParams, QueryParams or the component's defaults */
+	void FindMovePath(const FVector& Start, const FVector& End, FSpiderNavPathResult& OutPath);
 	UObject* ResolveNavigationInterface();
+	void OnNavGridChanged(uint32 GridVersion, const FBox& ChangedBounds);
+	bool DoesPathIntersect(const FBox& Bounds) const;
 	FVector GetNormalToLocalDestination() const;
 	void DrawDebugPath() const;
 };
@@ -0,0 +1,77 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+
+/**
+ * Anytime Repairing A* (ARA*). The first pass is weighted A* with the initial epsilon; while time remains epsilon is
+ * lowered and the previous search is repaired (locally inconsistent nodes are reopened) instead of searching again.
+ * Each finished pass guarantees cost <= epsilon * optimal. Per-node state is stamped per query like the bidirectional search.
+ */
+class SPIDERNAVIGATION_API FSpiderNavAnytimeSearch
+{
+public:
+	/**
+	 * Node path from Start to Goal. If Goal cannot be reached the path ends at the settled node closest to it
+	 * and bOutComplete is false. Returns false if there is no path at all
+	 */
+	bool Search(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Start, int32 Goal,
+		float Epsilon, double DeadlineSeconds, TArray<int32>& OutPath, bool& bOutComplete);
+
+	/** Bound of the last finished pass, 1 = optimal */
+	float GetLastEpsilon() const { return LastEpsilon; }
+	int32 GetLastPasses() const { return LastPasses; }
+	int32 GetLastExpansions() const { return LastExpansions; }
+	int32 GetLastOpenListPeak() const { return LastOpenListPeak; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FQueueEntry
+	{
+		float Key = 0.f;
+		float G = 0.f;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FQueueEntry& Other) const { return Key < Other.Key; }
+	};
+
+	/** Expands until the goal is settled for the current epsilon. Returns false if the deadline interrupted the pass */
+	bool ImprovePath(double EndTime, bool bCanAbort);
+
+	float Heuristic(int32 Node) const;
+
+	/** Drops entries whose node got cheaper since or that were expanded in this pass */
+	void PruneQueue();
+
+	const FSavedSpiderNavGrid* Grid = nullptr;
+	const FSpiderNavObstacleLayer* Obstacles = nullptr;
+	int32 Goal = INDEX_NONE;
+	FVector GoalLocation = FVector::ZeroVector;
+	float CurrentEpsilon = 1.f;
+
+	TArray<float> G;
+	TArray<int32> Parent;
+	/** G and Parent valid if Visited == Stamp */
+	TArray<uint32> Visited;
+	/** Expanded in the current pass if Closed == PassStamp */
+	TArray<uint32> Closed;
+	/** In Inconsistent if InconsistentMark == PassStamp */
+	TArray<uint32> InconsistentMark;
+	TArray<int32> Inconsistent;
+	TArray<FQueueEntry> Queue;
+	uint32 Stamp = 0;
+	uint32 PassStamp = 0;
+
+	int32 BestPartial = INDEX_NONE;
+	float BestPartialDistance = 0.f;
+
+	float LastEpsilon = 1.f;
+	int32 LastPasses = 0;
+	int32 LastExpansions = 0;
+	int32 LastOpenListPeak = 0;
+};
@@ -0,0 +1,62 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+struct FSpiderNavPathResult;
+struct FSpiderNavQueryParams;
+
+/** One query of UNavGridComponent::FindPathsBatch */
+struct FSpiderNavPathQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+};
+
+/**
+ * Runs many node-to-node searches at once on worker threads. Queries sharing a goal node are answered by one reverse
+ * Dijkstra from the goal that stops once all their starts are settled; all other queries run the search of their
+ * mode (stamped per-thread scratch, the grid's node metrics are not touched). Scratch is pooled between batches.
+ * The grid and obstacles must not change while Run is executing.
+ */
+class SPIDERNAVIGATION_API FSpiderNavBatchSearch
+{
+public:
+	FSpiderNavBatchSearch();
+	~FSpiderNavBatchSearch();
+
+	/**
+	 * Searches Starts[i] -> Goals[i] for every i in Queries into OutResults[i] (filled, not smoothed), OutExpansions[i]
+	 * and OutOpenListPeaks[i]. Expansions and open list peak of a shared search are counted on its first query
+	 */
+	void Run(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FSpiderNavQueryParams& Params,
+		TConstArrayView<int32> Queries, TConstArrayView<int32> Starts, TConstArrayView<int32> Goals,
+		TArray<FSpiderNavPathResult>& OutResults, TArray<int32>& OutExpansions, TArray<int32>& OutOpenListPeaks);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FScratch;
+
+	/** Contiguous queries in GroupedQueries; Count > 1 for shared goals */
+	struct FTask
+	{
+		int32 First = 0;
+		int32 Count = 0;
+	};
+
+	TUniquePtr<FScratch> ClaimScratch();
+
+	/** Task list of the current batch, kept for its allocations */
+	TArray<FTask> Tasks;
+	TArray<int32> GroupedQueries;
+
+	/** Per-thread scratch of finished batches */
+	FCriticalSection ScratchLock;
+	TArray<TUniquePtr<FScratch>> ScratchPool;
+};
@@ -0,0 +1,66 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+
+/**
+ * Bidirectional A* with the balanced (average) potential p(v) = (h_goal(v) - h_start(v)) / 2:
+ * forward search on outgoing, backward search on incoming CSR edges, always expanding the smaller frontier,
+ * stopping once top_forward + top_backward >= best meeting cost. Optimal like A*.
+ * Per-node state lives in arrays stamped per query, so consecutive searches do not clear the whole grid.
+ */
+class SPIDERNAVIGATION_API FSpiderNavBidirectionalSearch
+{
+public:
+	/**
+	 * Node path from Start to Goal. If Goal cannot be reached the path ends at the node of the forward search closest
+	 * to it and bOutComplete is false. Returns false if there is no path at all
+	 */
+	bool Search(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Start, int32 Goal, TArray<int32>& OutPath, bool& bOutComplete);
+
+	int32 GetLastExpansions() const { return LastExpansions; }
+	int32 GetLastOpenListPeak() const { return LastOpenListPeak; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FQueueEntry
+	{
+		float Key = 0.f;
+		float G = 0.f;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FQueueEntry& Other) const { return Key < Other.Key; }
+	};
+
+	/** State of one search direction */
+	struct FSide
+	{
+		TArray<float> G;
+		TArray<int32> Parent;
+		/** G and Parent valid if Visited == Stamp, node settled if Closed == Stamp */
+		TArray<uint32> Visited;
+		TArray<uint32> Closed;
+		TArray<FQueueEntry> Queue;
+
+		bool IsVisited(int32 Node, uint32 Stamp) const { return Visited[Node] == Stamp; }
+		bool IsClosed(int32 Node, uint32 Stamp) const { return Closed[Node] == Stamp; }
+		void Prepare(int32 NumNodes);
+		/** Drops stale and settled entries on top of the queue */
+		void Prune(uint32 Stamp);
+		SIZE_T GetAllocatedSize() const;
+	};
+
+	void Prepare(int32 NumNodes);
+
+	FSide Forward;
+	FSide Backward;
+	uint32 Stamp = 0;
+
+	int32 LastExpansions = 0;
+	int32 LastOpenListPeak = 0;
+};
@@ -0,0 +1,69 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+
+/**
+ * Reverse Dijkstra from one target node over the whole component: every reached node stores the edge of its
+ * shortest path towards the target, so any number of agents can follow the field with O(1) per step.
+ * The build runs in time slices (Step); readers keep using the last finished field until the next one is published.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavFlowField
+{
+	/** Starts a new build towards TargetNode. A running build is discarded, the published field stays */
+	void Start(const FSavedSpiderNavGrid& Grid, int32 TargetNode);
+
+	/** Expands nodes until the build finished or InOutBudget is used up. Returns true once the build finished and was published */
+	bool Step(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32& InOutBudget);
+
+	bool IsBuilding() const { return BuildTarget != INDEX_NONE; }
+	bool IsReady() const { return Target != INDEX_NONE; }
+
+	/** Target node of the published field and of the running build */
+	int32 GetTarget() const { return Target; }
+	int32 GetBuildTarget() const { return BuildTarget; }
+
+	/** Forward edge (CSR index) to take from Node, INDEX_NONE at the target or if Node cannot reach it. Only valid for the grid the field was built on */
+	int32 GetNextEdge(int32 Node) const { return NextEdges.IsValidIndex(Node) ? NextEdges[Node] : INDEX_NONE; }
+
+	/** Cost from Node to the target, negative if unreachable */
+	float GetCostToTarget(int32 Node) const;
+
+	/** Node indices from Node along the field, at most MaxNodes. Returns false if Node cannot reach the target or an edge on the way got blocked since the build */
+	bool Follow(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Node, int32 MaxNodes, TArray<int32>& OutNodes) const;
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return NextEdges.GetAllocatedSize() + Costs.GetAllocatedSize()
+			+ BuildNextEdges.GetAllocatedSize() + BuildCosts.GetAllocatedSize() + Queue.GetAllocatedSize();
+	}
+
+private:
+	struct FQueueEntry
+	{
+		float Cost = 0.f;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FQueueEntry& Other) const { return Cost < Other.Cost; }
+	};
+
+	/** Published field */
+	int32 Target = INDEX_NONE;
+	/** Edge count of the grid the field indexes into, a different count means the grid was replaced */
+	int32 NumEdges = 0;
+	TArray<int32> NextEdges;
+	TArray<float> Costs;
+
+	/** Build in progress */
+	int32 BuildTarget = INDEX_NONE;
+	int32 BuildNumEdges = 0;
+	TArray<int32> BuildNextEdges;
+	TArray<float> BuildCosts;
+	TArray<FQueueEntry> Queue;
+};
@@ -0,0 +1,108 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+
+/**
+ * Lifelong Planning A* (LPA*) for one agent following a moving target.
+ * The search tree stays rooted at the agent's node between queries: a moved goal only re-keys the open list,
+ * changed edges only re-evaluate their end nodes. While the agent walks along the planned path the root is kept
+ * and the path is returned from the agent's node on; once the agent left the path the tree is rebuilt.
+ * State is sparse (touched nodes only), so many followers can share one large grid.
+ */
+class SPIDERNAVIGATION_API FSpiderNavIncrementalPlanner
+{
+public:
+	/** Drops the search tree, the next Plan starts from scratch */
+	void Reset();
+
+	/**
+	 * Path from Start to Goal as node indices. If Goal is unreachable the path ends at the reached node closest to it
+	 * and bOutComplete is false. Returns false if there is no path at all.
+	 */
+	bool Plan(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, int32 Start, int32 Goal, TArray<int32>& OutPath, bool& bOutComplete);
+
+	/** Re-evaluates all nodes whose incoming edges may have changed blocking inside Bounds */
+	void NotifyChanged(const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles, const FBox& Bounds);
+
+	bool HasTree() const { return Root != INDEX_NONE; }
+
+	/** Grid version the tree is consistent with, maintained by UNavGridComponent */
+	uint32 GridVersion = 0;
+
+	/** Nodes expanded by the last Plan, 0 if the goal was already settled */
+	int32 GetLastExpansions() const { return LastExpansions; }
+	int32 GetLastOpenListPeak() const { return LastOpenListPeak; }
+	bool WasLastPlanIncremental() const { return bLastPlanIncremental; }
+
+	SIZE_T GetAllocatedSize() const { return States.GetAllocatedSize() + Queue.GetAllocatedSize(); }
+
+private:
+	struct FKey
+	{
+		float K1 = 0.f;
+		float K2 = 0.f;
+
+		bool operator<(const FKey& Other) const { return K1 < Other.K1 || (K1 == Other.K1 && K2 < Other.K2); }
+		bool operator==(const FKey& Other) const { return K1 == Other.K1 && K2 == Other.K2; }
+	};
+
+	struct FState
+	{
+		float G = TNumericLimits<float>::Max();
+		float Rhs = TNumericLimits<float>::Max();
+		/** Key of the valid queue entry, older entries with other keys are stale */
+		FKey Key;
+		bool bInQueue = false;
+	};
+
+	struct FQueueEntry
+	{
+		FKey Key;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FQueueEntry& Other) const { return Key < Other.Key; }
+	};
+
+	/** Sets the grid for the current call */
+	void Bind(const FSavedSpiderNavGrid& InGrid, const FSpiderNavObstacleLayer& InObstacles);
+	void Unbind();
+
+	void StartTree(int32 Start);
+	void SetGoal(int32 NewGoal);
+	void ComputeShortestPath();
+	bool ExtractPath(TArray<int32>& OutPath, bool& bOutComplete) const;
+
+	float Heuristic(int32 Node) const;
+	float EdgeCost(int32 Edge) const;
+	FKey CalculateKey(int32 Node, const FState& State) const;
+	FState& GetState(int32 Node) { return States.FindOrAdd(Node); }
+	const FState* FindState(int32 Node) const { return States.Find(Node); }
+
+	/** rhs from all predecessors */
+	float ComputeRhs(int32 Node) const;
+	void UpdateQueue(int32 Node, FState& State);
+	/** Drops stale entries on top of the queue */
+	void PruneQueue();
+	/** Recomputes all keys after the goal (and with it the heuristic) changed */
+	void RebuildQueue();
+
+	const FSavedSpiderNavGrid* Grid = nullptr;
+	const FSpiderNavObstacleLayer* Obstacles = nullptr;
+
+	int32 Root = INDEX_NONE;
+	int32 Goal = INDEX_NONE;
+	FVector GoalLocation = FVector::ZeroVector;
+
+	TMap<int32, FState> States;
+	TArray<FQueueEntry> Queue;
+	int32 NumQueued = 0;
+
+	int32 LastExpansions = 0;
+	int32 LastOpenListPeak = 0;
+	bool bLastPlanIncremental = false;
+};
@@ -0,0 +1,81 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * LRU cache of node paths keyed by (start node, goal node) for one grid version.
+ * Complete paths also answer queries that start anywhere on them (sub-paths of shortest paths are shortest paths).
+ * Any grid or obstacle change bumps the grid version and empties the cache on the next access.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavPathCache
+{
+	/** Path from Start to Goal if cached for GridVersion, possibly as the suffix of a longer path */
+	bool Find(int32 Start, int32 Goal, uint32 GridVersion, TArray<int32>& OutPath, bool& bOutComplete);
+
+	/** Node after Start on a cached path to Goal without copying the path. Counts hits only, the caller's search counts the miss */
+	bool FindNextNode(int32 Start, int32 Goal, uint32 GridVersion, int32& OutNext);
+
+	/** Stores Path (Start first), evicting the least recently used path when full */
+	void Add(int32 Start, int32 Goal, uint32 GridVersion, const TArray<int32>& Path, bool bComplete);
+
+	/** Maximum number of paths, 0 disables the cache */
+	void SetCapacity(int32 InCapacity);
+
+	void Reset();
+
+	int32 Num() const { return ByKey.Num(); }
+	uint64 GetHits() const { return Hits; }
+	uint64 GetSuffixHits() const { return SuffixHits; }
+	uint64 GetMisses() const { return Misses; }
+	/** (Hits + SuffixHits) / lookups since the last Reset */
+	float GetHitRate() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FEntry
+	{
+		int32 Start = INDEX_NONE;
+		int32 Goal = INDEX_NONE;
+		TArray<int32> Path;
+		bool bComplete = false;
+		/** Doubly linked LRU list, Head = most recently used */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	struct FPathPosition
+	{
+		int32 Entry = INDEX_NONE;
+		int32 Position = INDEX_NONE;
+	};
+
+	static uint64 MakeKey(int32 A, int32 B) { return (uint64(uint32(A)) << 32) | uint32(B); }
+
+	void Unlink(int32 Entry);
+	void LinkFront(int32 Entry);
+	void Evict(int32 Entry);
+	void Touch(int32 Entry);
+
+	/** Drops everything if the grid changed since the cached paths were found */
+	void SyncVersion(uint32 GridVersion);
+
+	int32 Capacity = 256;
+	uint32 CachedGridVersion = 0;
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	/** (Start, Goal) -> entry */
+	TMap<uint64, int32> ByKey;
+	/** (Node, Goal) -> position of Node on a complete cached path to Goal */
+	TMap<uint64, FPathPosition> ByNode;
+
+	uint64 Hits = 0;
+	uint64 SuffixHits = 0;
+	uint64 Misses = 0;
+};
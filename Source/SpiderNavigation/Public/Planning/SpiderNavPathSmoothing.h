@@ -0,0 +1,23 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSpiderNavPathResult;
+struct FSavedSpiderNavGrid;
+struct FSpiderNavObstacleLayer;
+
+/**
+ * String pulling on the grid surface. From each kept waypoint (the anchor) the path jumps to the farthest node that is
+ * visible on the anchor's plane: the node itself has a normal within MaxNormalAngle of the anchor and lies within
+ * Tolerance of its plane, and the straight segment to it is walked in steps of about half the longest edge, each sample
+ * needing an unblocked node of the same component on that plane nearby (spatial index lookups, no collision traces).
+ * Shortcuts across holes, obstacles and surface edges are therefore rejected.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavPathSmoothing
+{
+	/** Removes redundant waypoints in place, first and last node are kept. Kept nodes keep their cumulative grid cost. Returns the number of removed nodes */
+	static int32 Smooth(FSpiderNavPathResult& Path, const FSavedSpiderNavGrid& Grid, const FSpiderNavObstacleLayer& Obstacles,
+		float MaxNormalAngleDegrees, float Tolerance);
+};
@@ -57,6 +57,10 @@ public:
 	UPROPERTY()
 	TMap<int32, FSpiderNavRelations> NavRelations;
 
+    /** Hash of the builder inputs this grid was generated from. Empty for grids saved by older builders */
+	UPROPERTY()
+	FString InputHash;
+
     /** Name of save slot to store navigation grid */
 	UPROPERTY()
 	FString SaveSlotName;
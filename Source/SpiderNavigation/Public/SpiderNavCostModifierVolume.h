@@ -0,0 +1,29 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SpiderNavCostModifierVolume.generated.h"
+
+/** Scales the traversal cost of grid nodes inside the box, e.g. to keep spiders off a lit area. Applied when the grid is loaded */
+UCLASS()
+class SPIDERNAVIGATION_API ASpiderNavCostModifierVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ASpiderNavCostModifierVolume();
+
+	class UBoxComponent* GetVolume() const { return Volume; }
+
+	float GetCostMultiplier() const { return CostMultiplier; }
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Components)
+	class UBoxComponent* Volume;
+
+	/** Cost per unit of distance inside the volume. Above 1 avoids the area, below 1 prefers it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation", meta = (ClampMin = "0.01"))
+	float CostMultiplier = 2.f;
+};
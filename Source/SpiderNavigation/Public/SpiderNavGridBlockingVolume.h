@@ -6,6 +6,10 @@
 #include "GameFramework/Actor.h"
 #include "SpiderNavGridBlockingVolume.generated.h"
 
+/**
+ * Blocks the nodes and edges of the runtime grid inside its box. Follows the box when it moves
+ * (attach it to a door) and unblocks on SetBlocking(false) or when destroyed.
+ */
 UCLASS()
 class SPIDERNAVIGATION_API ASpiderNavGridBlockingVolume : public AActor
 {
@@ -17,7 +21,32 @@ public:
 public:	
 	class UBoxComponent* GetBlockingVolume() const;
 
+	/** Opens (false) or closes (true) the volume for navigation */
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
+	void SetBlocking(bool bNewBlocking);
+
+	UFUNCTION(BlueprintPure, Category = "SpiderNavigation")
+	bool IsBlocking() const { return bBlocking; }
+
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Components)
 	class UBoxComponent* BlockingVolume;
+
+	/** Whether the volume currently blocks the grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SpiderNavigation")
+	bool bBlocking = true;
+
+private:
+	void OnVolumeTransformUpdated(class USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Pushes the current box (or its removal) to the navigation grid */
+	void UpdateGrid();
+
+	class UNavGridComponent* ResolveNavGrid();
+
+	UPROPERTY()
+	class UNavGridComponent* NavGrid = nullptr;
 };
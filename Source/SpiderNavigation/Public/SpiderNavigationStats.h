@@ -0,0 +1,52 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/** stat SpiderNav */
+DECLARE_STATS_GROUP(TEXT("SpiderNav"), STATGROUP_SpiderNav, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Path"), STAT_SpiderNav_FindPath, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Closest Node"), STAT_SpiderNav_FindClosestNode, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Grid"), STAT_SpiderNav_LoadGrid, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+
+// Reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Closest Node Lookups"), STAT_SpiderNav_ClosestNodeLookups, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Searches"), STAT_SpiderNav_Searches, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Partial Paths"), STAT_SpiderNav_PartialPaths, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cross-Component Queries"), STAT_SpiderNav_CrossComponent, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Expansions"), STAT_SpiderNav_Expansions, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Open List Peak"), STAT_SpiderNav_OpenListPeak, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Nodes"), STAT_SpiderNav_PathNodes, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Path Length"), STAT_SpiderNav_PathLength, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Hits"), STAT_SpiderNav_PathCacheHits, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Suffix Hits"), STAT_SpiderNav_PathCacheSuffixHits, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Misses"), STAT_SpiderNav_PathCacheMisses, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Next Hop Queries"), STAT_SpiderNav_NextHops, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Next Hop Searches"), STAT_SpiderNav_NextHopSearches, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Coarse Agent Updates"), STAT_SpiderNav_CoarseUpdates, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+
+// Persistent
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Load Time (ms)"), STAT_SpiderNav_LoadTimeMs, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Loaded Nodes"), STAT_SpiderNav_LoadedNodes, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Coarse Agents"), STAT_SpiderNav_CoarseAgents, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Grid Memory"), STAT_SpiderNav_GridMemory, STATGROUP_SpiderNav, SPIDERNAVIGATION_API);
+
+/** Unreal Insights channel for all navigation and builder scopes. Enable with -trace=cpu,SpiderNav */
+UE_TRACE_CHANNEL_EXTERN(SpiderNavChannel, SPIDERNAVIGATION_API);
+
+/** CPU profiler scope on SpiderNavChannel */
+#define SPIDERNAV_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, SpiderNavChannel)
+
+namespace SpiderNavStats
+{
+	/** Open list peak of the current frame; counter stats can only be set, so the maximum is tracked here */
+	SPIDERNAVIGATION_API void ReportOpenListPeak(int32 OpenListSize);
+
+	/** Records a finished search */
+	SPIDERNAVIGATION_API void ReportSearch(int32 Expansions, int32 OpenListPeak, const TArray<FVector>& PathLocations, bool bComplete);
+}
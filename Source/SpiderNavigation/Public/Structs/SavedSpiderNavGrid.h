@@ -1,10 +1,32 @@
 #pragma once
 
 #include "Structs/SpiderNavNode.h"
+#include "Structs/SpiderNavSpatialIndex.h"
 #include "SavedSpiderNavGrid.generated.h"
 
+/** Inputs for edge cost shaping. An edge costs its length times the mean multiplier of its two nodes */
+struct FSpiderNavCostSettings
+{
+	/** Multiplier for nodes on walls (normal roughly horizontal) */
+	float WallCostMultiplier = 1.f;
+
+	/** Multiplier for nodes on ceilings (normal pointing down) */
+	float CeilingCostMultiplier = 1.f;
+
+	/** Oriented box of an area cost volume */
+	struct FArea
+	{
+		FTransform Transform;
+		FVector Extent = FVector::ZeroVector;
+		float Multiplier = 1.f;
+	};
+
+	/** Overlapping areas multiply */
+	TArray<FArea> Areas;
+};
+
 USTRUCT(BlueprintType)
-struct FSavedSpiderNavGrid
+struct SPIDERNAVIGATION_API FSavedSpiderNavGrid
 {
     GENERATED_BODY()
 
@@ -13,8 +35,52 @@ public:
 	// SavedIndex -> LocalIndex
 	TMap<int32, int32> NodesSavedIndexes;
 
+	/** Number of nodes per connected component, indexed by FSpiderNavNode::ComponentId */
+	TArray<int32> ComponentSizes;
+
+	/** Closest node lookups, built by BuildQueryData */
+	FSpiderNavSpatialIndex SpatialIndex;
+
+	/** CSR adjacency: edges of node i are [EdgeOffsets[i], EdgeOffsets[i + 1]) in EdgeTargets and EdgeCosts, in Neighbors order */
+	TArray<int32> EdgeOffsets;
+	TArray<int32> EdgeTargets;
+	TArray<float> EdgeCosts;
+
+	/** Transposed CSR: incoming edges of node i are ReverseEdges[ReverseEdgeOffsets[i] .. ReverseEdgeOffsets[i + 1]), as forward edge indices */
+	TArray<int32> ReverseEdgeOffsets;
+	TArray<int32> ReverseEdges;
+	/** Source node of every forward edge */
+	TArray<int32> EdgeSources;
+
+	/** Smallest cost per unit of distance over all edges. Scales the A* heuristic so it stays admissible */
+	float HeuristicScale = 1.f;
+
+	/** Longest edge, bounds the search radius for edges crossing a region */
+	float MaxEdgeLength = 0.f;
+
 	int GetNavNodesCount() const
 	{
 		return NavNodes.Num();
 	}
+
+	/** Labels connected components, builds the spatial index and the weighted CSR adjacency. Call once all neighbours are linked */
+	void BuildQueryData(const FSpiderNavCostSettings& Costs = FSpiderNavCostSettings());
+
+	/** Cost multiplier of a single node from its surface orientation and the area volumes */
+	static float GetNodeCostMultiplier(const FSpiderNavNode& Node, const FSpiderNavCostSettings& Costs);
+
+	/** Index of the node closest to Location, optionally only within one component. INDEX_NONE if there is none */
+	int32 FindClosestNodeIndex(const FVector& Location, int32 ComponentId = INDEX_NONE) const;
+
+	/** Heap memory of nodes, neighbour lists, index map and query data */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = NavNodes.GetAllocatedSize() + NodesSavedIndexes.GetAllocatedSize()
+			+ ComponentSizes.GetAllocatedSize() + SpatialIndex.GetAllocatedSize()
+			+ EdgeOffsets.GetAllocatedSize() + EdgeTargets.GetAllocatedSize() + EdgeCosts.GetAllocatedSize()
+			+ ReverseEdgeOffsets.GetAllocatedSize() + ReverseEdges.GetAllocatedSize() + EdgeSources.GetAllocatedSize();
+		for (const FSpiderNavNode& Node : NavNodes)
+			Size += Node.Neighbors.GetAllocatedSize();
+		return Size;
+	}
 };
\ No newline at end of file
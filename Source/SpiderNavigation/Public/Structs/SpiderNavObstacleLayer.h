@@ -0,0 +1,57 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+struct FSavedSpiderNavGrid;
+
+/**
+ * Runtime blocking of grid nodes and edges by obstacle boxes (doors, barricades, ASpiderNavGridBlockingVolume).
+ * Blocking is reference counted per node and edge so overlapping obstacles can move independently;
+ * the search only reads the bitsets. Component IDs ignore obstacles, a blocked goal yields a partial path.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavObstacleLayer
+{
+	/** Sizes the bitsets for Grid and reapplies all registered obstacles. Call after the grid changed */
+	void Rebuild(const FSavedSpiderNavGrid& Grid);
+
+	/** Registers or moves an obstacle. Returns the world bounds of the change, an invalid box if no node or edge changed state */
+	FBox Update(const FSavedSpiderNavGrid& Grid, FObjectKey Obstacle, const FTransform& Transform, const FVector& Extent);
+
+	/** Unregisters an obstacle. Returns the world bounds of the change like Update */
+	FBox Remove(FObjectKey Obstacle);
+
+	bool IsNodeBlocked(int32 NodeIndex) const { return BlockedNodes.IsValidIndex(NodeIndex) && BlockedNodes[NodeIndex]; }
+
+	/** Edge index into the CSR arrays of the grid */
+	bool IsEdgeBlocked(int32 EdgeIndex) const { return BlockedEdges.IsValidIndex(EdgeIndex) && BlockedEdges[EdgeIndex]; }
+
+	int32 GetNumObstacles() const { return Obstacles.Num(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FObstacle
+	{
+		FTransform Transform;
+		FVector Extent = FVector::ZeroVector;
+		FBox Bounds = FBox(ForceInit);
+		/** Nodes inside and edges crossing the box */
+		TArray<int32> Nodes;
+		TArray<int32> Edges;
+	};
+
+	/** Fills Nodes and Edges of Obstacle from its box */
+	static void Collect(const FSavedSpiderNavGrid& Grid, FObstacle& Obstacle);
+
+	/** Adds Delta to the counters of everything Obstacle blocks. Returns whether any bit flipped */
+	bool Apply(const FObstacle& Obstacle, int32 Delta);
+
+	TMap<FObjectKey, FObstacle> Obstacles;
+	TArray<uint16> NodeBlockCount;
+	TArray<uint16> EdgeBlockCount;
+	TBitArray<> BlockedNodes;
+	TBitArray<> BlockedEdges;
+};
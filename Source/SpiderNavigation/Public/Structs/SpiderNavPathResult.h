@@ -0,0 +1,45 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSavedSpiderNavGrid;
+
+/**
+ * Path of one query as parallel arrays: grid node index, location, surface normal and cost from the start.
+ * Meant to be kept by the caller and passed to every query: Reset keeps the allocations, so repeated
+ * queries with paths of similar length do not allocate.
+ */
+struct SPIDERNAVIGATION_API FSpiderNavPathResult
+{
+	TArray<int32> NodeIndices;
+	TArray<FVector> Locations;
+	TArray<FVector> Normals;
+	/** Summed edge costs from the first node; 0 for the first node */
+	TArray<float> CumulativeCosts;
+
+	/** False for partial paths, e.g. to the closest reachable node */
+	bool bComplete = false;
+
+	int32 Num() const { return NodeIndices.Num(); }
+	bool IsEmpty() const { return NodeIndices.Num() == 0; }
+
+	float GetTotalCost() const { return CumulativeCosts.Num() > 0 ? CumulativeCosts.Last() : 0.f; }
+
+	/** Empties all arrays without freeing them */
+	void Reset()
+	{
+		NodeIndices.Reset();
+		Locations.Reset();
+		Normals.Reset();
+		CumulativeCosts.Reset();
+		bComplete = false;
+	}
+
+	/** Fills locations, normals and costs from NodeIndices */
+	void FillFromIndices(const FSavedSpiderNavGrid& Grid);
+
+	/** Keeps the first NewNum entries of all arrays */
+	void Truncate(int32 NewNum);
+};
@@ -0,0 +1,45 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpiderNavQueryParams.generated.h"
+
+/** Search algorithm behind FindNodesPath */
+UENUM(BlueprintType)
+enum class ESpiderNavSearchMode : uint8
+{
+	/** Unidirectional A* from the start */
+	AStar,
+	/** A* from both ends with a balanced heuristic, meets in the middle. Fewer expansions on long paths */
+	Bidirectional,
+	/** A* with the heuristic weighted by Epsilon: path cost at most Epsilon times optimal, far fewer expansions */
+	Weighted,
+	/** ARA*: weighted A* with Epsilon first, then improves the path with smaller weights until DeadlineMs runs out */
+	Anytime
+};
+
+/** Per-query options for UNavGridComponent::FindPathWithParams */
+USTRUCT(BlueprintType)
+struct FSpiderNavQueryParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation")
+	ESpiderNavSearchMode Mode = ESpiderNavSearchMode::AStar;
+
+	/** Heuristic weight of Weighted and the first Anytime pass; the path costs at most Epsilon times the optimum */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation", meta = (ClampMin = "1.0"))
+	float Epsilon = 2.f;
+
+	/** Time budget of Anytime. The first path is always finished, later improvement passes stop at the deadline */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation", meta = (ClampMin = "0.0"))
+	float DeadlineMs = 1.f;
+
+	/** Drop redundant waypoints on planar stretches (see UNavGridComponent smoothing settings). The path is then no longer a chain of neighbors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavigation")
+	bool bSmoothPath = false;
+
+	/** Whether the mode always returns shortest paths (only those are shared through the path cache) */
+	bool IsOptimal() const { return Mode == ESpiderNavSearchMode::AStar || Mode == ESpiderNavSearchMode::Bidirectional || Epsilon <= 1.f; }
+};
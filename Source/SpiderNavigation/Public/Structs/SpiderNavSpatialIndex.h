@@ -0,0 +1,43 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSpiderNavNode;
+
+/** Uniform hash grid over node locations for exact closest-node queries */
+struct SPIDERNAVIGATION_API FSpiderNavSpatialIndex
+{
+	/** Cell size is derived from the typical edge length of the grid */
+	void Build(const TArray<FSpiderNavNode>& Nodes);
+
+	void Reset();
+
+	bool IsEmpty() const { return Cells.Num() == 0; }
+
+	/** Index of the node closest to Location, optionally restricted to one connected component. INDEX_NONE if there is none */
+	int32 FindClosest(const TArray<FSpiderNavNode>& Nodes, const FVector& Location, int32 ComponentId = INDEX_NONE) const;
+
+	/** Calls Visit for every node in a cell overlapping Box. Nodes may lie slightly outside Box */
+	void ForEachInBox(const FBox& Box, TFunctionRef<void(int32 NodeIndex)> Visit) const;
+
+	SIZE_T GetAllocatedSize() const { return Cells.GetAllocatedSize() + CellNodes.GetAllocatedSize(); }
+
+private:
+	/** Range in CellNodes */
+	struct FCell
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	double CellSize = 100.0;
+	FIntVector MinCell = FIntVector::ZeroValue;
+	FIntVector MaxCell = FIntVector::ZeroValue;
+	TMap<FIntVector, FCell> Cells;
+	/** Node indices grouped by cell */
+	TArray<int32> CellNodes;
+};
@@ -0,0 +1,58 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpiderAILODSubsystem.generated.h"
+
+class ASpiderAIController;
+
+/**
+ * Significance-based LOD of ASpiderAIController. Registers the controllers with the significance manager, feeds it the
+ * players' viewpoints (spider.LOD.UpdateViewpoints) and applies the resulting ESpiderLOD. Coarse controllers do not tick;
+ * they are moved here round-robin every spider.LOD.CoarseInterval seconds, at most spider.LOD.CoarseBudget per frame.
+ * Opt-in: only controllers with bUseSignificanceLOD register, and it only ticks while some are registered.
+ */
+UCLASS()
+class SPIDERNAVIGATION_API USpiderAILODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+public:
+	void RegisterController(ASpiderAIController* Controller);
+	void UnregisterController(ASpiderAIController* Controller);
+
+	/** Called by ASpiderAIController::SetLOD when it enters or leaves Coarse */
+	void SetCoarse(ASpiderAIController* Controller, bool bCoarse);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FCoarseEntry
+	{
+		TWeakObjectPtr<ASpiderAIController> Controller;
+		double LastUpdateTime = 0.0;
+	};
+
+	void UpdateSignificance();
+	void UpdateCoarse();
+	/** spider.LOD.Enable switched off: everything back to Full */
+	void RestoreFullLOD();
+
+	TArray<TWeakObjectPtr<ASpiderAIController>> Controllers;
+	TArray<FCoarseEntry> CoarseControllers;
+	/** Next coarse entry of the round-robin */
+	int32 CoarseCursor = 0;
+	bool bLODActive = false;
+
+	/** Viewpoint scratch, kept for its allocation */
+	TArray<FTransform> Viewpoints;
+};
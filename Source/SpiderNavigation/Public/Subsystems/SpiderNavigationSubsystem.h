@@ -4,16 +4,41 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
 #include "Structs/SpiderNavNode.h"
 #include "Structs/SavedSpiderNavGrid.h"
+#include "Planning/SpiderNavFlowField.h"
+#include "Planning/SpiderNavPathCache.h"
+#include "Structs/SpiderNavPathResult.h"
 #include "SpiderNavigationSubsystem.generated.h"
 
+class UNavGridComponent;
+
 DECLARE_LOG_CATEGORY_EXTERN(SpiderNAVSubsystem_LOG, Log, All);
+
+/** Flow field shared by all agents chasing one target actor */
+struct FSpiderNavFlowFieldEntry
+{
+	TWeakObjectPtr<UNavGridComponent> NavGrid;
+	TWeakObjectPtr<const AActor> Target;
+	FSpiderNavFlowField Field;
+	/** Grid version of the published field and of the running build */
+	uint32 GridVersion = 0;
+	uint32 BuildGridVersion = 0;
+	/** Grid layout both the published field and the running build index into. Any other layout means no field */
+	uint32 GridLayoutVersion = 0;
+	double LastUsedTime = 0.0;
+};
+
 /**
- * 
+ * Loads grids and runs the shared flow fields: one reverse Dijkstra per chased target instead of one search per agent.
+ * Fields are rebuilt in time slices (spider.FlowField.Budget expansions per frame) when the target changes node
+ * or the grid changes, and dropped when no agent asked for them for a few seconds.
+ * Also owns the path cache of every UNavGridComponent (spider.PathCache.Capacity paths each).
  */
 UCLASS()
-class SPIDERNAVIGATION_API USpiderNavigationSubsystem : public UGameInstanceSubsystem
+class SPIDERNAVIGATION_API USpiderNavigationSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 	
@@ -28,8 +53,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SaveGame")
 	FSavedSpiderNavGrid LoadGrid(FString GridSaveName, int32 GridIndex);
 
+	/** Builds the runtime grid from an already loaded save game */
+	static void BuildGrid(const class USpiderNavGridSaveGame* SaveGame, FSavedSpiderNavGrid& OutGrid);
+
+	/** Inverse of BuildGrid, saved indices are the node indices */
+	static class USpiderNavGridSaveGame* CreateSaveGame(const FSavedSpiderNavGrid& Grid);
+
+	/**
+	 * Path from From towards Target along the shared flow field, at most MaxPoints. Registers the field on first use;
+	 * returns false until it is built, if From cannot reach the target or if the field runs into a new obstacle.
+	 * OutPath.bComplete is false if MaxPoints cut the path short
+	 */
+	bool FindFlowFieldPath(UNavGridComponent* NavGrid, const AActor* Target, const FVector& From, FSpiderNavPathResult& OutPath, int32 MaxPoints = 256);
+
+	const FSpiderNavFlowField* GetFlowField(const AActor* Target) const;
+
+	/** Edge from Node of a published flow field of NavGrid towards GoalNode, INDEX_NONE if no agent chases an actor there. Does not check obstacles */
+	int32 FindFlowFieldNextEdge(const UNavGridComponent* NavGrid, int32 Node, int32 GoalNode);
+
+	/** Path cache of NavGrid, nullptr if caching is disabled (spider.PathCache.Capacity 0) */
+	FSpiderNavPathCache* GetPathCache(const UNavGridComponent* NavGrid);
+	void ReleasePathCache(const UNavGridComponent* NavGrid);
+
+	/** Cache hits (exact and suffix) / lookups of NavGrid since its grid was loaded */
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavigation")
+	float GetPathCacheHitRate(const UNavGridComponent* NavGrid) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+
 private:
-	void AddGridNode(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, FVector Location, FVector Normal);
-	void SetGridNodeNeighbors(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, TArray<int32> NeighborsSavedIndexes);
+	/** Resets the field of Entry if SetGrid replaced the grid of NavGrid since the field was started */
+	static void ValidateFlowField(FSpiderNavFlowFieldEntry& Entry, const UNavGridComponent& NavGrid);
+
+	static void AddGridNode(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, FVector Location, FVector Normal);
+	static void SetGridNodeNeighbors(FSavedSpiderNavGrid& SavedGrid, int32 SavedIndex, const TArray<int32>& NeighborsSavedIndexes);
+
+	TMap<FObjectKey, FSpiderNavFlowFieldEntry> FlowFields;
+	TMap<FObjectKey, FSpiderNavPathCache> PathCaches;
 
 };
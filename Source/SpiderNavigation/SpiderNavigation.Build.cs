@@ -39,9 +39,12 @@ public class SpiderNavigation : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"RenderCore",        // Scene proxy of the grid visualizer
+				"RHI",               // Vertex and index buffers of the grid visualizer
 				"AIModule",          // ✅ notwendig für AAIController, BT, Blackboard etc.
 				"GameplayTasks",     // ✅ wenn du Behavior Trees nutzt
-				"NavigationSystem"   // ✅ falls du NavMesh- oder Pathfinding-Features hast
+				"NavigationSystem",  // ✅ falls du NavMesh- oder Pathfinding-Features hast
+				"SignificanceManager" // LOD of the spider controllers
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
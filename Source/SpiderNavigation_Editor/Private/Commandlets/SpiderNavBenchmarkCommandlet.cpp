@@ -0,0 +1,368 @@
+// Copyright Yves Tanas 2025
+
+#include "Commandlets/SpiderNavBenchmarkCommandlet.h"
+#include "Benchmark/SpiderNavSyntheticGrid.h"
+#include "Components/NavGridComponent.h"
+#include "Subsystems/SpiderNavigationSubsystem.h"
+#include "SaveGame/SpiderNavGridSaveGame.h"
+#include "Dom/JsonObject.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSpiderNavBenchmark, Log, All);
+
+namespace SpiderNavBenchmarkPrivate
+{
+	static constexpr int32 REPORT_VERSION = 3;
+
+	/** Query positions are jittered around nodes by this fraction of a step */
+	static constexpr float QUERY_JITTER = 0.3f;
+
+	static double Percentile(const TArray<double>& Sorted, double P)
+	{
+		if (Sorted.Num() == 0)
+			return 0.0;
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+}
+
+USpiderNavBenchmarkCommandlet::USpiderNavBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USpiderNavBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace SpiderNavBenchmarkPrivate;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	TArray<ESpiderNavSyntheticShape> Shapes;
+	const FString ShapeList = ParamVals.FindRef(TEXT("shapes"));
+	if (ShapeList.IsEmpty() || ShapeList.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+	{
+		for (uint8 i = 0; i < (uint8)ESpiderNavSyntheticShape::Num; ++i)
+			Shapes.Add((ESpiderNavSyntheticShape)i);
+	}
+	else
+	{
+		TArray<FString> Names;
+		ShapeList.ParseIntoArray(Names, TEXT(","));
+		for (const FString& Name : Names)
+		{
+			ESpiderNavSyntheticShape Shape;
+			if (!FSpiderNavSyntheticGrid::ParseShape(Name, Shape))
+			{
+				UE_LOG(LogSpiderNavBenchmark, Error, TEXT("Unknown shape '%s'. Expected Caves, StackedFloors, CubeRooms, RandomGeometric or All"), *Name);
+				return 1;
+			}
+			Shapes.Add(Shape);
+		}
+	}
+
+	TArray<int32> Sizes = ParseCounts(ParamVals.Contains(TEXT("nodes")) ? ParamVals[TEXT("nodes")] : TEXT("10000,100000"));
+	if (Sizes.Num() == 0)
+	{
+		UE_LOG(LogSpiderNavBenchmark, Error, TEXT("Invalid -nodes list."));
+		return 1;
+	}
+
+	// Suchmodi werden auf denselben Anfragen verglichen
+	TArray<ESpiderNavSearchMode> Modes;
+	{
+		const UEnum* ModeEnum = StaticEnum<ESpiderNavSearchMode>();
+		TArray<FString> Names;
+		(ParamVals.Contains(TEXT("modes")) ? ParamVals[TEXT("modes")] : FString(TEXT("AStar"))).ParseIntoArray(Names, TEXT(","));
+		for (const FString& Name : Names)
+		{
+			const int64 Value = ModeEnum->GetValueByNameString(Name.TrimStartAndEnd());
+			if (Value == INDEX_NONE)
+			{
+				UE_LOG(LogSpiderNavBenchmark, Error, TEXT("Unknown mode '%s'. Expected AStar, Bidirectional, Weighted or Anytime"), *Name);
+				return 1;
+			}
+			Modes.AddUnique((ESpiderNavSearchMode)Value);
+		}
+	}
+
+	const float Epsilon = ParamVals.Contains(TEXT("epsilon")) ? FMath::Max(1.f, FCString::Atof(*ParamVals[TEXT("epsilon")])) : 2.f;
+	const float DeadlineMs = ParamVals.Contains(TEXT("deadlinems")) ? FMath::Max(0.f, FCString::Atof(*ParamVals[TEXT("deadlinems")])) : 1.f;
+
+	const int32 BatchSize = ParamVals.Contains(TEXT("batch")) ? FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("batch")])) : 50;
+
+	const int32 Queries = ParamVals.Contains(TEXT("queries")) ? FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("queries")])) : 1000;
+	const int32 Loads = ParamVals.Contains(TEXT("loads")) ? FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("loads")])) : 5;
+	const int32 Seed = ParamVals.Contains(TEXT("seed")) ? FCString::Atoi(*ParamVals[TEXT("seed")]) : 1;
+	const float Step = ParamVals.Contains(TEXT("step")) ? FMath::Max(1.f, FCString::Atof(*ParamVals[TEXT("step")])) : 40.f;
+
+	const FString OutPath = ParamVals.Contains(TEXT("out"))
+		? ParamVals[TEXT("out")]
+		: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SpiderNav"), TEXT("Benchmark"), FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString()));
+
+	TArray<TSharedPtr<FJsonValue>> Cases;
+
+	for (const ESpiderNavSyntheticShape Shape : Shapes)
+	{
+		for (const int32 Size : Sizes)
+		{
+			FSpiderNavSyntheticGridParams GridParams;
+			GridParams.Shape = Shape;
+			GridParams.TargetNodes = Size;
+			GridParams.Step = Step;
+			GridParams.Seed = Seed;
+
+			const double GenerateStart = FPlatformTime::Seconds();
+			FSavedSpiderNavGrid Grid;
+			FSpiderNavSyntheticGrid::Generate(GridParams, Grid);
+			const double GenerateMs = (FPlatformTime::Seconds() - GenerateStart) * 1000.0;
+
+			const int32 NumNodes = Grid.NavNodes.Num();
+			const int64 NumEdges = FSpiderNavSyntheticGrid::CountEdges(Grid);
+			const SIZE_T MemoryBytes = Grid.GetAllocatedSize() + sizeof(FSavedSpiderNavGrid);
+			if (NumNodes < 2)
+			{
+				UE_LOG(LogSpiderNavBenchmark, Warning, TEXT("%s/%d produced %d nodes, skipped."), FSpiderNavSyntheticGrid::GetShapeName(Shape), Size, NumNodes);
+				continue;
+			}
+
+			// LoadGrid: Save-Game aus dem Speicher deserialisieren + Laufzeit-Grid aufbauen, ohne Slot auf der Platte
+			TArray<uint8> SaveBytes;
+			UGameplayStatics::SaveGameToMemory(USpiderNavigationSubsystem::CreateSaveGame(Grid), SaveBytes);
+
+			TArray<double> LoadSamples;
+			for (int32 i = 0; i < Loads; ++i)
+			{
+				const double Start = FPlatformTime::Seconds();
+				FSavedSpiderNavGrid Loaded;
+				USpiderNavigationSubsystem::BuildGrid(Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromMemory(SaveBytes)), Loaded);
+				LoadSamples.Add((FPlatformTime::Seconds() - Start) * 1e6);
+			}
+
+			UNavGridComponent* Navigation = NewObject<UNavGridComponent>(GetTransientPackage());
+			Navigation->SetGrid(MoveTemp(Grid));
+			const FSavedSpiderNavGrid& Loaded = Navigation->GetLoadedGrid();
+
+			// Gleiche Anfragen für jede Engine-Version -> Ergebnisse vergleichbar
+			FRandomStream Random(Seed);
+			auto RandomQueryLocation = [&Random, &Loaded, Step]()
+				{
+					const FVector& Node = Loaded.NavNodes[Random.RandHelper(Loaded.NavNodes.Num())].Location;
+					return Node + Random.GetUnitVector() * (Step * QUERY_JITTER);
+				};
+
+			TArray<FVector> Starts;
+			TArray<FVector> Ends;
+			TArray<double> ClosestSamples;
+			ClosestSamples.Reserve(Queries);
+			for (int32 i = 0; i < Queries; ++i)
+			{
+				Starts.Add(RandomQueryLocation());
+				Ends.Add(RandomQueryLocation());
+
+				const double T0 = FPlatformTime::Seconds();
+				Navigation->FindClosestNodeLocation_Implementation(Starts[i]);
+				ClosestSamples.Add((FPlatformTime::Seconds() - T0) * 1e6);
+			}
+
+			TArray<TSharedPtr<FJsonValue>> ModeResults;
+			TArray<double> PathSamples;
+			int32 CompletePaths = 0;
+			int64 PathNodes = 0;
+
+			for (const ESpiderNavSearchMode Mode : Modes)
+			{
+				FSpiderNavQueryParams QueryParams;
+				QueryParams.Mode = Mode;
+				QueryParams.Epsilon = Epsilon;
+				QueryParams.DeadlineMs = DeadlineMs;
+
+				TArray<double> ModeSamples;
+				ModeSamples.Reserve(Queries);
+				int32 ModeComplete = 0;
+				int64 ModeNodes = 0;
+				int64 ModeExpansions = 0;
+
+				for (int32 i = 0; i < Queries; ++i)
+				{
+					bool bComplete = false;
+					const double T0 = FPlatformTime::Seconds();
+					const TArray<FVector> Path = Navigation->FindPathWithParams(Starts[i], Ends[i], QueryParams, bComplete);
+					ModeSamples.Add((FPlatformTime::Seconds() - T0) * 1e6);
+
+					ModeComplete += bComplete ? 1 : 0;
+					ModeNodes += Path.Num();
+					ModeExpansions += Navigation->GetLastSearchStats().Expansions;
+				}
+
+				// Dieselben Anfragen als FindPathsBatch: zufällige Paare und Wellen mit gemeinsamem Ziel, Zeit pro Anfrage
+				TArray<double> BatchSamples;
+				TArray<double> WaveSamples;
+				TArray<FSpiderNavPathQuery> BatchQueries;
+				TArray<FSpiderNavPathQuery> WaveQueries;
+				TArray<FSpiderNavPathResult> BatchResults;
+				for (int32 First = 0; First < Queries; First += BatchSize)
+				{
+					const int32 Count = FMath::Min(BatchSize, Queries - First);
+					BatchQueries.Reset();
+					WaveQueries.Reset();
+					for (int32 i = First; i < First + Count; ++i)
+					{
+						BatchQueries.Add({ Starts[i], Ends[i] });
+						WaveQueries.Add({ Starts[i], Ends[First] });
+					}
+
+					double T0 = FPlatformTime::Seconds();
+					Navigation->FindPathsBatch(BatchQueries, QueryParams, BatchResults);
+					BatchSamples.Add((FPlatformTime::Seconds() - T0) * 1e6 / Count);
+
+					T0 = FPlatformTime::Seconds();
+					Navigation->FindPathsBatch(WaveQueries, QueryParams, BatchResults);
+					WaveSamples.Add((FPlatformTime::Seconds() - T0) * 1e6 / Count);
+				}
+
+				ModeSamples.Sort();
+				BatchSamples.Sort();
+				WaveSamples.Sort();
+				const FString ModeName = StaticEnum<ESpiderNavSearchMode>()->GetNameStringByValue((int64)Mode);
+				UE_LOG(LogSpiderNavBenchmark, Display, TEXT("%-16s %8d nodes %-13s | path p50 %9.1f us p99 %9.1f us | %9.1f expansions/query | batch p50 %9.1f us/query, wave p50 %9.1f us/query"),
+					FSpiderNavSyntheticGrid::GetShapeName(Shape), NumNodes, *ModeName,
+					Percentile(ModeSamples, 0.5), Percentile(ModeSamples, 0.99), (double)ModeExpansions / Queries,
+					Percentile(BatchSamples, 0.5), Percentile(WaveSamples, 0.5));
+
+				TSharedRef<FJsonObject> ModeResult = MakeShared<FJsonObject>();
+				ModeResult->SetStringField(TEXT("mode"), ModeName);
+				ModeResult->SetNumberField(TEXT("completePaths"), ModeComplete);
+				ModeResult->SetNumberField(TEXT("meanPathNodes"), (double)ModeNodes / Queries);
+				ModeResult->SetNumberField(TEXT("meanExpansions"), (double)ModeExpansions / Queries);
+				ModeResult->SetObjectField(TEXT("findPathUs"), MakePercentiles(ModeSamples));
+				ModeResult->SetNumberField(TEXT("batchSize"), BatchSize);
+				ModeResult->SetObjectField(TEXT("batchPerQueryUs"), MakePercentiles(BatchSamples));
+				ModeResult->SetObjectField(TEXT("wavePerQueryUs"), MakePercentiles(WaveSamples));
+				ModeResults.Add(MakeShared<FJsonValueObject>(ModeResult));
+
+				// Erster Modus füllt die bisherigen Felder des Berichts
+				if (ModeResults.Num() == 1)
+				{
+					PathSamples = ModeSamples;
+					CompletePaths = ModeComplete;
+					PathNodes = ModeNodes;
+				}
+			}
+
+			Navigation->SetGrid(FSavedSpiderNavGrid());
+			Navigation->MarkAsGarbage();
+
+			TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+			Case->SetStringField(TEXT("shape"), FSpiderNavSyntheticGrid::GetShapeName(Shape));
+			Case->SetNumberField(TEXT("targetNodes"), Size);
+			Case->SetNumberField(TEXT("nodes"), NumNodes);
+			Case->SetNumberField(TEXT("edges"), (double)NumEdges);
+			Case->SetNumberField(TEXT("memoryBytes"), (double)MemoryBytes);
+			Case->SetNumberField(TEXT("saveBytes"), SaveBytes.Num());
+			Case->SetNumberField(TEXT("generateMs"), GenerateMs);
+			Case->SetNumberField(TEXT("completePaths"), CompletePaths);
+			Case->SetNumberField(TEXT("meanPathNodes"), (double)PathNodes / Queries);
+			Case->SetObjectField(TEXT("loadGridUs"), MakePercentiles(LoadSamples));
+			Case->SetObjectField(TEXT("findClosestNodeUs"), MakePercentiles(ClosestSamples));
+			Case->SetObjectField(TEXT("findPathUs"), MakePercentiles(PathSamples));
+			Case->SetArrayField(TEXT("modes"), ModeResults);
+			Cases.Add(MakeShared<FJsonValueObject>(Case));
+
+			UE_LOG(LogSpiderNavBenchmark, Display, TEXT("%-16s %8d nodes %10lld edges %8.1f MB | load p50 %9.0f us | closest p50 %7.1f us p99 %7.1f us | path p50 %9.1f us p99 %9.1f us | complete %d/%d"),
+				FSpiderNavSyntheticGrid::GetShapeName(Shape), NumNodes, NumEdges, MemoryBytes / (1024.0 * 1024.0),
+				Percentile(LoadSamples, 0.5),
+				Percentile(ClosestSamples, 0.5), Percentile(ClosestSamples, 0.99),
+				Percentile(PathSamples, 0.5), Percentile(PathSamples, 0.99),
+				CompletePaths, Queries);
+
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("version"), REPORT_VERSION);
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Report->SetNumberField(TEXT("seed"), Seed);
+	Report->SetNumberField(TEXT("step"), Step);
+	Report->SetNumberField(TEXT("queries"), Queries);
+	Report->SetNumberField(TEXT("loads"), Loads);
+	Report->SetNumberField(TEXT("epsilon"), Epsilon);
+	Report->SetNumberField(TEXT("deadlineMs"), DeadlineMs);
+	Report->SetArrayField(TEXT("cases"), Cases);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutPath))
+	{
+		UE_LOG(LogSpiderNavBenchmark, Error, TEXT("Could not write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogSpiderNavBenchmark, Display, TEXT("Report written to %s"), *OutPath);
+	return 0;
+}
+
+TSharedRef<FJsonObject> USpiderNavBenchmarkCommandlet::MakePercentiles(TArray<double>& Samples)
+{
+	using namespace SpiderNavBenchmarkPrivate;
+
+	Samples.Sort();
+
+	double Sum = 0.0;
+	for (const double Sample : Samples)
+		Sum += Sample;
+
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetNumberField(TEXT("count"), Samples.Num());
+	Object->SetNumberField(TEXT("p50"), Percentile(Samples, 0.5));
+	Object->SetNumberField(TEXT("p90"), Percentile(Samples, 0.9));
+	Object->SetNumberField(TEXT("p99"), Percentile(Samples, 0.99));
+	Object->SetNumberField(TEXT("max"), Samples.Num() > 0 ? Samples.Last() : 0.0);
+	Object->SetNumberField(TEXT("mean"), Samples.Num() > 0 ? Sum / Samples.Num() : 0.0);
+	return Object;
+}
+
+TArray<int32> USpiderNavBenchmarkCommandlet::ParseCounts(const FString& Text)
+{
+	TArray<FString> Parts;
+	Text.ParseIntoArray(Parts, TEXT(","));
+
+	TArray<int32> Counts;
+	for (FString Part : Parts)
+	{
+		Part.TrimStartAndEndInline();
+		int64 Multiplier = 1;
+		if (Part.EndsWith(TEXT("k"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1000;
+			Part.LeftChopInline(1);
+		}
+		else if (Part.EndsWith(TEXT("m"), ESearchCase::IgnoreCase))
+		{
+			Multiplier = 1000000;
+			Part.LeftChopInline(1);
+		}
+
+		const int64 Count = (int64)(FCString::Atod(*Part) * Multiplier);
+		if (Count > 0 && Count <= MAX_int32)
+			Counts.Add((int32)Count);
+	}
+	return Counts;
+}
@@ -0,0 +1,276 @@
+// Copyright Yves Tanas 2025
+
+#include "Commandlets/SpiderNavBuildCommandlet.h"
+#include "EditorUtility/SpiderNavGridBuilder.h"
+#include "EditorUtility/SpiderNavBuildJob.h"
+#include "EditorUtility/SpiderNavBuildReport.h"
+#include "Actors/SpiderNavGridBuilderVolume.h"
+#include "SaveGame/SpiderNavGridSaveGame.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/DefaultValueHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSpiderNavBuild, Log, All);
+
+USpiderNavBuildCommandlet::USpiderNavBuildCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USpiderNavBuildCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const FString MapName = ParamVals.FindRef(TEXT("map"));
+	if (MapName.IsEmpty())
+	{
+		UE_LOG(LogSpiderNavBuild, Error, TEXT("Missing -map=<Map>. Usage: -run=SpiderNavBuild -map=/Game/Maps/MyMap [-volume=Name] [-slot=Slot] [-step=40] [-<Tunable>=Value] [-dirty=MinX,MinY,MinZ,MaxX,MaxY,MaxZ] [-force]"));
+		return 1;
+	}
+
+	UWorld* World = LoadWorld(MapName);
+	if (!World)
+	{
+		UE_LOG(LogSpiderNavBuild, Error, TEXT("Could not load map %s"), *MapName);
+		return 1;
+	}
+
+	// Tear the world down on every exit, otherwise its physics scene and components outlive the build
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	ASpiderNavGridBuilderVolume* Volume = FindVolume(World, ParamVals.FindRef(TEXT("volume")));
+	if (!Volume)
+	{
+		UE_LOG(LogSpiderNavBuild, Error, TEXT("No ASpiderNavGridBuilderVolume found in %s"), *MapName);
+		return 1;
+	}
+
+	// Volle Parallelität, kein Throttling, kein Debug-Draw
+	FSpiderNavBuildSettings Settings;
+	ApplySettingsOverrides(ParamVals, Settings);
+	FSpiderNavGridBuilder::CaptureVolume(Volume, Settings);
+	Settings.ThrottleSleepSeconds = 0.f;
+	Settings.bDebugDraw = false;
+
+	UE_LOG(LogSpiderNavBuild, Display, TEXT("Building spider grid: Map=%s Volume=%s Step=%.1f Bounce=%.2f Trace=%.2f ClosePoints=%.2f Connection=%.2f EdgeTrace=%.2f EdgeDeviation=%.2f RelationCell=%.2f"),
+		*MapName, *Volume->GetName(), Settings.GridStepSize, Settings.BounceNavDistance, Settings.TraceDistanceModificator,
+		Settings.ClosePointsFilterModificator, Settings.ConnectionSphereRadiusModificator, Settings.TraceDistanceForEdgesModificator,
+		Settings.EgdeDeviationModificator, Settings.RelationCellMultiplier);
+
+	const double BuildStart = FPlatformTime::Seconds();
+
+	// Nur für die Trace-Zählung im Build-Report
+	FSpiderNavBuildControl Control;
+	FSpiderNavGridBuilder Builder(World, Settings, Volume);
+	Builder.SetControl(&Control);
+	TArray<FSpiderNavNodeBuilder> Nodes;
+	TArray<FSpiderNavBuildStageStats> Stages;
+
+	const FString SlotName = ParamVals.Contains(TEXT("slot"))
+		? ParamVals[TEXT("slot")]
+		: GetDefault<USpiderNavGridSaveGame>()->SaveSlotName;
+
+	FBox DirtyBox(ForceInit);
+	if (const FString* Dirty = ParamVals.Find(TEXT("dirty")))
+	{
+		if (!ParseBox(*Dirty, DirtyBox))
+		{
+			UE_LOG(LogSpiderNavBuild, Error, TEXT("Invalid -dirty=%s. Expected MinX,MinY,MinZ,MaxX,MaxY,MaxZ"), **Dirty);
+			return 1;
+		}
+	}
+
+	USpiderNavGridSaveGame* Existing =
+		Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, GetDefault<USpiderNavGridSaveGame>()->UserIndex));
+
+	FSpiderNavGeometrySnapshot Geometry;
+	Builder.CaptureGeometry(FSpiderNavGridBuilder::GetVolumeBounds(Volume), Geometry);
+	const FString InputHash = Builder.ComputeInputHash(Volume, Geometry);
+	UE_LOG(LogSpiderNavBuild, Display, TEXT("Input hash %s"), *InputHash);
+
+	const bool bForce = Switches.Contains(TEXT("force"));
+	if (!bForce && Existing && Existing->InputHash == InputHash)
+	{
+		UE_LOG(LogSpiderNavBuild, Display, TEXT("Slot '%s' is up to date – nothing to build. Use -force to rebuild."), *SlotName);
+		return 0;
+	}
+
+	// Patched grids are stamped with a marked hash so a later full build with the same inputs still runs
+	FString SavedHash = InputHash;
+	if (DirtyBox.IsValid && FSpiderNavGridBuilder::ReadSaveGame(Existing, Nodes))
+	{
+		SavedHash = FSpiderNavGridBuilder::MakePartialInputHash(InputHash);
+		// Inkrementell: nur die Region um die Dirty-Box neu erzeugen
+		const FSpiderNavBuildStageTimer Timer(&Control);
+		const FSpiderNavIncrementalStats Incremental = Builder.RebuildRegion(DirtyBox, Nodes);
+		UE_LOG(LogSpiderNavBuild, Display, TEXT("Incremental rebuild %s: -%d +%d nodes, %d relinked, +%lld edges."),
+			*Incremental.Region.ToString(), Incremental.RemovedNodes, Incremental.AddedNodes, Incremental.RelinkedNodes, Incremental.EdgesAdded);
+
+		FSpiderNavBuildStageStats& Stage = Stages.AddDefaulted_GetRef();
+		Stage.Name = TEXT("Incremental");
+		Timer.Finish(Stage);
+		Stage.NodesOut = Nodes.Num();
+		Stage.EdgesOut = FSpiderNavGridBuilder::CountEdges(Nodes);
+	}
+	else
+	{
+		if (DirtyBox.IsValid)
+			UE_LOG(LogSpiderNavBuild, Warning, TEXT("No existing grid in slot '%s' – running full build."), *SlotName);
+
+		// Checkpoints nach jeder Stage: ein abgebrochener Lauf mit gleichen Eingaben setzt dort wieder auf
+		FSpiderNavBuildJob Job(World, Settings, Volume, InputHash);
+		Job.Run();
+		if (Job.GetState() != ESpiderNavBuildJobState::Succeeded)
+		{
+			UE_LOG(LogSpiderNavBuild, Error, TEXT("Build failed in stage %s."), FSpiderNavBuildJob::GetStageName(Job.GetCurrentStage()));
+			return 1;
+		}
+		if (Job.GetResumedStage() != ESpiderNavBuildStage::Lattice)
+			UE_LOG(LogSpiderNavBuild, Display, TEXT("Resumed from checkpoint at stage %s."), FSpiderNavBuildJob::GetStageName(Job.GetResumedStage()));
+
+		Nodes = MoveTemp(Job.GetNodes());
+		Stages = Job.GetStageStats();
+	}
+
+	const FSpiderNavBuildStageTimer SaveTimer;
+	USpiderNavGridSaveGame* Save = FSpiderNavGridBuilder::CreateSaveGame(Nodes, SavedHash);
+	bool bSaved = false;
+	if (Save)
+	{
+		bSaved = UGameplayStatics::SaveGameToSlot(Save, SlotName, Save->UserIndex);
+		if (bSaved)
+			FSpiderNavBuildJob::DiscardCheckpoints(SavedHash);
+		UE_LOG(LogSpiderNavBuild, Display, TEXT("Save slot '%s': %s"), *SlotName, bSaved ? TEXT("SUCCESS") : TEXT("FAILED"));
+	}
+
+	FSpiderNavBuildStageStats& SaveStage = Stages.AddDefaulted_GetRef();
+	SaveStage.Name = TEXT("Save");
+	SaveTimer.Finish(SaveStage);
+	SaveStage.NodesOut = Nodes.Num();
+	SaveStage.EdgesOut = FSpiderNavGridBuilder::CountEdges(Nodes);
+
+	TArray<FString> ReportLines;
+	FSpiderNavBuildReport::ToText(Stages).ParseIntoArrayLines(ReportLines);
+	for (const FString& Line : ReportLines)
+	{
+		UE_LOG(LogSpiderNavBuild, Display, TEXT("  %s"), *Line);
+	}
+	if (bSaved && FSpiderNavBuildReport::Write(SlotName, SavedHash, Stages))
+		UE_LOG(LogSpiderNavBuild, Display, TEXT("Build report: %s"), *FSpiderNavBuildReport::GetReportPath(SlotName));
+	UE_LOG(LogSpiderNavBuild, Display, TEXT("Total %.3f s. %d nodes, %lld edges. Output %s"),
+		FPlatformTime::Seconds() - BuildStart, Nodes.Num(), SaveStage.EdgesOut, *FSpiderNavGridBuilder::ComputeOutputHash(Nodes));
+
+	return bSaved ? 0 : 1;
+}
+
+UWorld* USpiderNavBuildCommandlet::LoadWorld(const FString& MapName) const
+{
+	FString PackageName = MapName;
+	if (!FPackageName::IsValidLongPackageName(PackageName) &&
+		!FPackageName::SearchForPackageOnDisk(MapName, &PackageName))
+	{
+		return nullptr;
+	}
+
+	UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+		return nullptr;
+
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		// Nur Kollision wird benötigt – keine Navigation, AI, Audio oder Hit-Proxies
+		World->WorldType = EWorldType::Editor;
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.SetTransactional(false)
+			.CreateFXSystem(false));
+	}
+
+	World->UpdateWorldComponents(true, false);
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+	return World;
+}
+
+void USpiderNavBuildCommandlet::ApplySettingsOverrides(const TMap<FString, FString>& ParamVals, FSpiderNavBuildSettings& Settings)
+{
+	// Alle Tunables, die in den Input-Hash eingehen; Namen wie die Properties des Builder-Widgets
+	const TPair<const TCHAR*, float*> Tunables[] = {
+		{ TEXT("step"), &Settings.GridStepSize },
+		{ TEXT("GridStepSize"), &Settings.GridStepSize },
+		{ TEXT("BounceNavDistance"), &Settings.BounceNavDistance },
+		{ TEXT("TraceDistanceModificator"), &Settings.TraceDistanceModificator },
+		{ TEXT("ClosePointsFilterModificator"), &Settings.ClosePointsFilterModificator },
+		{ TEXT("ConnectionSphereRadiusModificator"), &Settings.ConnectionSphereRadiusModificator },
+		{ TEXT("TraceDistanceForEdgesModificator"), &Settings.TraceDistanceForEdgesModificator },
+		{ TEXT("EgdeDeviationModificator"), &Settings.EgdeDeviationModificator },
+		{ TEXT("RelationCellMultiplier"), &Settings.RelationCellMultiplier },
+	};
+
+	for (const TPair<const TCHAR*, float*>& Tunable : Tunables)
+	{
+		// ParseCommandLine behält die Groß-/Kleinschreibung der Schlüssel
+		for (const TPair<FString, FString>& Param : ParamVals)
+		{
+			if (Param.Key.Equals(Tunable.Key, ESearchCase::IgnoreCase))
+			{
+				*Tunable.Value = FCString::Atof(*Param.Value);
+			}
+		}
+	}
+	Settings.GridStepSize = FMath::Max(1.f, Settings.GridStepSize);
+}
+
+bool USpiderNavBuildCommandlet::ParseBox(const FString& Text, FBox& OutBox)
+{
+	TArray<FString> Parts;
+	Text.ParseIntoArray(Parts, TEXT(","));
+	if (Parts.Num() != 6)
+		return false;
+
+	double Values[6];
+	for (int32 i = 0; i < 6; ++i)
+	{
+		// Atod would read "abc" as 0 and silently rebuild the wrong region
+		if (!FDefaultValueHelper::ParseDouble(Parts[i], Values[i]))
+			return false;
+	}
+
+	const FVector Min(Values[0], Values[1], Values[2]);
+	const FVector Max(Values[3], Values[4], Values[5]);
+	OutBox = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+	return true;
+}
+
+ASpiderNavGridBuilderVolume* USpiderNavBuildCommandlet::FindVolume(UWorld* World, const FString& VolumeName) const
+{
+	for (TActorIterator<ASpiderNavGridBuilderVolume> It(World); It; ++It)
+	{
+		if (VolumeName.IsEmpty() || It->GetName() == VolumeName || It->GetActorLabel() == VolumeName)
+		{
+			return *It;
+		}
+	}
+	return nullptr;
+}
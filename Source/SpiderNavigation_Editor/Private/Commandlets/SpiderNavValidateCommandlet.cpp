@@ -0,0 +1,407 @@
+// Copyright Yves Tanas 2025
+
+#include "Commandlets/SpiderNavValidateCommandlet.h"
+#include "Commandlets/SpiderNavBenchmarkCommandlet.h"
+#include "Benchmark/SpiderNavSyntheticGrid.h"
+#include "Components/NavGridComponent.h"
+#include "Subsystems/SpiderNavigationSubsystem.h"
+#include "SaveGame/SpiderNavGridSaveGame.h"
+#include "Dom/JsonObject.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSpiderNavValidate, Log, All);
+
+namespace SpiderNavValidatePrivate
+{
+	static constexpr int32 REPORT_VERSION = 1;
+
+	/** Float G values in the search vs. double reference */
+	static constexpr double RELATIVE_TOLERANCE = 1e-4;
+	static constexpr double ABSOLUTE_TOLERANCE = 1e-2;
+
+	/** Failures logged per engine and grid, the rest is only counted */
+	static constexpr int32 MAX_LOGGED_FAILURES = 10;
+
+	struct FHeapEntry
+	{
+		double Cost;
+		int32 Node;
+
+		bool operator<(const FHeapEntry& Other) const { return Cost < Other.Cost; }
+	};
+
+	struct FEngineResult
+	{
+		int32 Failures = 0;
+		int32 Complete = 0;
+		int32 Partial = 0;
+		double WorstRatio = 1.0;
+		int64 Expansions = 0;
+		TArray<double> TimeUs;
+	};
+}
+
+USpiderNavValidateCommandlet::USpiderNavValidateCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+TArray<FSpiderNavValidationEngine> USpiderNavValidateCommandlet::GetEngines()
+{
+	TArray<FSpiderNavValidationEngine> Engines;
+
+	FSpiderNavValidationEngine& AStar = Engines.AddDefaulted_GetRef();
+	AStar.Name = TEXT("AStar");
+	AStar.Epsilon = 0.f;
+	AStar.FindPath = [](UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)
+		{
+			return Navigation.FindPath(Start, End, bFoundCompletePath);
+		};
+
+	FSpiderNavValidationEngine& Bidirectional = Engines.AddDefaulted_GetRef();
+	Bidirectional.Name = TEXT("Bidirectional");
+	Bidirectional.Epsilon = 0.f;
+	Bidirectional.FindPath = [](UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)
+		{
+			FSpiderNavQueryParams Params;
+			Params.Mode = ESpiderNavSearchMode::Bidirectional;
+			return Navigation.FindPathWithParams(Start, End, Params, bFoundCompletePath);
+		};
+
+	// Gewichtete Modi: Kosten <= Gewicht * Optimum
+	static constexpr float WEIGHT = 2.f;
+
+	FSpiderNavValidationEngine& Weighted = Engines.AddDefaulted_GetRef();
+	Weighted.Name = TEXT("Weighted");
+	Weighted.Epsilon = WEIGHT - 1.f;
+	Weighted.FindPath = [](UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)
+		{
+			FSpiderNavQueryParams Params;
+			Params.Mode = ESpiderNavSearchMode::Weighted;
+			Params.Epsilon = WEIGHT;
+			return Navigation.FindPathWithParams(Start, End, Params, bFoundCompletePath);
+		};
+
+	// Deadline 0: nur der erste Durchlauf, also die schwächste Schranke
+	FSpiderNavValidationEngine& Anytime = Engines.AddDefaulted_GetRef();
+	Anytime.Name = TEXT("Anytime");
+	Anytime.Epsilon = WEIGHT - 1.f;
+	Anytime.FindPath = [](UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)
+		{
+			FSpiderNavQueryParams Params;
+			Params.Mode = ESpiderNavSearchMode::Anytime;
+			Params.Epsilon = WEIGHT;
+			Params.DeadlineMs = 0.f;
+			return Navigation.FindPathWithParams(Start, End, Params, bFoundCompletePath);
+		};
+
+	// Dieselbe Anfrage mehrfach im Batch: gemeinsames Ziel -> Rückwärts-Dijkstra der Gruppe statt Einzelsuche
+	FSpiderNavValidationEngine& Batch = Engines.AddDefaulted_GetRef();
+	Batch.Name = TEXT("BatchGroup");
+	Batch.Epsilon = 0.f;
+	Batch.FindPath = [](UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)
+		{
+			static constexpr int32 GROUP_SIZE = 4;
+			TArray<FSpiderNavPathQuery> Queries;
+			Queries.Init({ Start, End }, GROUP_SIZE);
+			TArray<FSpiderNavPathResult> Results;
+			Navigation.FindPathsBatch(Queries, FSpiderNavQueryParams(), Results);
+			bFoundCompletePath = Results[0].bComplete;
+			return Results[0].Locations;
+		};
+
+	return Engines;
+}
+
+double USpiderNavValidateCommandlet::ReferenceDijkstra(const FSavedSpiderNavGrid& Grid, int32 Start, int32 Goal)
+{
+	using namespace SpiderNavValidatePrivate;
+
+	TArray<double> Dist;
+	Dist.Init(TNumericLimits<double>::Max(), Grid.NavNodes.Num());
+
+	// TArray-Heaps sind Min-Heaps bzgl. operator<
+	TArray<FHeapEntry> Heap;
+	Dist[Start] = 0.0;
+	Heap.HeapPush({ 0.0, Start });
+
+	while (Heap.Num() > 0)
+	{
+		FHeapEntry Top;
+		Heap.HeapPop(Top);
+		if (Top.Cost > Dist[Top.Node])
+			continue;
+		if (Top.Node == Goal)
+			return Top.Cost;
+
+		const FSpiderNavNode& Node = Grid.NavNodes[Top.Node];
+		for (const FSpiderNavNode* Neighbor : Node.Neighbors)
+		{
+			const double Cost = Top.Cost + FVector::Dist(Node.Location, Neighbor->Location);
+			if (Cost < Dist[Neighbor->Index])
+			{
+				Dist[Neighbor->Index] = Cost;
+				Heap.HeapPush({ Cost, Neighbor->Index });
+			}
+		}
+	}
+	return -1.0;
+}
+
+int32 USpiderNavValidateCommandlet::Main(const FString& Params)
+{
+	using namespace SpiderNavValidatePrivate;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	TArray<ESpiderNavSyntheticShape> Shapes;
+	const FString ShapeList = ParamVals.FindRef(TEXT("shapes"));
+	if (ShapeList.IsEmpty() || ShapeList.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+	{
+		for (uint8 i = 0; i < (uint8)ESpiderNavSyntheticShape::Num; ++i)
+			Shapes.Add((ESpiderNavSyntheticShape)i);
+	}
+	else if (!ShapeList.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+	{
+		TArray<FString> Names;
+		ShapeList.ParseIntoArray(Names, TEXT(","));
+		for (const FString& Name : Names)
+		{
+			ESpiderNavSyntheticShape Shape;
+			if (!FSpiderNavSyntheticGrid::ParseShape(Name, Shape))
+			{
+				UE_LOG(LogSpiderNavValidate, Error, TEXT("Unknown shape '%s'."), *Name);
+				return 1;
+			}
+			Shapes.Add(Shape);
+		}
+	}
+
+	const TArray<int32> Sizes = USpiderNavBenchmarkCommandlet::ParseCounts(ParamVals.Contains(TEXT("nodes")) ? ParamVals[TEXT("nodes")] : TEXT("20000"));
+	const int32 Pairs = ParamVals.Contains(TEXT("pairs")) ? FMath::Max(1, FCString::Atoi(*ParamVals[TEXT("pairs")])) : 500;
+	const int32 Seed = ParamVals.Contains(TEXT("seed")) ? FCString::Atoi(*ParamVals[TEXT("seed")]) : 1;
+
+	const FString OutPath = ParamVals.Contains(TEXT("out"))
+		? ParamVals[TEXT("out")]
+		: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SpiderNav"), TEXT("Validation"), FString::Printf(TEXT("Validation-%s.json"), *FDateTime::Now().ToString()));
+
+	TArray<TSharedPtr<FJsonValue>> Grids;
+	int32 TotalFailures = 0;
+
+	for (const ESpiderNavSyntheticShape Shape : Shapes)
+	{
+		for (const int32 Size : Sizes)
+		{
+			FSpiderNavSyntheticGridParams GridParams;
+			GridParams.Shape = Shape;
+			GridParams.TargetNodes = Size;
+			GridParams.Seed = Seed;
+
+			FSavedSpiderNavGrid Grid;
+			FSpiderNavSyntheticGrid::Generate(GridParams, Grid);
+
+			int32 Failures = 0;
+			const FString GridName = FString::Printf(TEXT("%s/%d"), FSpiderNavSyntheticGrid::GetShapeName(Shape), Size);
+			Grids.Add(MakeShared<FJsonValueObject>(ValidateGrid(GridName, MoveTemp(Grid), Pairs, Seed, Failures)));
+			TotalFailures += Failures;
+		}
+	}
+
+	if (const FString* Slot = ParamVals.Find(TEXT("slot")))
+	{
+		const USpiderNavGridSaveGame* SaveGame =
+			Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromSlot(*Slot, GetDefault<USpiderNavGridSaveGame>()->UserIndex));
+		if (!SaveGame)
+		{
+			UE_LOG(LogSpiderNavValidate, Error, TEXT("Could not load save slot '%s'."), **Slot);
+			return 1;
+		}
+
+		FSavedSpiderNavGrid Grid;
+		USpiderNavigationSubsystem::BuildGrid(SaveGame, Grid);
+
+		int32 Failures = 0;
+		Grids.Add(MakeShared<FJsonValueObject>(ValidateGrid(FString::Printf(TEXT("Slot/%s"), **Slot), MoveTemp(Grid), Pairs, Seed, Failures)));
+		TotalFailures += Failures;
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("version"), REPORT_VERSION);
+	Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("seed"), Seed);
+	Report->SetNumberField(TEXT("pairs"), Pairs);
+	Report->SetNumberField(TEXT("failures"), TotalFailures);
+	Report->SetArrayField(TEXT("grids"), Grids);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(Json, *OutPath))
+		UE_LOG(LogSpiderNavValidate, Warning, TEXT("Could not write %s"), *OutPath);
+
+	UE_LOG(LogSpiderNavValidate, Display, TEXT("Validation %s: %d failures. Report %s"),
+		TotalFailures == 0 ? TEXT("PASSED") : TEXT("FAILED"), TotalFailures, *OutPath);
+	return TotalFailures == 0 ? 0 : 1;
+}
+
+TSharedRef<FJsonObject> USpiderNavValidateCommandlet::ValidateGrid(const FString& GridName, FSavedSpiderNavGrid&& Grid, int32 Pairs, int32 Seed, int32& OutFailures) const
+{
+	using namespace SpiderNavValidatePrivate;
+
+	OutFailures = 0;
+	TSharedRef<FJsonObject> GridReport = MakeShared<FJsonObject>();
+	GridReport->SetStringField(TEXT("grid"), GridName);
+	GridReport->SetNumberField(TEXT("nodes"), Grid.NavNodes.Num());
+
+	if (Grid.NavNodes.Num() < 2)
+	{
+		UE_LOG(LogSpiderNavValidate, Warning, TEXT("%s: fewer than two nodes, skipped."), *GridName);
+		return GridReport;
+	}
+
+	// Pfadpunkte zurück auf Knoten abbilden
+	TMap<FVector, int32> LocationToIndex;
+	LocationToIndex.Reserve(Grid.NavNodes.Num());
+	for (const FSpiderNavNode& Node : Grid.NavNodes)
+		LocationToIndex.FindOrAdd(Node.Location, Node.Index);
+
+	// Gleiche Paare und Referenzkosten für alle Engines
+	FRandomStream Random(Seed);
+	TArray<FIntPoint> Queries;
+	TArray<double> ReferenceCosts;
+	int32 Unreachable = 0;
+	for (int32 i = 0; i < Pairs; ++i)
+	{
+		const FIntPoint& Query = Queries.Emplace_GetRef(Random.RandHelper(Grid.NavNodes.Num()), Random.RandHelper(Grid.NavNodes.Num()));
+		ReferenceCosts.Add(ReferenceDijkstra(Grid, Query.X, Query.Y));
+		Unreachable += ReferenceCosts.Last() < 0.0 ? 1 : 0;
+	}
+	GridReport->SetNumberField(TEXT("unreachablePairs"), Unreachable);
+
+	UNavGridComponent* Navigation = NewObject<UNavGridComponent>(GetTransientPackage());
+	Navigation->SetGrid(MoveTemp(Grid));
+	const FSavedSpiderNavGrid& Loaded = Navigation->GetLoadedGrid();
+
+	TArray<TSharedPtr<FJsonValue>> EngineReports;
+	for (const FSpiderNavValidationEngine& Engine : GetEngines())
+	{
+		FEngineResult Result;
+		Result.TimeUs.Reserve(Pairs);
+
+		auto Fail = [&](int32 QueryIndex, const TCHAR* Reason)
+			{
+				if (Result.Failures++ < MAX_LOGGED_FAILURES)
+				{
+					UE_LOG(LogSpiderNavValidate, Error, TEXT("%s %s: pair %d (%d -> %d, reference %.2f): %s"),
+						*GridName, *Engine.Name, QueryIndex, Queries[QueryIndex].X, Queries[QueryIndex].Y, ReferenceCosts[QueryIndex], Reason);
+				}
+			};
+
+		for (int32 q = 0; q < Queries.Num(); ++q)
+		{
+			const int32 StartIndex = Queries[q].X;
+			const int32 GoalIndex = Queries[q].Y;
+			const double Reference = ReferenceCosts[q];
+
+			bool bComplete = false;
+			const double T0 = FPlatformTime::Seconds();
+			const TArray<FVector> Path = Engine.FindPath(*Navigation, Loaded.NavNodes[StartIndex].Location, Loaded.NavNodes[GoalIndex].Location, bComplete);
+			Result.TimeUs.Add((FPlatformTime::Seconds() - T0) * 1e6);
+			Result.Expansions += Navigation->GetLastSearchStats().Expansions;
+
+			if (Path.Num() == 0)
+			{
+				Fail(q, TEXT("empty path"));
+				continue;
+			}
+
+			// Kette prüfen: jeder Schritt muss eine Kante des Grids sein
+			double Cost = 0.0;
+			bool bConnected = true;
+			const int32* Previous = LocationToIndex.Find(Path[0]);
+			for (int32 i = 1; i < Path.Num() && bConnected; ++i)
+			{
+				const int32* Current = LocationToIndex.Find(Path[i]);
+				bConnected = Previous && Current && Loaded.NavNodes[*Previous].Neighbors.Contains(&Loaded.NavNodes[*Current]);
+				Cost += FVector::Dist(Path[i - 1], Path[i]);
+				Previous = Current;
+			}
+
+			if (!Previous || !bConnected)
+			{
+				Fail(q, TEXT("path is not a connected chain of grid edges"));
+				continue;
+			}
+			if (!Path[0].Equals(Loaded.NavNodes[StartIndex].Location, 0.0))
+			{
+				Fail(q, TEXT("path does not begin at the start node"));
+				continue;
+			}
+
+			if (Reference < 0.0)
+			{
+				++Result.Partial;
+				if (bComplete)
+					Fail(q, TEXT("bFoundCompletePath is true for an unreachable goal"));
+				continue;
+			}
+
+			++Result.Complete;
+			if (!bComplete)
+			{
+				Fail(q, TEXT("bFoundCompletePath is false for a reachable goal"));
+				continue;
+			}
+			if (!Path.Last().Equals(Loaded.NavNodes[GoalIndex].Location, 0.0))
+			{
+				Fail(q, TEXT("complete path does not end at the goal"));
+				continue;
+			}
+
+			const double Bound = Reference * (1.0 + Engine.Epsilon) * (1.0 + RELATIVE_TOLERANCE) + ABSOLUTE_TOLERANCE;
+			if (Reference > 0.0)
+				Result.WorstRatio = FMath::Max(Result.WorstRatio, Cost / Reference);
+			if (Cost > Bound)
+			{
+				Fail(q, *FString::Printf(TEXT("cost %.2f exceeds bound %.2f"), Cost, Bound));
+			}
+		}
+
+		TSharedRef<FJsonObject> EngineReport = MakeShared<FJsonObject>();
+		EngineReport->SetStringField(TEXT("engine"), Engine.Name);
+		EngineReport->SetNumberField(TEXT("epsilon"), Engine.Epsilon);
+		EngineReport->SetNumberField(TEXT("failures"), Result.Failures);
+		EngineReport->SetNumberField(TEXT("complete"), Result.Complete);
+		EngineReport->SetNumberField(TEXT("partial"), Result.Partial);
+		EngineReport->SetNumberField(TEXT("worstCostRatio"), Result.WorstRatio);
+		EngineReport->SetNumberField(TEXT("meanExpansions"), (double)Result.Expansions / Queries.Num());
+		EngineReport->SetObjectField(TEXT("timeUs"), USpiderNavBenchmarkCommandlet::MakePercentiles(Result.TimeUs));
+		EngineReports.Add(MakeShared<FJsonValueObject>(EngineReport));
+
+		UE_LOG(LogSpiderNavValidate, Display, TEXT("%-22s %-10s %s  failures %d  reachable %d  unreachable %d  worst ratio %.4f  mean expansions %.0f"),
+			*GridName, *Engine.Name, Result.Failures == 0 ? TEXT("OK  ") : TEXT("FAIL"), Result.Failures,
+			Result.Complete, Result.Partial, Result.WorstRatio, (double)Result.Expansions / Queries.Num());
+
+		OutFailures += Result.Failures;
+	}
+
+	Navigation->SetGrid(FSavedSpiderNavGrid());
+	Navigation->MarkAsGarbage();
+
+	GridReport->SetArrayField(TEXT("engines"), EngineReports);
+	return GridReport;
+}
@@ -0,0 +1,279 @@
+// Copyright Yves Tanas 2025
+
+#include "EditorUtility/SpiderNavBuildJob.h"
+#include "EditorUtility/SpiderNavBuildReport.h"
+#include "Actors/SpiderNavGridBuilderVolume.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SpiderNavBuildJobPrivate
+{
+	static constexpr uint32 CHECKPOINT_MAGIC = 0x50434E53; // "SNCP"
+	static constexpr int32 CHECKPOINT_VERSION = 2;
+
+	// Grobe Anteile an der Gesamtlaufzeit (Trace und Relations dominieren)
+	static constexpr float StageWeights[(int32)ESpiderNavBuildStage::Num] = { 0.05f, 0.4f, 0.05f, 0.35f, 0.15f };
+
+	static FSpiderNavBuildSettings WithVolume(const FSpiderNavBuildSettings& InSettings, const ASpiderNavGridBuilderVolume* InVolume)
+	{
+		FSpiderNavBuildSettings Settings = InSettings;
+		FSpiderNavGridBuilder::CaptureVolume(InVolume, Settings);
+		return Settings;
+	}
+
+	static FString GetCheckpointFile(const FString& InputHash, ESpiderNavBuildStage Stage)
+	{
+		return FSpiderNavBuildJob::GetCheckpointDir(InputHash) / FString::Printf(TEXT("%s.ckpt"), FSpiderNavBuildJob::GetStageName(Stage));
+	}
+}
+
+FSpiderNavBuildJob::FSpiderNavBuildJob(UWorld* InWorld, const FSpiderNavBuildSettings& InSettings, const ASpiderNavGridBuilderVolume* InVolume, const FString& InInputHash)
+	: Builder(InWorld, SpiderNavBuildJobPrivate::WithVolume(InSettings, InVolume), InVolume)
+	, World(InWorld)
+	, Volume(InVolume)
+	, InputHash(InInputHash)
+{
+	Builder.SetControl(&Control);
+}
+
+void FSpiderNavBuildJob::Run()
+{
+	// Already cancelled by CancelAndWait before the worker got to it
+	ESpiderNavBuildJobState Expected = ESpiderNavBuildJobState::Pending;
+	if (!State.compare_exchange_strong(Expected, ESpiderNavBuildJobState::Running))
+		return;
+
+	if (!Builder.GetSettings().HasVolume() || !World.IsValid(false, true))
+	{
+		State = ESpiderNavBuildJobState::Failed;
+		return;
+	}
+
+	ResumedStage = RestoreCheckpoint();
+	if (ResumedStage != ESpiderNavBuildStage::Lattice)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[SpiderBuildJob] Resuming %s at stage %s (%d nodes from checkpoint)."),
+			*InputHash, GetStageName(ResumedStage), Nodes.Num());
+	}
+
+	for (int32 StageIndex = (int32)ResumedStage; StageIndex < (int32)ESpiderNavBuildStage::Num; ++StageIndex)
+	{
+		const ESpiderNavBuildStage Stage = (ESpiderNavBuildStage)StageIndex;
+		CurrentStage = (uint8)StageIndex;
+		Control.ResetWork(0);
+
+		if (Control.IsCancelled())
+			break;
+
+		if (!World.IsValid(false, true))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SpiderBuildJob] World went away before stage %s."), GetStageName(Stage));
+			State = ESpiderNavBuildJobState::Failed;
+			return;
+		}
+
+		const FSpiderNavBuildStageTimer Timer(&Control);
+		int64 Edges = 0;
+
+		switch (Stage)
+		{
+		case ESpiderNavBuildStage::Lattice:
+			Lattice.Reset();
+			Builder.GenerateLattice(Lattice);
+			break;
+		case ESpiderNavBuildStage::Trace:
+			Nodes.Reset();
+			Builder.TraceLattice(Lattice, Nodes);
+			Lattice.Empty();
+			break;
+		case ESpiderNavBuildStage::Dedup:
+			Builder.SortAndFilterNodes(Nodes);
+			break;
+		case ESpiderNavBuildStage::Relations:
+			Edges = Builder.BuildRelations(Nodes);
+			break;
+		case ESpiderNavBuildStage::Edges:
+			Builder.GenerateEdgeNodes(Nodes);
+			Edges = FSpiderNavGridBuilder::CountEdges(Nodes);
+			break;
+		default:
+			break;
+		}
+
+		// Abgebrochene Stage ist unvollständig -> kein Checkpoint
+		if (Control.IsCancelled())
+			break;
+
+		FSpiderNavBuildStageStats& Stats = StageStats.AddDefaulted_GetRef();
+		Stats.Name = GetStageName(Stage);
+		Timer.Finish(Stats);
+		Stats.NodesOut = Stage == ESpiderNavBuildStage::Lattice ? Lattice.Num() : Nodes.Num();
+		Stats.EdgesOut = Edges;
+
+		// Das Gitter ist billig neu zu erzeugen, alles danach wird gesichert
+		if (Stage != ESpiderNavBuildStage::Lattice)
+			SaveCheckpoint(Stage);
+	}
+
+	if (Control.IsCancelled())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[SpiderBuildJob] Cancelled during %s."), GetStageName(GetCurrentStage()));
+		State = ESpiderNavBuildJobState::Cancelled;
+		return;
+	}
+
+	CurrentStage = (uint8)ESpiderNavBuildStage::Num;
+	State = ESpiderNavBuildJobState::Succeeded;
+}
+
+void FSpiderNavBuildJob::Cancel()
+{
+	Control.bCancelRequested = true;
+}
+
+void FSpiderNavBuildJob::CancelAndWait()
+{
+	Cancel();
+
+	ESpiderNavBuildJobState Expected = ESpiderNavBuildJobState::Pending;
+	if (State.compare_exchange_strong(Expected, ESpiderNavBuildJobState::Cancelled))
+		return;
+
+	// Stages check the flag per chunk, so this is at most one chunk of traces
+	while (!IsFinished())
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+bool FSpiderNavBuildJob::IsFinished() const
+{
+	const ESpiderNavBuildJobState Current = State.load();
+	return Current == ESpiderNavBuildJobState::Succeeded
+		|| Current == ESpiderNavBuildJobState::Cancelled
+		|| Current == ESpiderNavBuildJobState::Failed;
+}
+
+float FSpiderNavBuildJob::GetProgress() const
+{
+	using namespace SpiderNavBuildJobPrivate;
+
+	const int32 Stage = CurrentStage.load();
+	float Progress = 0.f;
+	for (int32 i = 0; i < Stage && i < (int32)ESpiderNavBuildStage::Num; ++i)
+		Progress += StageWeights[i];
+
+	if (Stage < (int32)ESpiderNavBuildStage::Num)
+		Progress += StageWeights[Stage] * Control.GetStageFraction();
+
+	return FMath::Clamp(Progress, 0.f, 1.f);
+}
+
+const TCHAR* FSpiderNavBuildJob::GetStageName(ESpiderNavBuildStage Stage)
+{
+	switch (Stage)
+	{
+	case ESpiderNavBuildStage::Lattice:   return TEXT("Lattice");
+	case ESpiderNavBuildStage::Trace:     return TEXT("Trace");
+	case ESpiderNavBuildStage::Dedup:     return TEXT("Dedup");
+	case ESpiderNavBuildStage::Relations: return TEXT("Relations");
+	case ESpiderNavBuildStage::Edges:     return TEXT("Edges");
+	default:                              return TEXT("Done");
+	}
+}
+
+FString FSpiderNavBuildJob::GetCheckpointDir(const FString& InInputHash)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SpiderNav") / InInputHash;
+}
+
+void FSpiderNavBuildJob::DiscardCheckpoints(const FString& InInputHash)
+{
+	if (InInputHash.IsEmpty())
+		return;
+
+	IFileManager::Get().DeleteDirectory(*GetCheckpointDir(InInputHash), false, true);
+}
+
+ESpiderNavBuildStage FSpiderNavBuildJob::RestoreCheckpoint()
+{
+	if (InputHash.IsEmpty())
+		return ESpiderNavBuildStage::Lattice;
+
+	// Neuester gültiger Checkpoint gewinnt
+	for (int32 StageIndex = (int32)ESpiderNavBuildStage::Num - 1; StageIndex > (int32)ESpiderNavBuildStage::Lattice; --StageIndex)
+	{
+		if (LoadCheckpoint((ESpiderNavBuildStage)StageIndex))
+			return (ESpiderNavBuildStage)(StageIndex + 1);
+	}
+	return ESpiderNavBuildStage::Lattice;
+}
+
+bool FSpiderNavBuildJob::SaveCheckpoint(ESpiderNavBuildStage Stage) const
+{
+	using namespace SpiderNavBuildJobPrivate;
+
+	if (InputHash.IsEmpty())
+		return false;
+
+	TArray<uint8> Data;
+	FMemoryWriter Ar(Data);
+
+	uint32 Magic = CHECKPOINT_MAGIC;
+	int32 Version = CHECKPOINT_VERSION;
+	FString Hash = InputHash;
+	uint8 StageByte = (uint8)Stage;
+	int32 Count = Nodes.Num();
+	Ar << Magic << Version << Hash << StageByte << Count;
+
+	for (const FSpiderNavNodeBuilder& Node : Nodes)
+	{
+		FVector Location = Node.Location;
+		FVector Normal = Node.Normal;
+		TArray<int32> Neighbors = Node.Neighbors;
+		bool bValid = Node.bValid;
+		Ar << Location << Normal << Neighbors << bValid;
+	}
+
+	const FString File = GetCheckpointFile(InputHash, Stage);
+	const bool bSaved = FFileHelper::SaveArrayToFile(Data, *File);
+	UE_CLOG(!bSaved, LogTemp, Warning, TEXT("[SpiderBuildJob] Could not write checkpoint %s"), *File);
+	return bSaved;
+}
+
+bool FSpiderNavBuildJob::LoadCheckpoint(ESpiderNavBuildStage Stage)
+{
+	using namespace SpiderNavBuildJobPrivate;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetCheckpointFile(InputHash, Stage), FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Ar(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString Hash;
+	uint8 StageByte = 0;
+	int32 Count = 0;
+	Ar << Magic << Version << Hash << StageByte << Count;
+
+	if (Ar.IsError() || Magic != CHECKPOINT_MAGIC || Version != CHECKPOINT_VERSION ||
+		Hash != InputHash || StageByte != (uint8)Stage || Count < 0)
+	{
+		return false;
+	}
+
+	Nodes.SetNum(Count);
+	for (FSpiderNavNodeBuilder& Node : Nodes)
+		Ar << Node.Location << Node.Normal << Node.Neighbors << Node.bValid;
+
+	if (Ar.IsError())
+	{
+		Nodes.Reset();
+		return false;
+	}
+	return true;
+}
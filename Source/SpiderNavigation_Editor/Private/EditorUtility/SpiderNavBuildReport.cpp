@@ -0,0 +1,137 @@
+// Copyright Yves Tanas 2025
+
+#include "EditorUtility/SpiderNavBuildReport.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <sys/resource.h>
+#endif
+
+FSpiderNavBuildStageTimer::FSpiderNavBuildStageTimer(const FSpiderNavBuildControl* InControl)
+	: Control(InControl)
+	, WallStart(FPlatformTime::Seconds())
+	, CpuStart(FSpiderNavBuildReport::GetProcessCpuSeconds())
+	, TracesStart(InControl ? InControl->GetTraces() : 0)
+{
+}
+
+void FSpiderNavBuildStageTimer::Finish(FSpiderNavBuildStageStats& Stats) const
+{
+	const FPlatformMemoryStats Memory = FPlatformMemory::GetStats();
+
+	Stats.WallSeconds = FPlatformTime::Seconds() - WallStart;
+	Stats.CpuSeconds = FMath::Max(0.0, FSpiderNavBuildReport::GetProcessCpuSeconds() - CpuStart);
+	Stats.UsedPhysicalBytes = Memory.UsedPhysical;
+	Stats.PeakUsedPhysicalBytes = Memory.PeakUsedPhysical;
+	Stats.Traces = Control ? Control->GetTraces() - TracesStart : 0;
+}
+
+double FSpiderNavBuildReport::GetProcessCpuSeconds()
+{
+#if PLATFORM_WINDOWS
+	FILETIME Creation, Exit, Kernel, User;
+	if (!::GetProcessTimes(::GetCurrentProcess(), &Creation, &Exit, &Kernel, &User))
+		return 0.0;
+
+	// FILETIME zählt in 100 ns
+	const auto ToSeconds = [](const FILETIME& Time)
+		{
+			return double((uint64(Time.dwHighDateTime) << 32) | uint64(Time.dwLowDateTime)) * 1e-7;
+		};
+	return ToSeconds(Kernel) + ToSeconds(User);
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	rusage Usage;
+	if (getrusage(RUSAGE_SELF, &Usage) != 0)
+		return 0.0;
+
+	return double(Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec) + double(Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) * 1e-6;
+#else
+	return 0.0;
+#endif
+}
+
+FString FSpiderNavBuildReport::GetReportPath(const FString& SlotName)
+{
+	// Gleicher Ordner wie UGameplayStatics::SaveGameToSlot
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), SlotName + TEXT(".buildreport.json"));
+}
+
+bool FSpiderNavBuildReport::Write(const FString& SlotName, const FString& InputHash, const TArray<FSpiderNavBuildStageStats>& Stages)
+{
+	constexpr double MB = 1024.0 * 1024.0;
+
+	TArray<TSharedPtr<FJsonValue>> StageValues;
+	double TotalWall = 0.0;
+	double TotalCpu = 0.0;
+	int64 TotalTraces = 0;
+	uint64 Peak = 0;
+	for (const FSpiderNavBuildStageStats& Stage : Stages)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("name"), Stage.Name);
+		Object->SetNumberField(TEXT("wallSeconds"), Stage.WallSeconds);
+		Object->SetNumberField(TEXT("cpuSeconds"), Stage.CpuSeconds);
+		Object->SetNumberField(TEXT("usedPhysicalMB"), Stage.UsedPhysicalBytes / MB);
+		Object->SetNumberField(TEXT("peakUsedPhysicalMB"), Stage.PeakUsedPhysicalBytes / MB);
+		Object->SetNumberField(TEXT("traces"), (double)Stage.Traces);
+		Object->SetNumberField(TEXT("nodesOut"), Stage.NodesOut);
+		Object->SetNumberField(TEXT("edgesOut"), (double)Stage.EdgesOut);
+		StageValues.Add(MakeShared<FJsonValueObject>(Object));
+
+		TotalWall += Stage.WallSeconds;
+		TotalCpu += Stage.CpuSeconds;
+		TotalTraces += Stage.Traces;
+		Peak = FMath::Max(Peak, Stage.PeakUsedPhysicalBytes);
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("slot"), SlotName);
+	Report->SetStringField(TEXT("inputHash"), InputHash);
+	Report->SetStringField(TEXT("date"), FDateTime::Now().ToIso8601());
+	Report->SetNumberField(TEXT("builderVersion"), FSpiderNavGridBuilder::BuilderVersion);
+	Report->SetNumberField(TEXT("cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	Report->SetNumberField(TEXT("wallSeconds"), TotalWall);
+	Report->SetNumberField(TEXT("cpuSeconds"), TotalCpu);
+	Report->SetNumberField(TEXT("peakUsedPhysicalMB"), Peak / MB);
+	Report->SetNumberField(TEXT("traces"), (double)TotalTraces);
+	Report->SetArrayField(TEXT("stages"), StageValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString Path = GetReportPath(SlotName);
+	const bool bSaved = FFileHelper::SaveStringToFile(Json, *Path);
+	UE_CLOG(!bSaved, LogTemp, Warning, TEXT("[SpiderBuildReport] Could not write %s"), *Path);
+	return bSaved;
+}
+
+FString FSpiderNavBuildReport::ToText(const TArray<FSpiderNavBuildStageStats>& Stages)
+{
+	constexpr double MB = 1024.0 * 1024.0;
+
+	FString Text;
+	double TotalWall = 0.0;
+	double TotalCpu = 0.0;
+	int64 TotalTraces = 0;
+	for (const FSpiderNavBuildStageStats& Stage : Stages)
+	{
+		Text += FString::Printf(TEXT("%-11s %8.3f s wall %8.3f s cpu %7.0f MB (peak %.0f MB) traces=%lld nodes=%d edges=%lld\n"),
+			*Stage.Name, Stage.WallSeconds, Stage.CpuSeconds, Stage.UsedPhysicalBytes / MB, Stage.PeakUsedPhysicalBytes / MB,
+			Stage.Traces, Stage.NodesOut, Stage.EdgesOut);
+
+		TotalWall += Stage.WallSeconds;
+		TotalCpu += Stage.CpuSeconds;
+		TotalTraces += Stage.Traces;
+	}
+	Text += FString::Printf(TEXT("%-11s %8.3f s wall %8.3f s cpu traces=%lld"), TEXT("Total"), TotalWall, TotalCpu, TotalTraces);
+	return Text;
+}
@@ -0,0 +1,956 @@
+// Copyright Yves Tanas 2025
+
+#include "EditorUtility/SpiderNavGridBuilder.h"
+#include "SpiderNavigation_Editor.h"
+#include "Structs/SpiderDebugRenderer.h"
+#include "Actors/SpiderNavGridBuilderVolume.h"
+#include "SaveGame/SpiderNavGridSaveGame.h"
+#include "SpiderNavigationStats.h"
+#include "Async/ParallelFor.h"
+#include "Components/BoxComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformProcess.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/SecureHash.h"
+
+namespace SpiderNavGridBuilderPrivate
+{
+	/** Lattice points traced per parallel task */
+	static constexpr int32 TRACE_CHUNK_SIZE = 256;
+
+	/** Source nodes searched for edge crossings per parallel task */
+	static constexpr int32 EDGE_CHUNK_SIZE = 64;
+
+	/** Nodes on (nearly) parallel surfaces cannot meet around a convex edge */
+	static constexpr float EDGE_MAX_NORMAL_DOT = 0.9f;
+
+	static const FVector TraceDirs[6] = {
+		FVector(1, 0, 0), FVector(-1, 0, 0),
+		FVector(0, 1, 0), FVector(0,-1, 0),
+		FVector(0, 0, 1), FVector(0, 0,-1)
+	};
+
+	static FIntVector CellOf(const FVector& P, float CellSize)
+	{
+		return FIntVector(
+			FMath::FloorToInt(P.X / CellSize),
+			FMath::FloorToInt(P.Y / CellSize),
+			FMath::FloorToInt(P.Z / CellSize));
+	}
+
+	/**
+	 * Closest points of the segments Start0-End0 and Start1-End1 (Paul Bourke).
+	 * Succeeds if both lie on the segments (away from the starts) and are at most MaxDeviation apart.
+	 */
+	static bool GetLineLineIntersection(const FVector& Start0, const FVector& End0, const FVector& Start1, const FVector& End1,
+		float MaxDeviation, FVector& OutIntersection, float& OutDeviation)
+	{
+		const FVector P13 = Start0 - Start1;
+		const FVector P43 = End1 - Start1;
+		const FVector P21 = End0 - Start0;
+
+		const double D1343 = P13 | P43;
+		const double D4321 = P43 | P21;
+		const double D1321 = P13 | P21;
+		const double D4343 = P43 | P43;
+		const double D2121 = P21 | P21;
+
+		const double Denom = D2121 * D4343 - D4321 * D4321;
+		if (D4343 < UE_KINDA_SMALL_NUMBER || FMath::Abs(Denom) < UE_KINDA_SMALL_NUMBER)
+			return false;
+
+		const double MuA = (D1343 * D4321 - D1321 * D4343) / Denom;
+		const double MuB = (D1343 + MuA * D4321) / D4343;
+		if (MuA <= UE_KINDA_SMALL_NUMBER || MuA > 1.0 || MuB <= UE_KINDA_SMALL_NUMBER || MuB > 1.0)
+			return false;
+
+		const FVector PA = Start0 + P21 * MuA;
+		const FVector PB = Start1 + P43 * MuB;
+		OutDeviation = FVector::Dist(PA, PB);
+		if (OutDeviation > MaxDeviation)
+			return false;
+
+		OutIntersection = (PA + PB) * 0.5f;
+		return true;
+	}
+}
+
+FSpiderNavGridBuilder::FSpiderNavGridBuilder(UWorld* InWorld, const FSpiderNavBuildSettings& InSettings, const AActor* InIgnoredActor)
+	: World(InWorld)
+	, Settings(InSettings)
+	, IgnoredActor(InIgnoredActor)
+	, IgnoredActorId(InIgnoredActor ? InIgnoredActor->GetUniqueID() : 0)
+{
+}
+
+void FSpiderNavGridBuilder::GenerateLattice(TArray<FSpiderNavNodeBuilder>& OutPoints, const FBox* Clip) const
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_GenerateLattice);
+
+	if (!Settings.HasVolume())
+		return;
+
+	const float Step = Settings.GridStepSize;
+	const FVector GridStart = Settings.VolumeBounds.Min;
+	const FVector GridEnd = Settings.VolumeBounds.Max;
+	const FTransform& BoxXf = Settings.VolumeTransform;
+	const FVector Extent = Settings.VolumeExtent;
+
+	// Index-Bereich des Gitters; mit Clip nur der Teil innerhalb der Box (gleiches Gitter wie der Voll-Build)
+	FIntVector MinIndex(0, 0, 0);
+	FIntVector MaxIndex(
+		FMath::FloorToInt((GridEnd.X - GridStart.X) / Step),
+		FMath::FloorToInt((GridEnd.Y - GridStart.Y) / Step),
+		FMath::FloorToInt((GridEnd.Z - GridStart.Z) / Step));
+
+	if (Clip)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			MinIndex[Axis] = FMath::Max(MinIndex[Axis], FMath::CeilToInt((Clip->Min[Axis] - GridStart[Axis]) / Step));
+			MaxIndex[Axis] = FMath::Min(MaxIndex[Axis], FMath::FloorToInt((Clip->Max[Axis] - GridStart[Axis]) / Step));
+		}
+	}
+
+	if (MaxIndex.X < MinIndex.X || MaxIndex.Y < MinIndex.Y || MaxIndex.Z < MinIndex.Z)
+		return;
+
+	// Reservierung (grobe Schätzung, vermeidet Reallocs)
+	OutPoints.Reserve(OutPoints.Num() +
+		(MaxIndex.X - MinIndex.X + 1) * (MaxIndex.Y - MinIndex.Y + 1) * (MaxIndex.Z - MinIndex.Z + 1));
+
+	if (Control)
+		Control->ResetWork(MaxIndex.X - MinIndex.X + 1);
+
+	for (int32 ix = MinIndex.X; ix <= MaxIndex.X; ++ix)
+	{
+		if (IsCancelled())
+			return;
+		for (int32 iy = MinIndex.Y; iy <= MaxIndex.Y; ++iy)
+		{
+			for (int32 iz = MinIndex.Z; iz <= MaxIndex.Z; ++iz)
+			{
+				const FVector Point = GridStart + FVector(ix, iy, iz) * Step;
+				const FVector Local = BoxXf.InverseTransformPosition(Point);
+
+				if (FMath::Abs(Local.X) <= Extent.X &&
+					FMath::Abs(Local.Y) <= Extent.Y &&
+					FMath::Abs(Local.Z) <= Extent.Z)
+				{
+					OutPoints.Emplace(FSpiderNavNodeBuilder{ Point, FVector::UpVector });
+					if (Settings.bDebugDraw)
+						FSpiderDebugRenderer::Get().EnqueuePoint(Point, 2, FColor::Yellow, 0.25f);
+				}
+			}
+		}
+
+		if (Control)
+			Control->AddWork(1);
+
+		if (Settings.ThrottleSleepSeconds > 0.f)
+			FPlatformProcess::Sleep(Settings.ThrottleSleepSeconds);
+	}
+}
+
+void FSpiderNavGridBuilder::TraceLatticeRange(const TArray<FSpiderNavNodeBuilder>& Points, int32 Begin, int32 End, TArray<FSpiderNavNodeBuilder>& OutNodes) const
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_TraceLatticeRange);
+
+	if (!World)
+		return;
+
+	const float TraceDist = Settings.GridStepSize * Settings.TraceDistanceModificator;
+
+	FCollisionQueryParams Q(FName(TEXT("SpiderTraceGT")), /*bTraceComplex*/false);
+	if (IgnoredActorId) Q.AddIgnoredActor(IgnoredActorId);
+
+	End = FMath::Min(End, Points.Num());
+	if (Control && End > Begin)
+		Control->AddTraces(int64(End - Begin) * UE_ARRAY_COUNT(SpiderNavGridBuilderPrivate::TraceDirs));
+
+	for (int32 i = Begin; i < End; ++i)
+	{
+		const FVector Base = Points[i].Location;
+
+		for (const FVector& Dir : SpiderNavGridBuilderPrivate::TraceDirs)
+		{
+			const FVector S = Base + Dir * 5.f;
+			const FVector E = S + Dir * TraceDist;
+
+			FHitResult Hit;
+			const bool bHit = World->LineTraceSingleByChannel(Hit, S, E, ECollisionChannel::ECC_Visibility, Q);
+			if (bHit && Hit.bBlockingHit)
+			{
+				const FVector L = Hit.Location + Hit.Normal * Settings.BounceNavDistance;
+				OutNodes.Emplace(FSpiderNavNodeBuilder{ L, Hit.Normal });
+
+				if (Settings.bDebugDraw)
+					FSpiderDebugRenderer::Get().EnqueueSphere(L, 6.f, FColor::Green, 0.75f);
+			}
+			else if (Settings.bDebugDraw)
+			{
+				FSpiderDebugRenderer::Get().EnqueueLine(S, E, FColor::Red, 0.25f);
+			}
+		}
+	}
+}
+
+void FSpiderNavGridBuilder::TraceLattice(const TArray<FSpiderNavNodeBuilder>& Points, TArray<FSpiderNavNodeBuilder>& OutNodes) const
+{
+	using namespace SpiderNavGridBuilderPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_TraceLattice);
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Points.Num(), TRACE_CHUNK_SIZE);
+	TArray<TArray<FSpiderNavNodeBuilder>> ChunkNodes;
+	ChunkNodes.SetNum(NumChunks);
+
+	if (Control)
+		Control->ResetWork(NumChunks);
+
+	ParallelFor(NumChunks, [this, &Points, &ChunkNodes](int32 Chunk)
+		{
+			if (IsCancelled())
+				return;
+
+			const int32 Begin = Chunk * TRACE_CHUNK_SIZE;
+			TraceLatticeRange(Points, Begin, Begin + TRACE_CHUNK_SIZE, ChunkNodes[Chunk]);
+
+			if (Control)
+				Control->AddWork(1);
+		});
+
+	if (IsCancelled())
+		return;
+
+	// Chunks in Reihenfolge anhängen -> gleiche Ausgabe wie die serielle Variante
+	int32 Total = 0;
+	for (const TArray<FSpiderNavNodeBuilder>& Chunk : ChunkNodes)
+		Total += Chunk.Num();
+
+	OutNodes.Reserve(OutNodes.Num() + Total);
+	for (TArray<FSpiderNavNodeBuilder>& Chunk : ChunkNodes)
+		OutNodes.Append(MoveTemp(Chunk));
+}
+
+int32 FSpiderNavGridBuilder::SortAndFilterNodes(TArray<FSpiderNavNodeBuilder>& Nodes) const
+{
+	using namespace SpiderNavGridBuilderPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_SortAndFilterNodes);
+
+	// Kanonische Reihenfolge unabhängig davon, in welcher Reihenfolge Threads/Ticker Treffer geliefert haben
+	Nodes.StableSort([](const FSpiderNavNodeBuilder& A, const FSpiderNavNodeBuilder& B)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (A.Location[Axis] != B.Location[Axis]) return A.Location[Axis] < B.Location[Axis];
+			}
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (A.Normal[Axis] != B.Normal[Axis]) return A.Normal[Axis] < B.Normal[Axis];
+			}
+			return false;
+		});
+
+	const float MinDist = Settings.GridStepSize * Settings.ClosePointsFilterModificator;
+	if (MinDist <= 0.f || Nodes.Num() == 0)
+		return 0;
+
+	// Greedy in sortierter Reihenfolge: erster Knoten gewinnt -> deterministisch
+	const float MinDistSq = MinDist * MinDist;
+	TMap<FIntVector, TArray<int32>> Kept;
+	Kept.Reserve(Nodes.Num());
+
+	TArray<FSpiderNavNodeBuilder> Filtered;
+	Filtered.Reserve(Nodes.Num());
+
+	for (FSpiderNavNodeBuilder& Node : Nodes)
+	{
+		const FIntVector Cell = CellOf(Node.Location, MinDist);
+		bool bTooClose = false;
+
+		for (int32 dx = -1; dx <= 1 && !bTooClose; ++dx)
+			for (int32 dy = -1; dy <= 1 && !bTooClose; ++dy)
+				for (int32 dz = -1; dz <= 1 && !bTooClose; ++dz)
+				{
+					const TArray<int32>* Bucket = Kept.Find(Cell + FIntVector(dx, dy, dz));
+					if (!Bucket) continue;
+
+					for (int32 k : *Bucket)
+					{
+						if (FVector::DistSquared(Filtered[k].Location, Node.Location) < MinDistSq)
+						{
+							bTooClose = true;
+							break;
+						}
+					}
+				}
+
+		if (!bTooClose)
+		{
+			Kept.FindOrAdd(Cell).Add(Filtered.Num());
+			Filtered.Add(MoveTemp(Node));
+		}
+	}
+
+	const int32 Removed = Nodes.Num() - Filtered.Num();
+	Nodes = MoveTemp(Filtered);
+	return Removed;
+}
+
+int64 FSpiderNavGridBuilder::BuildRelations(TArray<FSpiderNavNodeBuilder>& Nodes, const TBitArray<>* Affected) const
+{
+	using namespace SpiderNavGridBuilderPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_BuildRelations);
+
+	const int32 Total = Nodes.Num();
+	if (Total == 0 || !World)
+		return 0;
+
+	const float Radius = Settings.GridStepSize * Settings.ConnectionSphereRadiusModificator;
+	const float CellSize = Radius * Settings.RelationCellMultiplier;
+	const float RadiusSq = Radius * Radius;
+
+	// Step 1: Spatial Grid vorbereiten + Quellknoten sammeln
+	TMap<FIntVector, TArray<int32>> Grid;
+	Grid.Reserve(Total);
+	TArray<int32> Sources;
+	Sources.Reserve(Affected ? 1024 : Total);
+	for (int32 i = 0; i < Total; ++i)
+	{
+		if (!Nodes[i].bValid)
+			continue;
+
+		Grid.FindOrAdd(CellOf(Nodes[i].Location, CellSize)).Add(i);
+		if (!Affected || (*Affected)[i])
+			Sources.Add(i);
+	}
+
+	// Step 2: Parallel Nachbarschaften berechnen (pro Quelle eigenes Array, kein Lock)
+	TArray<TArray<int32>> Found;
+	Found.SetNum(Sources.Num());
+
+	if (Control)
+		Control->ResetWork(Sources.Num());
+
+	ParallelFor(Sources.Num(), [this, &Nodes, &Grid, &Sources, &Found, Affected, CellSize, RadiusSq](int32 SourceIndex)
+		{
+			if (IsCancelled())
+				return;
+
+			const int32 i = Sources[SourceIndex];
+			TArray<int32>& LocalNeighbors = Found[SourceIndex];
+
+			const FVector& A = Nodes[i].Location;
+			const FIntVector Cell = CellOf(A, CellSize);
+
+			FCollisionQueryParams Q(FName(TEXT("SpiderRelTrace")), false);
+			if (IgnoredActorId) Q.AddIgnoredActor(IgnoredActorId);
+			int64 Traces = 0;
+
+			// Umgebung (3×3×3 Zellen prüfen)
+			for (int32 dx = -1; dx <= 1; ++dx)
+				for (int32 dy = -1; dy <= 1; ++dy)
+					for (int32 dz = -1; dz <= 1; ++dz)
+					{
+						const TArray<int32>* Bucket = Grid.Find(Cell + FIntVector(dx, dy, dz));
+						if (!Bucket) continue;
+
+						for (int32 j : *Bucket)
+						{
+							if (j == i) continue;
+							// Paare zwischen zwei Quellen nur einmal prüfen
+							const bool bOtherIsSource = !Affected || (*Affected)[j];
+							if (bOtherIsSource && j < i) continue;
+
+							const FVector& B = Nodes[j].Location;
+							if (FVector::DistSquared(A, B) > RadiusSq)
+								continue;
+
+							FHitResult Hit;
+							++Traces;
+							if (!World->LineTraceSingleByChannel(Hit, A, B, ECC_Visibility, Q))
+							{
+								LocalNeighbors.Add(j);
+
+								if (Settings.bDebugDraw)
+									FSpiderDebugRenderer::Get().EnqueueLine(A, B, FColor::Blue, 1.0f);
+							}
+						}
+					}
+
+			if (Control)
+			{
+				Control->AddTraces(Traces);
+				Control->AddWork(1);
+			}
+		});
+
+	// Abgebrochen: bestehende Relationen unangetastet lassen
+	if (IsCancelled())
+		return 0;
+
+	// Step 3: Serieller Merge in Quell-Reihenfolge
+	if (!Affected)
+	{
+		for (FSpiderNavNodeBuilder& Node : Nodes)
+			Node.Neighbors.Reset();
+	}
+
+	int64 EdgesAdded = 0;
+	for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+	{
+		const int32 i = Sources[SourceIndex];
+		for (int32 j : Found[SourceIndex])
+		{
+			Nodes[i].Neighbors.Add(j);
+			Nodes[j].Neighbors.Add(i);
+			++EdgesAdded;
+		}
+	}
+
+	// Kanonische Nachbar-Reihenfolge
+	for (FSpiderNavNodeBuilder& Node : Nodes)
+		Node.Neighbors.Sort();
+
+	return EdgesAdded;
+}
+
+int32 FSpiderNavGridBuilder::GenerateEdgeNodes(TArray<FSpiderNavNodeBuilder>& Nodes, const TBitArray<>* Affected) const
+{
+	using namespace SpiderNavGridBuilderPrivate;
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_GenerateEdgeNodes);
+
+	const int32 Total = Nodes.Num();
+	if (Total == 0 || !World)
+		return 0;
+
+	const float Radius = Settings.GridStepSize * Settings.ConnectionSphereRadiusModificator;
+	const float CellSize = Radius * Settings.RelationCellMultiplier;
+	const float RadiusSq = Radius * Radius;
+	const float EdgeTraceDist = Settings.GridStepSize * Settings.TraceDistanceForEdgesModificator;
+	const float MaxDeviation = Settings.GridStepSize * Settings.EgdeDeviationModificator;
+
+	TMap<FIntVector, TArray<int32>> Grid;
+	Grid.Reserve(Total);
+	TArray<int32> Sources;
+	Sources.Reserve(Affected ? 1024 : Total);
+	for (int32 i = 0; i < Total; ++i)
+	{
+		if (!Nodes[i].bValid)
+			continue;
+
+		Grid.FindOrAdd(CellOf(Nodes[i].Location, CellSize)).Add(i);
+		if (!Affected || (*Affected)[i])
+			Sources.Add(i);
+	}
+
+	// Kandidaten pro Chunk sammeln (thread-lokal, kein Lock)
+	const int32 NumChunks = FMath::DivideAndRoundUp(Sources.Num(), EDGE_CHUNK_SIZE);
+	TArray<TArray<FSpiderNavEdgeBuilder>> ChunkEdges;
+	ChunkEdges.SetNum(NumChunks);
+
+	if (Control)
+		Control->ResetWork(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			if (IsCancelled())
+				return;
+
+			TArray<FSpiderNavEdgeBuilder>& LocalEdges = ChunkEdges[Chunk];
+
+			FCollisionQueryParams Q(FName(TEXT("SpiderEdgeTrace")), false);
+			if (IgnoredActorId) Q.AddIgnoredActor(IgnoredActorId);
+			int64 Traces = 0;
+
+			const int32 End = FMath::Min((Chunk + 1) * EDGE_CHUNK_SIZE, Sources.Num());
+			for (int32 SourceIndex = Chunk * EDGE_CHUNK_SIZE; SourceIndex < End; ++SourceIndex)
+			{
+				const int32 i = Sources[SourceIndex];
+				const FSpiderNavNodeBuilder& A = Nodes[i];
+				const FIntVector Cell = CellOf(A.Location, CellSize);
+
+				for (int32 dx = -1; dx <= 1; ++dx)
+					for (int32 dy = -1; dy <= 1; ++dy)
+						for (int32 dz = -1; dz <= 1; ++dz)
+						{
+							const TArray<int32>* Bucket = Grid.Find(Cell + FIntVector(dx, dy, dz));
+							if (!Bucket) continue;
+
+							for (int32 j : *Bucket)
+							{
+								if (j == i) continue;
+								const bool bOtherIsSource = !Affected || (*Affected)[j];
+								if (bOtherIsSource && j < i) continue;
+
+								// Nur Paare, deren direkte Verbindung blockiert war
+								const FSpiderNavNodeBuilder& B = Nodes[j];
+								if (FVector::DistSquared(A.Location, B.Location) > RadiusSq)
+									continue;
+								if ((A.Normal | B.Normal) > EDGE_MAX_NORMAL_DOT)
+									continue;
+								if (A.Neighbors.Contains(j))
+									continue;
+
+								// 6×6 Richtungen, beste Kreuzung behalten (reine Mathematik, keine Traces)
+								FVector Best = FVector::ZeroVector;
+								float BestDeviation = TNumericLimits<float>::Max();
+								for (const FVector& DirA : TraceDirs)
+								{
+									const FVector EndA = A.Location + DirA * EdgeTraceDist;
+									for (const FVector& DirB : TraceDirs)
+									{
+										FVector Intersection;
+										float Deviation;
+										if (GetLineLineIntersection(A.Location, EndA, B.Location, B.Location + DirB * EdgeTraceDist, MaxDeviation, Intersection, Deviation) &&
+											Deviation < BestDeviation)
+										{
+											Best = Intersection;
+											BestDeviation = Deviation;
+										}
+									}
+								}
+
+								if (BestDeviation > MaxDeviation)
+									continue;
+
+								// Kreuzungspunkt muss von beiden Knoten sichtbar sein
+								FHitResult Hit;
+								++Traces;
+								if (World->LineTraceSingleByChannel(Hit, A.Location, Best, ECC_Visibility, Q))
+									continue;
+								++Traces;
+								if (World->LineTraceSingleByChannel(Hit, B.Location, Best, ECC_Visibility, Q))
+									continue;
+
+								FSpiderNavEdgeBuilder& Edge = LocalEdges.AddDefaulted_GetRef();
+								Edge.Intersection = Best;
+								Edge.Normal = (A.Normal + B.Normal).GetSafeNormal();
+								Edge.NodeA = i;
+								Edge.NodeB = j;
+							}
+						}
+			}
+
+			if (Control)
+			{
+				Control->AddTraces(Traces);
+				Control->AddWork(1);
+			}
+		});
+
+	if (IsCancelled())
+		return 0;
+
+	// Serieller Merge in Chunk-Reihenfolge; nahe Kreuzungspunkte teilen sich einen Kantenknoten
+	const float MergeDist = FMath::Max(Settings.GridStepSize * Settings.ClosePointsFilterModificator, 1.f);
+	const float MergeDistSq = MergeDist * MergeDist;
+	TMap<FIntVector, TArray<int32>> EdgeGrid;
+	int32 Added = 0;
+
+	// Same closeness filter as SortAndFilterNodes: a crossing next to an existing node reuses it instead of a near duplicate
+	EdgeGrid.Reserve(Total);
+	for (int32 i = 0; i < Total; ++i)
+	{
+		if (Nodes[i].bValid)
+			EdgeGrid.FindOrAdd(CellOf(Nodes[i].Location, MergeDist)).Add(i);
+	}
+
+	auto Link = [&Nodes](int32 From, int32 To)
+		{
+			if (From == To)
+				return;
+			Nodes[From].Neighbors.AddUnique(To);
+			Nodes[To].Neighbors.AddUnique(From);
+		};
+
+	for (const TArray<FSpiderNavEdgeBuilder>& Chunk : ChunkEdges)
+	{
+		for (const FSpiderNavEdgeBuilder& Edge : Chunk)
+		{
+			const FIntVector Cell = CellOf(Edge.Intersection, MergeDist);
+			int32 EdgeNode = INDEX_NONE;
+
+			for (int32 dx = -1; dx <= 1 && EdgeNode == INDEX_NONE; ++dx)
+				for (int32 dy = -1; dy <= 1 && EdgeNode == INDEX_NONE; ++dy)
+					for (int32 dz = -1; dz <= 1 && EdgeNode == INDEX_NONE; ++dz)
+					{
+						if (const TArray<int32>* Bucket = EdgeGrid.Find(Cell + FIntVector(dx, dy, dz)))
+						{
+							for (int32 k : *Bucket)
+							{
+								if (FVector::DistSquared(Nodes[k].Location, Edge.Intersection) < MergeDistSq)
+								{
+									EdgeNode = k;
+									break;
+								}
+							}
+						}
+					}
+
+			if (EdgeNode == INDEX_NONE)
+			{
+				EdgeNode = Nodes.Num();
+				FSpiderNavNodeBuilder& Node = Nodes.AddDefaulted_GetRef();
+				Node.Location = Edge.Intersection;
+				Node.Normal = Edge.Normal;
+				EdgeGrid.FindOrAdd(Cell).Add(EdgeNode);
+				++Added;
+
+				if (Settings.bDebugDraw)
+					FSpiderDebugRenderer::Get().EnqueueSphere(Edge.Intersection, 6.f, FColor::Orange, 1.0f);
+			}
+
+			Link(EdgeNode, Edge.NodeA);
+			Link(EdgeNode, Edge.NodeB);
+		}
+	}
+
+	// Kanonische Nachbar-Reihenfolge
+	for (FSpiderNavNodeBuilder& Node : Nodes)
+		Node.Neighbors.Sort();
+
+	return Added;
+}
+
+FSpiderNavIncrementalStats FSpiderNavGridBuilder::RebuildRegion(const FBox& DirtyBox, TArray<FSpiderNavNodeBuilder>& Nodes) const
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_RebuildRegion);
+
+	FSpiderNavIncrementalStats Stats;
+	if (!World || !Settings.HasVolume() || !DirtyBox.IsValid)
+		return Stats;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const float TraceDist = Settings.GridStepSize * Settings.TraceDistanceModificator;
+	const float Radius = Settings.GridStepSize * Settings.ConnectionSphereRadiusModificator;
+
+	// Tracer innerhalb TraceDist können geänderte Geometrie treffen -> Region um die Trace-Länge erweitern
+	const FBox Region = DirtyBox.ExpandBy(TraceDist + Settings.BounceNavDistance + 5.f);
+	// Kanten deren Segment die geänderte Geometrie schneidet haben beide Enden in DirtyBox + Radius
+	const FBox RelinkBox = DirtyBox.ExpandBy(Radius);
+	Stats.Region = Region;
+
+	// Step 1: Neue Knoten nur innerhalb der Region erzeugen
+	TArray<FSpiderNavNodeBuilder> Lattice;
+	GenerateLattice(Lattice, &Region);
+
+	TArray<FSpiderNavNodeBuilder> Traced;
+	TraceLattice(Lattice, Traced);
+
+	TArray<FSpiderNavNodeBuilder> NewNodes;
+	NewNodes.Reserve(Traced.Num());
+	for (FSpiderNavNodeBuilder& Node : Traced)
+	{
+		// Treffer außerhalb existieren bereits im alten Grid
+		if (Region.IsInsideOrOn(Node.Location))
+			NewNodes.Add(MoveTemp(Node));
+	}
+	SortAndFilterNodes(NewNodes);
+
+	// Step 2: Alte Knoten der Region entfernen, Slots merken
+	TBitArray<> Removed(false, Nodes.Num());
+	TArray<int32> FreeSlots;
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (!Nodes[i].bValid)
+		{
+			FreeSlots.Add(i);
+		}
+		else if (Region.IsInsideOrOn(Nodes[i].Location))
+		{
+			Removed[i] = true;
+			FreeSlots.Add(i);
+			++Stats.RemovedNodes;
+		}
+	}
+
+	for (FSpiderNavNodeBuilder& Node : Nodes)
+	{
+		Node.Neighbors.RemoveAll([&Removed](int32 Neighbor) { return Removed[Neighbor]; });
+	}
+
+	// Step 3: Splice – freie Slots wiederverwenden, Rest anhängen, übrige Slots invalidieren
+	const int32 OldNum = Nodes.Num();
+	TBitArray<> Affected(false, OldNum + FMath::Max(0, NewNodes.Num() - FreeSlots.Num()));
+	int32 NextFree = 0;
+	for (FSpiderNavNodeBuilder& Node : NewNodes)
+	{
+		const int32 Slot = NextFree < FreeSlots.Num() ? FreeSlots[NextFree++] : Nodes.Num();
+		if (Slot == Nodes.Num())
+			Nodes.AddDefaulted();
+
+		Nodes[Slot] = MoveTemp(Node);
+		Nodes[Slot].Neighbors.Reset();
+		Nodes[Slot].bValid = true;
+		Affected[Slot] = true;
+	}
+	for (; NextFree < FreeSlots.Num(); ++NextFree)
+	{
+		FSpiderNavNodeBuilder& Slot = Nodes[FreeSlots[NextFree]];
+		Slot.Neighbors.Reset();
+		Slot.bValid = false;
+	}
+	Stats.AddedNodes = NewNodes.Num();
+
+	// Step 4: Bestehende Knoten nahe der Änderung neu verbinden
+	for (int32 i = 0; i < OldNum; ++i)
+	{
+		if (Nodes[i].bValid && !Affected[i] && RelinkBox.IsInsideOrOn(Nodes[i].Location))
+		{
+			Affected[i] = true;
+			for (int32 j : Nodes[i].Neighbors)
+				Nodes[j].Neighbors.Remove(i);
+			Nodes[i].Neighbors.Reset();
+			++Stats.RelinkedNodes;
+		}
+	}
+
+	Stats.EdgesAdded = BuildRelations(Nodes, &Affected);
+	Stats.AddedNodes += GenerateEdgeNodes(Nodes, &Affected);
+	Stats.WallSeconds = FPlatformTime::Seconds() - StartTime;
+	return Stats;
+}
+
+FBox FSpiderNavGridBuilder::GetVolumeBounds(const ASpiderNavGridBuilderVolume* Volume)
+{
+	if (!Volume)
+		return FBox(ForceInit);
+
+	FVector Origin, BoxExtent;
+	Volume->GetActorBounds(false, Origin, BoxExtent);
+	return FBox(Origin - BoxExtent, Origin + BoxExtent);
+}
+
+void FSpiderNavGridBuilder::CaptureVolume(const ASpiderNavGridBuilderVolume* Volume, FSpiderNavBuildSettings& Settings)
+{
+	check(IsInGameThread());
+
+	Settings.VolumeBounds = FBox(ForceInit);
+	if (!Volume || !Volume->VolumeBox)
+		return;
+
+	Settings.VolumeTransform = Volume->VolumeBox->GetComponentTransform();
+	Settings.VolumeExtent = Volume->VolumeBox->GetUnscaledBoxExtent();
+	Settings.VolumeBounds = GetVolumeBounds(Volume);
+}
+
+void FSpiderNavGridBuilder::CaptureGeometry(const FBox& Bounds, FSpiderNavGeometrySnapshot& OutSnapshot) const
+{
+	SPIDERNAV_TRACE_SCOPE(SpiderNavBuild_CaptureGeometry);
+
+	OutSnapshot.Reset();
+	if (!World)
+		return;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!Actor || Actor == IgnoredActor)
+			continue;
+
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&Bounds, &OutSnapshot](UPrimitiveComponent* Prim)
+			{
+				// Nur Geometrie, die die Builder-Traces blockiert
+				if (!Prim->IsCollisionEnabled() || Prim->GetCollisionResponseToChannel(ECC_Visibility) != ECR_Block)
+					return;
+
+				const FBox PrimBounds = Prim->Bounds.GetBox();
+				if (!PrimBounds.Intersect(Bounds))
+					return;
+
+				const FTransform& Xf = Prim->GetComponentTransform();
+				const FVector Loc = Xf.GetLocation();
+				const FQuat Rot = Xf.GetRotation();
+				const FVector Scale = Xf.GetScale3D();
+				const double Values[10] = { Loc.X, Loc.Y, Loc.Z, Rot.X, Rot.Y, Rot.Z, Rot.W, Scale.X, Scale.Y, Scale.Z };
+
+				FSpiderNavGeometryEntry Entry;
+				Entry.Bounds = PrimBounds;
+				Entry.Hash = FCrc::MemCrc32(Values, sizeof(Values));
+				Entry.NameHash = GetTypeHash(Prim->GetPathName());
+				if (const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Prim))
+				{
+					if (const UStaticMesh* Mesh = MeshComp->GetStaticMesh())
+						Entry.Hash = HashCombine(Entry.Hash, GetTypeHash(Mesh->GetPathName()));
+				}
+
+				OutSnapshot.Add(FObjectKey(Prim), Entry);
+			});
+	}
+}
+
+FBox FSpiderNavGridBuilder::DiffGeometry(const FSpiderNavGeometrySnapshot& Before, const FSpiderNavGeometrySnapshot& After)
+{
+	FBox Dirty(ForceInit);
+
+	for (const TPair<FObjectKey, FSpiderNavGeometryEntry>& Pair : After)
+	{
+		const FSpiderNavGeometryEntry* Old = Before.Find(Pair.Key);
+		if (!Old)
+		{
+			Dirty += Pair.Value.Bounds;
+		}
+		else if (Old->Hash != Pair.Value.Hash)
+		{
+			Dirty += Old->Bounds;
+			Dirty += Pair.Value.Bounds;
+		}
+	}
+
+	for (const TPair<FObjectKey, FSpiderNavGeometryEntry>& Pair : Before)
+	{
+		if (!After.Contains(Pair.Key))
+			Dirty += Pair.Value.Bounds;
+	}
+
+	return Dirty;
+}
+
+FString FSpiderNavGridBuilder::ComputeInputHash(const ASpiderNavGridBuilderVolume* Volume, const FSpiderNavGeometrySnapshot& Geometry) const
+{
+	FSHA1 Sha;
+	auto Feed = [&Sha](const auto& Value)
+		{
+			Sha.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+		};
+
+	Feed(BuilderVersion);
+	Feed(Settings.GridStepSize);
+	Feed(Settings.BounceNavDistance);
+	Feed(Settings.TraceDistanceModificator);
+	Feed(Settings.ClosePointsFilterModificator);
+	Feed(Settings.ConnectionSphereRadiusModificator);
+	Feed(Settings.TraceDistanceForEdgesModificator);
+	Feed(Settings.EgdeDeviationModificator);
+	Feed(Settings.RelationCellMultiplier);
+
+	if (Volume && Volume->VolumeBox)
+	{
+		const FTransform Xf = Volume->VolumeBox->GetComponentTransform();
+		const FVector Loc = Xf.GetLocation();
+		const FQuat Rot = Xf.GetRotation();
+		const FVector Scale = Xf.GetScale3D();
+		const FVector Extent = Volume->VolumeBox->GetUnscaledBoxExtent();
+		const double Values[13] = { Loc.X, Loc.Y, Loc.Z, Rot.X, Rot.Y, Rot.Z, Rot.W, Scale.X, Scale.Y, Scale.Z, Extent.X, Extent.Y, Extent.Z };
+		Feed(Values);
+	}
+
+	// Map-Reihenfolge ist nicht stabil -> nach Namen sortieren
+	TArray<TPair<uint32, uint32>> Entries;
+	Entries.Reserve(Geometry.Num());
+	for (const TPair<FObjectKey, FSpiderNavGeometryEntry>& Pair : Geometry)
+		Entries.Emplace(Pair.Value.NameHash, Pair.Value.Hash);
+
+	Entries.Sort([](const TPair<uint32, uint32>& A, const TPair<uint32, uint32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+	for (const TPair<uint32, uint32>& Entry : Entries)
+	{
+		Feed(Entry.Key);
+		Feed(Entry.Value);
+	}
+
+	Sha.Final();
+	FSHAHash Hash;
+	Sha.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+FString FSpiderNavGridBuilder::MakePartialInputHash(const FString& InputHash)
+{
+	return InputHash + TEXT("+partial");
+}
+
+FString FSpiderNavGridBuilder::ComputeOutputHash(const TArray<FSpiderNavNodeBuilder>& Nodes)
+{
+	uint32 Crc = 0;
+	for (const FSpiderNavNodeBuilder& Node : Nodes)
+	{
+		const double Values[6] = { Node.Location.X, Node.Location.Y, Node.Location.Z, Node.Normal.X, Node.Normal.Y, Node.Normal.Z };
+		const uint8 bValid = Node.bValid ? 1 : 0;
+		Crc = FCrc::MemCrc32(Values, sizeof(Values), Crc);
+		Crc = FCrc::MemCrc32(&bValid, sizeof(bValid), Crc);
+		Crc = FCrc::MemCrc32(Node.Neighbors.GetData(), Node.Neighbors.Num() * sizeof(int32), Crc);
+	}
+	return FString::Printf(TEXT("%08x"), Crc);
+}
+
+USpiderNavGridSaveGame* FSpiderNavGridBuilder::CreateSaveGame(const TArray<FSpiderNavNodeBuilder>& Nodes, const FString& InputHash)
+{
+	USpiderNavGridSaveGame* Save =
+		Cast<USpiderNavGridSaveGame>(UGameplayStatics::CreateSaveGameObject(USpiderNavGridSaveGame::StaticClass()));
+	if (!Save)
+		return nullptr;
+
+	Save->NavLocations.Reset();
+	Save->NavNormals.Reset();
+	Save->NavRelations.Reset();
+	Save->InputHash = InputHash;
+
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (!Nodes[i].bValid)
+			continue;
+
+		Save->NavLocations.Add(i, Nodes[i].Location);
+		Save->NavNormals.Add(i, Nodes[i].Normal);
+
+		FSpiderNavRelations Rel;
+		Rel.Neighbors = Nodes[i].Neighbors;
+		Save->NavRelations.Add(i, Rel);
+	}
+
+	return Save;
+}
+
+bool FSpiderNavGridBuilder::ReadSaveGame(const USpiderNavGridSaveGame* Save, TArray<FSpiderNavNodeBuilder>& OutNodes)
+{
+	OutNodes.Reset();
+	if (!Save || Save->NavLocations.Num() == 0)
+		return false;
+
+	int32 MaxIndex = -1;
+	for (const TPair<int32, FVector>& Pair : Save->NavLocations)
+		MaxIndex = FMath::Max(MaxIndex, Pair.Key);
+
+	OutNodes.SetNum(MaxIndex + 1);
+	for (FSpiderNavNodeBuilder& Node : OutNodes)
+		Node.bValid = false;
+
+	for (const TPair<int32, FVector>& Pair : Save->NavLocations)
+	{
+		FSpiderNavNodeBuilder& Node = OutNodes[Pair.Key];
+		Node.Location = Pair.Value;
+		const FVector* Normal = Save->NavNormals.Find(Pair.Key);
+		Node.Normal = Normal ? *Normal : FVector::UpVector;
+		Node.bValid = true;
+	}
+
+	for (const TPair<int32, FSpiderNavRelations>& Pair : Save->NavRelations)
+	{
+		if (!OutNodes.IsValidIndex(Pair.Key) || !OutNodes[Pair.Key].bValid)
+			continue;
+
+		for (int32 Neighbor : Pair.Value.Neighbors)
+		{
+			if (OutNodes.IsValidIndex(Neighbor) && OutNodes[Neighbor].bValid)
+				OutNodes[Pair.Key].Neighbors.Add(Neighbor);
+		}
+	}
+
+	return true;
+}
+
+int64 FSpiderNavGridBuilder::CountEdges(const TArray<FSpiderNavNodeBuilder>& Nodes)
+{
+	int64 Edges = 0;
+	for (const FSpiderNavNodeBuilder& Node : Nodes)
+		Edges += Node.Neighbors.Num();
+	return Edges / 2;
+}
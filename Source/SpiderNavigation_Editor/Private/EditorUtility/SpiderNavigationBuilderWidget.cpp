@@ -1,17 +1,26 @@
 ﻿// Copyright Yves Tanas 2025
 
 #include "EditorUtility/SpiderNavigationBuilderWidget.h"
+#include "EditorUtility/SpiderNavGridBuilder.h"
 #include "Structs/SpiderDebugRenderer.h"
 #include "Actors/SpiderNavGridBuilderVolume.h"
 #include "SaveGame/SpiderNavGridSaveGame.h"
+#include "Components/SpiderNavGridVisualizerComponent.h"
+#include "EditorUtility/SpiderNavBuildJob.h"
+#include "EditorUtility/SpiderNavBuildReport.h"
 #include "Components/Button.h"
+#include "Components/ProgressBar.h"
+#include "Components/TextBlock.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Async/Async.h"
 #include "HAL/PlatformProcess.h"
 #include "Kismet/GameplayStatics.h"
 #include "Editor.h"
 #include "Containers/Ticker.h"
 #include "Components/BoxComponent.h"
+#include "Components/LineBatchComponent.h"
 #include "Engine/World.h"
+#include "Misc/CoreDelegates.h"
 
 // ---------------------------------------------------
 // Logging Helper
@@ -27,6 +36,7 @@ namespace SpiderBuilderConfig
 {
     static constexpr float WORKER_SLEEP_SEC = 0.0015f;   // sanftes Throttling im Worker
     static constexpr float DEBUG_FLUSH_TICK = 0.05f;     // 20 FPS Debug-Flush
+    static constexpr float PROGRESS_POLL_TICK = 0.1f;    // Fortschritt des Build-Jobs
 }
 
 // ---------------------------------------------------
@@ -44,6 +54,16 @@ static void EnqueueOnGameThreadDelayed(TFunction<void()>&& Func, float DelaySeco
     );
 }
 
+/** Shows the grid on a visualizer component of the builder volume, if it has one */
+static void UpdateVisualizer(ASpiderNavGridBuilderVolume* BuilderVolume, const USpiderNavGridSaveGame* SaveGame)
+{
+    if (!BuilderVolume)
+        return;
+
+    if (USpiderNavGridVisualizerComponent* Visualizer = BuilderVolume->FindComponentByClass<USpiderNavGridVisualizerComponent>())
+        Visualizer->SetGridFromSaveGame(SaveGame);
+}
+
 // ===================================================
 // Constructor & Init
 // ===================================================
@@ -72,6 +92,8 @@ void USpiderNavigationBuilderWidget::NativeConstruct()
     if (Save) { Save->OnClicked.AddDynamic(this, &USpiderNavigationBuilderWidget::OnSaveClicked); }
     if (Load) { Load->OnClicked.AddDynamic(this, &USpiderNavigationBuilderWidget::OnLoadClicked); }
     if (Debug) { Debug->OnClicked.AddDynamic(this, &USpiderNavigationBuilderWidget::OnDebugClicked); }
+    if (RebuildDirty) { RebuildDirty->OnClicked.AddDynamic(this, &USpiderNavigationBuilderWidget::OnRebuildDirtyClicked); }
+    if (CancelGeneration) { CancelGeneration->OnClicked.AddDynamic(this, &USpiderNavigationBuilderWidget::OnCancelGenerationClicked); }
 
     // Periodischer Flush des Debug-Renderers in die Editor-Welt
     static bool bRendererTickerRegistered = false;
@@ -94,12 +116,29 @@ void USpiderNavigationBuilderWidget::NativeConstruct()
         bRendererTickerRegistered = true;
     }
 
+    MapChangeHandle = FEditorDelegates::MapChange.AddUObject(this, &USpiderNavigationBuilderWidget::OnMapChanged);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &USpiderNavigationBuilderWidget::OnWorldCleanup);
+    PreExitHandle = FCoreDelegates::OnPreExit.AddUObject(this, &USpiderNavigationBuilderWidget::AbortBuildJob);
+
     SPIDER_LOG(LogTemp, Log, TEXT("NativeConstruct() ready."));
 }
 
 void USpiderNavigationBuilderWidget::NativeDestruct()
 {
-    // Nichts Spezielles nötig – alles non-blocking und ohne persistenten Ticker pro Widget
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+
+    // Laufenden Build abbrechen und auf das Ende des aktuellen Chunks warten
+    AbortBuildJob();
+    if (BuildTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(BuildTickerHandle);
+        FSlateNotificationManager::Get().CancelProgressNotification(BuildNotification);
+    }
+    ActiveJob.Reset();
+    Worker.Reset();
+
     Super::NativeDestruct();
     SPIDER_LOG(LogTemp, Log, TEXT("NativeDestruct()"));
 }
@@ -110,21 +149,48 @@ void USpiderNavigationBuilderWidget::NativeDestruct()
 void USpiderNavigationBuilderWidget::OnGenerateClicked()
 {
     SPIDER_LOG(LogTemp, Log, TEXT("OnGenerateClicked"));
+    if (!EnsureVolume())
+        return;
+
+    const FString InputHash = ComputeCurrentInputHash();
+    if (bSkipUnchangedBuilds && !InputHash.IsEmpty())
+    {
+        const USpiderNavGridSaveGame* Defaults = GetDefault<USpiderNavGridSaveGame>();
+        const USpiderNavGridSaveGame* Existing =
+            Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromSlot(Defaults->SaveSlotName, Defaults->UserIndex));
+
+        if (Existing && Existing->InputHash == InputHash)
+        {
+            SPIDER_LOG(LogTemp, Log, TEXT("Inputs unchanged (%s) – skipping generation, loading saved grid."), *InputHash);
+            LoadGridIntoNodes();
+            return;
+        }
+    }
+
     // Optional: vorherige Daten löschen
     GeneratedNodes.Reset();
-    SpawnTracersAsync();
+    StartBuildJob(InputHash);
 }
 
 void USpiderNavigationBuilderWidget::OnCancelGenerationClicked()
 {
-
+    SPIDER_LOG(LogTemp, Log, TEXT("OnCancelGenerationClicked"));
+    if (IsBuildRunning())
+        ActiveJob->Cancel();
 }
 
 void USpiderNavigationBuilderWidget::OnClearClicked()
 {
     SPIDER_LOG(LogTemp, Log, TEXT("OnClearClicked"));
     // Nur Debug-Layer leeren & Daten resetten
-    GeneratedNodes.Reset();// DebugRenderer clear not implemented — just reset generated data
+    GeneratedNodes.Reset();
+    FSpiderDebugRenderer::Get().Clear();
+    if (GEditor)
+    {
+        UWorld* W = GEditor->GetEditorWorldContext().World();
+        if (W && W->LineBatcher)
+            W->LineBatcher->Flush();
+    }
 }
 
 void USpiderNavigationBuilderWidget::OnSaveClicked()
@@ -135,7 +201,8 @@ void USpiderNavigationBuilderWidget::OnSaveClicked()
 
 void USpiderNavigationBuilderWidget::OnLoadClicked()
 {
-    SPIDER_LOG(LogTemp, Log, TEXT("OnLoadClicked (not implemented)"));
+    SPIDER_LOG(LogTemp, Log, TEXT("OnLoadClicked"));
+    LoadGridIntoNodes();
 }
 
 void USpiderNavigationBuilderWidget::OnDebugClicked()
@@ -144,6 +211,12 @@ void USpiderNavigationBuilderWidget::OnDebugClicked()
     SPIDER_LOG(LogTemp, Log, TEXT("DebugDraw toggled: %s"), bDebugDraw ? TEXT("ON") : TEXT("OFF"));
 }
 
+void USpiderNavigationBuilderWidget::OnRebuildDirtyClicked()
+{
+    SPIDER_LOG(LogTemp, Log, TEXT("OnRebuildDirtyClicked"));
+    RebuildDirtyRegion();
+}
+
 // ===================================================
 // Helpers
 // ===================================================
@@ -171,277 +244,240 @@ bool USpiderNavigationBuilderWidget::EnsureVolume()
     return false;
 }
 
-// ===================================================
-// Spawn "Tracers" → Struct-based grid points (NO Actors)
-// ===================================================
-void USpiderNavigationBuilderWidget::SpawnTracersAsync()
+FSpiderNavBuildSettings USpiderNavigationBuilderWidget::MakeBuildSettings() const
 {
-    if (!EnsureVolume())
+    FSpiderNavBuildSettings Settings;
+    Settings.GridStepSize = GridStepSize;
+    Settings.BounceNavDistance = BounceNavDistance;
+    Settings.TraceDistanceModificator = TraceDistanceModificator;
+    Settings.ClosePointsFilterModificator = ClosePointsFilterModificator;
+    Settings.ConnectionSphereRadiusModificator = ConnectionSphereRadiusModificator;
+    Settings.TraceDistanceForEdgesModificator = TraceDistanceForEdgesModificator;
+    Settings.EgdeDeviationModificator = EgdeDeviationModificator;
+    Settings.RelationCellMultiplier = RelationCellMultiplier;
+    Settings.ThrottleSleepSeconds = SpiderBuilderConfig::WORKER_SLEEP_SEC;
+    Settings.bDebugDraw = bDebugDraw;
+    FSpiderNavGridBuilder::CaptureVolume(Volume, Settings);
+    return Settings;
+}
+
+FBox USpiderNavigationBuilderWidget::GetVolumeBounds() const
+{
+    return FSpiderNavGridBuilder::GetVolumeBounds(Volume);
+}
+
+void USpiderNavigationBuilderWidget::CaptureGeometrySnapshot()
+{
+    if (!GEditor || !Volume)
         return;
 
-    FVector Origin, BoxExtent;
-    Volume->GetActorBounds(false, Origin, BoxExtent);
-
-    const FVector   GridStart = Origin - BoxExtent;
-    const FVector   GridEnd = Origin + BoxExtent;
-    const FTransform BoxXf = Volume->VolumeBox->GetComponentTransform();
-    const FVector   Extent = Volume->VolumeBox->GetUnscaledBoxExtent();
-
-    // Reservierung (grobe Schätzung, vermeidet Reallocs)
-    TArray<FSpiderNavNodeBuilder> LocalNodes;
-    LocalNodes.Reserve(
-        FMath::Max(1,
-            int32(((GridEnd.X - GridStart.X) / GridStepSize) + 1) *
-            int32(((GridEnd.Y - GridStart.Y) / GridStepSize) + 1) *
-            int32(((GridEnd.Z - GridStart.Z) / GridStepSize) + 1)
-        )
-    );
+    const FSpiderNavGridBuilder Builder(GEditor->GetEditorWorldContext().World(), MakeBuildSettings(), Volume);
+    Builder.CaptureGeometry(GetVolumeBounds(), GeometrySnapshot);
+    SPIDER_LOG(LogTemp, Log, TEXT("Geometry snapshot: %d primitives."), GeometrySnapshot.Num());
+}
 
-    SPIDER_LOG(LogTemp, Log, TEXT("SpawnTracersAsync: Step=%.1f Bounds:%s -> %s"),
-        GridStepSize, *GridStart.ToString(), *GridEnd.ToString());
+bool USpiderNavigationBuilderWidget::LoadGridIntoNodes()
+{
+    USpiderNavGridSaveGame* Defaults = GetMutableDefault<USpiderNavGridSaveGame>();
+    USpiderNavGridSaveGame* Loaded =
+        Cast<USpiderNavGridSaveGame>(UGameplayStatics::LoadGameFromSlot(Defaults->SaveSlotName, Defaults->UserIndex));
 
-    Async(EAsyncExecution::Thread, [this, GridStart, GridEnd, Extent, BoxXf, LocalNodes = MoveTemp(LocalNodes)]() mutable
-        {
-            int64 Pushed = 0;
+    if (!FSpiderNavGridBuilder::ReadSaveGame(Loaded, GeneratedNodes))
+    {
+        SPIDER_LOG(LogTemp, Warning, TEXT("No saved grid in slot %s."), *Defaults->SaveSlotName);
+        return false;
+    }
 
-            for (float x = GridStart.X; x <= GridEnd.X; x += GridStepSize)
-            {
-                for (float y = GridStart.Y; y <= GridEnd.Y; y += GridStepSize)
-                {
-                    for (float z = GridStart.Z; z <= GridEnd.Z; z += GridStepSize)
-                    {
-                        const FVector Point = FVector(x, y, z);
-                        const FVector Local = BoxXf.InverseTransformPosition(Point);
+    // Annahme: gespeichertes Grid passt zur aktuellen Geometrie -> Basis für Dirty-Erkennung
+    if (EnsureVolume())
+    {
+        CaptureGeometrySnapshot();
+        UpdateVisualizer(Volume, Loaded);
+    }
+    CurrentInputHash = Loaded->InputHash;
 
-                        if (FMath::Abs(Local.X) <= Extent.X &&
-                            FMath::Abs(Local.Y) <= Extent.Y &&
-                            FMath::Abs(Local.Z) <= Extent.Z)
-                        {
-                            LocalNodes.Emplace(FSpiderNavNodeBuilder{ Point, FVector::UpVector });
-                            if (bDebugDraw)
-                                FSpiderDebugRenderer::Get().EnqueuePoint(Point, 2, FColor::Yellow, 0.25f);
+    SPIDER_LOG(LogTemp, Log, TEXT("Loaded %d node slots from %s."), GeneratedNodes.Num(), *Defaults->SaveSlotName);
+    return true;
+}
 
-                            ++Pushed;
-                            if ((Pushed % 50000) == 0)
-                                SPIDER_LOG(LogTemp, Log, TEXT("Prepared %lld points..."), Pushed);
-                        }
-                    }
-                }
-                FPlatformProcess::Sleep(SpiderBuilderConfig::WORKER_SLEEP_SEC);
-            }
+FString USpiderNavigationBuilderWidget::ComputeCurrentInputHash() const
+{
+    if (!GEditor || !Volume)
+        return FString();
 
-            AsyncTask(ENamedThreads::GameThread, [this, LocalNodes = MoveTemp(LocalNodes)]() mutable
-                {
-                    GeneratedNodes = MoveTemp(LocalNodes);
-                    SPIDER_LOG(LogTemp, Log, TEXT("Generated %d tracer nodes."), GeneratedNodes.Num());
-                    TraceFromAllTracersAsync();
-                });
-        });
+    const FSpiderNavGridBuilder Builder(GEditor->GetEditorWorldContext().World(), MakeBuildSettings(), Volume);
+    FSpiderNavGeometrySnapshot Geometry;
+    Builder.CaptureGeometry(GetVolumeBounds(), Geometry);
+    return Builder.ComputeInputHash(Volume, Geometry);
 }
 
 // ===================================================
-// Tracing from nodes (NO Actors) → hit locations as nodes
+// Incremental Rebuild (Dirty Region)
 // ===================================================
-void USpiderNavigationBuilderWidget::TraceFromAllTracersAsync()
+void USpiderNavigationBuilderWidget::RebuildDirtyRegion()
 {
-    if (!GEditor) return;
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World)   return;
+    if (!EnsureVolume())
+        return;
 
-    const TArray<FSpiderNavNodeBuilder> LocalNodes = GeneratedNodes;
-    if (LocalNodes.Num() == 0) return;
+    if (GeneratedNodes.Num() == 0 && !LoadGridIntoNodes())
+    {
+        SPIDER_LOG(LogTemp, Warning, TEXT("No existing grid – running full generation instead."));
+        OnGenerateClicked();
+        return;
+    }
 
-    // Tuning: wie viele Knoten pro Tick (jeder macht 6 Traces)
-    const int32 NodesPerTick = FMath::Max(TracesPerTickHint, 200); // z.B. 2000–6000 auf 7950X3D
-    const float TickDelay = FMath::Max(BuildThrottleDelay, 0.003f);
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    FSpiderNavBuildControl Control;
+    FSpiderNavGridBuilder Builder(World, MakeBuildSettings(), Volume);
+    Builder.SetControl(&Control);
 
-    TSharedRef<int32, ESPMode::ThreadSafe> Index = MakeShared<int32, ESPMode::ThreadSafe>(0);
-    TSharedRef<TArray<FSpiderNavNodeBuilder>, ESPMode::ThreadSafe> HitNodes =
-        MakeShared<TArray<FSpiderNavNodeBuilder>, ESPMode::ThreadSafe>();
-    HitNodes->Reserve(LocalNodes.Num() * 3);
+    FBox DirtyBox(ForceInit);
+    FSpiderNavGeometrySnapshot CurrentGeometry;
+    Builder.CaptureGeometry(GetVolumeBounds(), CurrentGeometry);
 
-    static const FVector Dirs[6] = {
-        FVector(1, 0, 0), FVector(-1, 0, 0),
-        FVector(0, 1, 0), FVector(0,-1, 0),
-        FVector(0, 0, 1), FVector(0, 0,-1)
-    };
+    if (bUseManualDirtyBox)
+    {
+        DirtyBox = ManualDirtyBox;
+    }
+    else
+    {
+        DirtyBox = FSpiderNavGridBuilder::DiffGeometry(GeometrySnapshot, CurrentGeometry);
+    }
 
-    const float TraceDist = GridStepSize * TraceDistanceModificator;
+    if (DirtyBox.IsValid)
+        DirtyBox = DirtyBox.Overlap(GetVolumeBounds());
 
-    FTickerDelegate Tick = FTickerDelegate::CreateWeakLambda(this,
-        [this, World, LocalNodes, HitNodes, Index, NodesPerTick, TraceDist](float)->bool
-        {
-            if (!IsValid(World)) return false;
+    if (!DirtyBox.IsValid)
+    {
+        SPIDER_LOG(LogTemp, Log, TEXT("Nothing changed inside the volume – grid is up to date."));
+        return;
+    }
 
-            const int32 Start = *Index;
-            const int32 End = FMath::Min(Start + NodesPerTick, LocalNodes.Num());
+    const FSpiderNavBuildStageTimer Timer(&Control);
+    const FSpiderNavIncrementalStats Stats = Builder.RebuildRegion(DirtyBox, GeneratedNodes);
 
-            FCollisionQueryParams Q(FName(TEXT("SpiderTraceGT")), /*bTraceComplex*/false);
-            if (Volume) Q.AddIgnoredActor(Volume);
+    BuildStages.Reset();
+    FSpiderNavBuildStageStats& Stage = BuildStages.AddDefaulted_GetRef();
+    Stage.Name = TEXT("Incremental");
+    Timer.Finish(Stage);
+    Stage.NodesOut = GeneratedNodes.Num();
+    Stage.EdgesOut = FSpiderNavGridBuilder::CountEdges(GeneratedNodes);
+    CurrentInputHash = FSpiderNavGridBuilder::MakePartialInputHash(Builder.ComputeInputHash(Volume, CurrentGeometry));
+    GeometrySnapshot = MoveTemp(CurrentGeometry);
 
-            for (int32 i = Start; i < End; ++i)
-            {
-                const FVector Base = LocalNodes[i].Location;
+    SPIDER_LOG(LogTemp, Log, TEXT("Incremental rebuild %s: -%d +%d nodes, %d relinked, +%lld edges in %.2f s."),
+        *Stats.Region.ToString(), Stats.RemovedNodes, Stats.AddedNodes, Stats.RelinkedNodes, Stats.EdgesAdded, Stats.WallSeconds);
 
-                for (const FVector& Dir : Dirs)
-                {
-                    const FVector S = Base + Dir * 5.f;
-                    const FVector E = S + Dir * TraceDist;
+    SaveGridFromData();
+}
 
-                    FHitResult Hit;
-                    const bool bHit = World->LineTraceSingleByChannel(Hit, S, E, ECollisionChannel::ECC_Visibility, Q);
-                    if (bHit && Hit.bBlockingHit)
-                    {
-                        const FVector L = Hit.Location + Hit.Normal * BounceNavDistance;
-                        HitNodes->Emplace(FSpiderNavNodeBuilder{ L, Hit.Normal });
+// ===================================================
+// Full build as cancellable job on the worker thread
+// ===================================================
+void USpiderNavigationBuilderWidget::StartBuildJob(const FString& InputHash)
+{
+    if (!EnsureVolume())
+        return;
 
-                        if (bDebugDraw)
-                            FSpiderDebugRenderer::Get().EnqueueSphere(L, 6.f, FColor::Green, 0.75f);
-                    }
-                    else if (bDebugDraw)
-                    {
-                        FSpiderDebugRenderer::Get().EnqueueLine(S, E, FColor::Red, 0.25f);
-                    }
-                }
-            }
+    if (IsBuildRunning())
+    {
+        SPIDER_LOG(LogTemp, Warning, TEXT("A build is already running."));
+        return;
+    }
 
-            *Index = End;
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    ActiveJob = MakeShared<FSpiderNavBuildJob, ESPMode::ThreadSafe>(World, MakeBuildSettings(), Volume, InputHash);
 
-            if (End >= LocalNodes.Num())
-            {
-                // fertig
-                GeneratedNodes = MoveTemp(*HitNodes);
-                SPIDER_LOG(LogTemp, Log, TEXT("TraceFromAllTracersAsync done. %d nodes."), GeneratedNodes.Num());
-                BuildRelationsDataAsync();
-                return false;
-            }
+    if (!Worker.IsValid())
+        Worker = MakeShared<FSpiderNavWorker>(this);
 
-            return true; // nächsten Tick weitermachen
+    SPIDER_LOG(LogTemp, Log, TEXT("Build job queued: Step=%.1f Volume:%s Hash:%s"), GridStepSize, *Volume->GetName(), *InputHash);
+    Worker->EnqueueTask([Job = ActiveJob]()
+        {
+            Job->Run();
         });
 
-    FTSTicker::GetCoreTicker().AddTicker(Tick, TickDelay);
+    BuildNotification = FSlateNotificationManager::Get().StartProgressNotification(
+        NSLOCTEXT("SpiderNavigation", "BuildProgress", "Building Spider Navigation Grid"), 100);
+
+    BuildTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &USpiderNavigationBuilderWidget::PollBuildJob),
+        SpiderBuilderConfig::PROGRESS_POLL_TICK);
 }
 
+void USpiderNavigationBuilderWidget::AbortBuildJob()
+{
+    if (!ActiveJob.IsValid() || ActiveJob->IsFinished())
+        return;
 
+    SPIDER_LOG(LogTemp, Log, TEXT("Aborting build job during %s."), FSpiderNavBuildJob::GetStageName(ActiveJob->GetCurrentStage()));
+    ActiveJob->CancelAndWait();
+}
 
-// ===================================================
-// Build Relations (visibility edges between generated nodes)
-// ===================================================
-void USpiderNavigationBuilderWidget::BuildRelationsDataAsync()
+void USpiderNavigationBuilderWidget::OnMapChanged(uint32 MapChangeFlags)
 {
-    const int32 Total = GeneratedNodes.Num();
-    if (Total == 0) return;
-    if (!GEditor) return;
-
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World) return;
-
-    // =====================================================
-    // 🧠 Performance-Tuning Parameter
-    // =====================================================
-    const float Radius = GridStepSize * ConnectionSphereRadiusModificator;
-    const float CellSize = Radius * RelationCellMultiplier; // typ. 1.25f
-    const float RadiusSq = Radius * Radius;
-
-    SPIDER_LOG(LogTemp, Log,
-        TEXT("BuildRelationsDataAsync() started. Nodes=%d | CellSize=%.1f"),
-        Total, CellSize);
-
-    // =====================================================
-    // 🧩 Step 1: Spatial Grid vorbereiten
-    // =====================================================
-    TMap<FIntVector, TArray<int32>> Grid;
-    Grid.Reserve(Total);
-
-    for (int32 i = 0; i < Total; ++i)
-    {
-        const FVector& P = GeneratedNodes[i].Location;
-        const FIntVector Key(
-            FMath::FloorToInt(P.X / CellSize),
-            FMath::FloorToInt(P.Y / CellSize),
-            FMath::FloorToInt(P.Z / CellSize));
+    AbortBuildJob();
+}
 
-        Grid.FindOrAdd(Key).Add(i);
-    }
+void USpiderNavigationBuilderWidget::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    // Feuert vor dem Abbau der Welt, MapChange erst danach
+    if (GEditor && World == GEditor->GetEditorWorldContext().World())
+        AbortBuildJob();
+}
 
-    SPIDER_LOG(LogTemp, Log, TEXT("Spatial grid built with %d cells."), Grid.Num());
+bool USpiderNavigationBuilderWidget::PollBuildJob(float DeltaTime)
+{
+    if (!ActiveJob.IsValid())
+        return false;
 
-    // =====================================================
-    // 🧩 Step 2: Parallel Nachbarschaften berechnen
-    // =====================================================
-    TSharedRef<TArray<TSet<int32>>, ESPMode::ThreadSafe> Neighbors =
-        MakeShared<TArray<TSet<int32>>, ESPMode::ThreadSafe>();
-    Neighbors->SetNum(Total);
+    const float Progress = ActiveJob->GetProgress();
+    if (BuildProgress)
+        BuildProgress->SetPercent(Progress);
 
-    // Multithreaded Relation Building
-    ParallelFor(Total, [this, &Grid, Neighbors, CellSize, RadiusSq, World](int32 i)
-        {
-            // 🧩 Thread-lokales Set
-            TSet<int32> LocalNeighbors;
-            LocalNeighbors.Reserve(128);
-
-            const FVector& A = GeneratedNodes[i].Location;
-            const FIntVector Cell(
-                FMath::FloorToInt(A.X / CellSize),
-                FMath::FloorToInt(A.Y / CellSize),
-                FMath::FloorToInt(A.Z / CellSize));
-
-            FCollisionQueryParams Q(FName(TEXT("SpiderRelTrace")), false);
-            if (Volume) Q.AddIgnoredActor(Volume);
-
-            // Umgebung (3×3×3 Zellen prüfen)
-            for (int32 dx = -1; dx <= 1; ++dx)
-                for (int32 dy = -1; dy <= 1; ++dy)
-                    for (int32 dz = -1; dz <= 1; ++dz)
-                    {
-                        const FIntVector NCell = Cell + FIntVector(dx, dy, dz);
-                        const TArray<int32>* Bucket = Grid.Find(NCell);
-                        if (!Bucket) continue;
+    FSlateNotificationManager::Get().UpdateProgressNotification(BuildNotification, FMath::RoundToInt(Progress * 100.f), 0,
+        FText::Format(NSLOCTEXT("SpiderNavigation", "BuildStage", "Spider Navigation Grid: {0}"),
+            FText::FromString(FSpiderNavBuildJob::GetStageName(ActiveJob->GetCurrentStage()))));
 
-                        for (int32 j : *Bucket)
-                        {
-                            if (j <= i) continue;
-                            const FVector& B = GeneratedNodes[j].Location;
-                            if (FVector::DistSquared(A, B) > RadiusSq)
-                                continue;
-
-                            FHitResult Hit;
-                            if (!World->LineTraceSingleByChannel(Hit, A, B, ECC_Visibility, Q))
-                            {
-                                LocalNeighbors.Add(j);
-
-                                if (bDebugDraw)
-                                    FSpiderDebugRenderer::Get().EnqueueLine(A, B, FColor::Blue, 1.0f);
-                            }
-                        }
-                    }
+    if (!ActiveJob->IsFinished())
+        return true;
 
-            // 🧵 Sicherer Merge (CriticalSection)
-            {
-                FScopeLock Lock(&RelationCritical);
-                (*Neighbors)[i].Append(LocalNeighbors);
-                for (int32 j : LocalNeighbors)
-                    (*Neighbors)[j].Add(i);
-            }
+    FSlateNotificationManager::Get().CancelProgressNotification(BuildNotification);
+    BuildTickerHandle.Reset();
 
-        }, EParallelForFlags::None);
+    TSharedPtr<FSpiderNavBuildJob, ESPMode::ThreadSafe> Job = MoveTemp(ActiveJob);
+    switch (Job->GetState())
+    {
+    case ESpiderNavBuildJobState::Succeeded:
+        GeneratedNodes = MoveTemp(Job->GetNodes());
+        CurrentInputHash = Job->GetInputHash();
+        BuildStages = Job->GetStageStats();
+        SPIDER_LOG(LogTemp, Log, TEXT("✅ Build completed. %d nodes, %lld edges, output %s."),
+            GeneratedNodes.Num(), FSpiderNavGridBuilder::CountEdges(GeneratedNodes), *FSpiderNavGridBuilder::ComputeOutputHash(GeneratedNodes));
+        CaptureGeometrySnapshot();
+        SaveGridFromData();
+        break;
+
+    case ESpiderNavBuildJobState::Cancelled:
+        SPIDER_LOG(LogTemp, Log, TEXT("Build cancelled in stage %s. Completed stages are kept and resumed on the next Generate."),
+            FSpiderNavBuildJob::GetStageName(Job->GetCurrentStage()));
+        break;
+
+    default:
+        SPIDER_LOG(LogTemp, Error, TEXT("Build failed."));
+        break;
+    }
+    return false;
+}
 
-    // =====================================================
-    // 🧩 Step 3: Übergabe an GameThread
-    // =====================================================
-    AsyncTask(ENamedThreads::GameThread, [this, Neighbors]()
-        {
-            const int32 N = GeneratedNodes.Num();
-            for (int32 i = 0; i < N; ++i)
-            {
-                GeneratedNodes[i].Neighbors.Reset();
-                for (int32 j : (*Neighbors)[i])
-                    GeneratedNodes[i].Neighbors.Add(j);
-            }
+float USpiderNavigationBuilderWidget::GetBuildProgress() const
+{
+    return ActiveJob.IsValid() ? ActiveJob->GetProgress() : 0.f;
+}
 
-            SPIDER_LOG(LogTemp, Log, TEXT("✅ BuildRelationsDataAsync completed safely. %d nodes processed."), N);
-            SaveGridFromData();
-        });
+bool USpiderNavigationBuilderWidget::IsBuildRunning() const
+{
+    return ActiveJob.IsValid() && !ActiveJob->IsFinished();
 }
 
 // ===================================================
@@ -451,34 +487,47 @@ void USpiderNavigationBuilderWidget::BuildRelationsDataAsync()
 
 void USpiderNavigationBuilderWidget::SaveGridFromData()
 {
-    AsyncTask(ENamedThreads::GameThread, [Nodes = GeneratedNodes]()
+    // Stages gehören zu genau einem Save; ein manueller Save danach meldet nur sich selbst
+    TArray<FSpiderNavBuildStageStats> Stages = MoveTemp(BuildStages);
+    BuildStages.Reset();
+
+    AsyncTask(ENamedThreads::GameThread, [Nodes = GeneratedNodes, InputHash = CurrentInputHash, Stages = MoveTemp(Stages),
+        WeakVolume = TWeakObjectPtr<ASpiderNavGridBuilderVolume>(Volume), WeakThis = TWeakObjectPtr<USpiderNavigationBuilderWidget>(this)]() mutable
         {
-            USpiderNavGridSaveGame* Save =
-                Cast<USpiderNavGridSaveGame>(UGameplayStatics::CreateSaveGameObject(USpiderNavGridSaveGame::StaticClass()));
+            const FSpiderNavBuildStageTimer SaveTimer;
+            USpiderNavGridSaveGame* Save = FSpiderNavGridBuilder::CreateSaveGame(Nodes, InputHash);
             if (!Save)
             {
                 UE_LOG(LogTemp, Error, TEXT("[SpiderBuilder] SaveGridFromData: Could not create SaveGame object"));
                 return;
             }
 
-            Save->NavLocations.Reset();
-            Save->NavNormals.Reset();
-            Save->NavRelations.Reset();
-
-            for (int32 i = 0; i < Nodes.Num(); ++i)
-            {
-                Save->NavLocations.Add(i, Nodes[i].Location);
-                Save->NavNormals.Add(i, Nodes[i].Normal);
-
-                FSpiderNavRelations Rel;
-                Rel.Neighbors = Nodes[i].Neighbors;
-                Save->NavRelations.Add(i, Rel);
-            }
+            UpdateVisualizer(WeakVolume.Get(), Save);
 
             if(USpiderNavGridEditorSubsystem* Subsystem = GEditor->GetEditorSubsystem<USpiderNavGridEditorSubsystem>())
             {
                 const bool OK = Subsystem->SaveGrid(Save->SaveSlotName, Save->UserIndex, Save);
+                if (OK)
+                    FSpiderNavBuildJob::DiscardCheckpoints(InputHash);
                 UE_LOG(LogTemp, Log, TEXT("[SpiderBuilder] Save %s (%d nodes)."), OK ? TEXT("SUCCESS") : TEXT("FAILED"), Nodes.Num());
+
+                FSpiderNavBuildStageStats& SaveStage = Stages.AddDefaulted_GetRef();
+                SaveStage.Name = TEXT("Save");
+                SaveTimer.Finish(SaveStage);
+                SaveStage.NodesOut = Nodes.Num();
+                SaveStage.EdgesOut = FSpiderNavGridBuilder::CountEdges(Nodes);
+
+                const FString Report = FSpiderNavBuildReport::ToText(Stages);
+                UE_LOG(LogTemp, Log, TEXT("[SpiderBuilder] Build report:\n%s"), *Report);
+                if (OK)
+                    FSpiderNavBuildReport::Write(Save->SaveSlotName, InputHash, Stages);
+
+                if (USpiderNavigationBuilderWidget* Widget = WeakThis.Get())
+                {
+                    Widget->LastBuildReport = Report;
+                    if (Widget->BuildReportText)
+                        Widget->BuildReportText->SetText(FText::FromString(Report));
+                }
             }
             else
             {
@@ -486,3 +535,8 @@ void USpiderNavigationBuilderWidget::SaveGridFromData()
             }
         });
 }
+
+FString USpiderNavigationBuilderWidget::GetLastBuildReport() const
+{
+    return LastBuildReport;
+}
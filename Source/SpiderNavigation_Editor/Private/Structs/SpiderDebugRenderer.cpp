@@ -1,61 +1,137 @@
 #include "Structs/SpiderDebugRenderer.h"
-#include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
 #include "Engine/World.h"
 
+namespace SpiderDebugRendererPrivate
+{
+    /** Segments per great circle when a sphere is turned into lines */
+    static constexpr int32 SPHERE_SEGMENTS = 12;
+
+    /** Highest decimation stride exponent (keep 1 of 256) */
+    static constexpr int32 MAX_DECIMATION_SHIFT = 8;
+}
+
+FSpiderDebugRenderer::FThreadBuffer& FSpiderDebugRenderer::GetThreadBuffer()
+{
+    // Ein Buffer pro Producer-Thread, einmalig registriert
+    static thread_local FThreadBuffer* LocalBuffer = nullptr;
+    if (!LocalBuffer)
+    {
+        FScopeLock RegistryLock(&RegistryMutex);
+        LocalBuffer = Buffers.Add_GetRef(MakeUnique<FThreadBuffer>()).Get();
+    }
+    return *LocalBuffer;
+}
+
+bool FSpiderDebugRenderer::ShouldKeep(FThreadBuffer& Buffer, int32 Count)
+{
+    const int32 Pending = PendingCount.load(std::memory_order_relaxed);
+    if (Pending < MaxPending)
+    {
+        PendingCount.fetch_add(Count, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Je weiter über dem Limit, desto gröber ausdünnen
+    const int32 Shift = FMath::Min(Pending / MaxPending, SpiderDebugRendererPrivate::MAX_DECIMATION_SHIFT);
+    if ((Buffer.Sequence++ & ((1u << Shift) - 1)) != 0)
+    {
+        Dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    PendingCount.fetch_add(Count, std::memory_order_relaxed);
+    return true;
+}
+
 void FSpiderDebugRenderer::EnqueueLine(const FVector& Start, const FVector& End, const FColor& Color, float LifeTime)
 {
-    FSpiderDebugDrawCommand Cmd;
-    Cmd.Type = FSpiderDebugDrawCommand::EType::Line;
-    Cmd.A = Start;
-    Cmd.B = End;
-    Cmd.Color = Color;
-    Cmd.LifeTime = LifeTime;
-    Pending.Enqueue(MoveTemp(Cmd));
+    FThreadBuffer& Buffer = GetThreadBuffer();
+    FScopeLock Lock(&Buffer.Lock);
+    if (ShouldKeep(Buffer, 1))
+        Buffer.Lines.Emplace(Start, End, FLinearColor(Color), LifeTime, 1.f, SDPG_World);
 }
 
 void FSpiderDebugRenderer::EnqueueSphere(const FVector& Center, float Radius, const FColor& Color, float LifeTime)
 {
-    FSpiderDebugDrawCommand Cmd;
-    Cmd.Type = FSpiderDebugDrawCommand::EType::Sphere;
-    Cmd.A = Center;
-    Cmd.Size = Radius;
-    Cmd.Color = Color;
-    Cmd.LifeTime = LifeTime;
-    Pending.Enqueue(MoveTemp(Cmd));
+    using namespace SpiderDebugRendererPrivate;
+
+    FThreadBuffer& Buffer = GetThreadBuffer();
+    FScopeLock Lock(&Buffer.Lock);
+    if (!ShouldKeep(Buffer, 3 * SPHERE_SEGMENTS))
+        return;
+
+    // Drei Großkreise als Liniensegmente -> landen im selben Batch wie die Linien
+    const FLinearColor LinearColor(Color);
+    const float AngleStep = 2.f * PI / SPHERE_SEGMENTS;
+    for (int32 Segment = 0; Segment < SPHERE_SEGMENTS; ++Segment)
+    {
+        float S0, C0, S1, C1;
+        FMath::SinCos(&S0, &C0, Segment * AngleStep);
+        FMath::SinCos(&S1, &C1, (Segment + 1) * AngleStep);
+
+        Buffer.Lines.Emplace(Center + FVector(C0, S0, 0.f) * Radius, Center + FVector(C1, S1, 0.f) * Radius, LinearColor, LifeTime, 0.f, SDPG_World);
+        Buffer.Lines.Emplace(Center + FVector(C0, 0.f, S0) * Radius, Center + FVector(C1, 0.f, S1) * Radius, LinearColor, LifeTime, 0.f, SDPG_World);
+        Buffer.Lines.Emplace(Center + FVector(0.f, C0, S0) * Radius, Center + FVector(0.f, C1, S1) * Radius, LinearColor, LifeTime, 0.f, SDPG_World);
+    }
 }
 
 void FSpiderDebugRenderer::EnqueuePoint(const FVector& Pos, float Size, const FColor& Color, float LifeTime)
 {
-    FSpiderDebugDrawCommand Cmd;
-    Cmd.Type = FSpiderDebugDrawCommand::EType::Point;
-    Cmd.A = Pos;
-    Cmd.Size = Size;
-    Cmd.Color = Color;
-    Cmd.LifeTime = LifeTime;
-    Pending.Enqueue(MoveTemp(Cmd));
+    FThreadBuffer& Buffer = GetThreadBuffer();
+    FScopeLock Lock(&Buffer.Lock);
+    if (ShouldKeep(Buffer, 1))
+        Buffer.Points.Emplace(Pos, FLinearColor(Color), Size, LifeTime, SDPG_World);
 }
 
 void FSpiderDebugRenderer::FlushToWorld(UWorld* World)
 {
-    if (!World)
+    if (!World || !World->LineBatcher)
         return;
 
-    FSpiderDebugDrawCommand Cmd;
-    while (Pending.Dequeue(Cmd))
+    TArray<FBatchedLine> Lines;
+    TArray<FBatchedPoint> Points;
     {
-        switch (Cmd.Type)
+        FScopeLock RegistryLock(&RegistryMutex);
+        for (const TUniquePtr<FThreadBuffer>& Buffer : Buffers)
         {
-        case FSpiderDebugDrawCommand::EType::Line:
-            DrawDebugLine(World, Cmd.A, Cmd.B, Cmd.Color, false, Cmd.LifeTime, 0, 1.f);
-            break;
+            FScopeLock Lock(&Buffer->Lock);
+            Lines.Append(MoveTemp(Buffer->Lines));
+            Points.Append(MoveTemp(Buffer->Points));
+            Buffer->Lines.Reset();
+            Buffer->Points.Reset();
+        }
+    }
+
+    const int32 Flushed = Lines.Num() + Points.Num();
+    if (Flushed == 0)
+        return;
 
-        case FSpiderDebugDrawCommand::EType::Sphere:
-            DrawDebugSphere(World, Cmd.A, Cmd.Size, 8, Cmd.Color, false, Cmd.LifeTime);
-            break;
+    PendingCount.fetch_sub(Flushed, std::memory_order_relaxed);
+    const int32 DroppedSinceFlush = Dropped.exchange(0, std::memory_order_relaxed);
+    UE_CLOG(DroppedSinceFlush > 0, LogTemp, Verbose, TEXT("[SpiderDebugRenderer] Flushed %d primitives, decimated %d."), Flushed, DroppedSinceFlush);
 
-        case FSpiderDebugDrawCommand::EType::Point:
-            DrawDebugPoint(World, Cmd.A, Cmd.Size, Cmd.Color, false, Cmd.LifeTime);
-            break;
-        }
+    // Ein Batch-Aufruf statt eines DrawDebug* pro Primitive
+    ULineBatchComponent* Batcher = World->LineBatcher;
+    if (Lines.Num() > 0)
+        Batcher->DrawLines(Lines);
+
+    if (Points.Num() > 0)
+    {
+        Batcher->BatchedPoints.Append(MoveTemp(Points));
+        Batcher->MarkRenderStateDirty();
+    }
+}
+
+void FSpiderDebugRenderer::Clear()
+{
+    FScopeLock RegistryLock(&RegistryMutex);
+    for (const TUniquePtr<FThreadBuffer>& Buffer : Buffers)
+    {
+        FScopeLock Lock(&Buffer->Lock);
+        PendingCount.fetch_sub(Buffer->Lines.Num() + Buffer->Points.Num(), std::memory_order_relaxed);
+        Buffer->Lines.Reset();
+        Buffer->Points.Reset();
     }
+    Dropped.store(0, std::memory_order_relaxed);
 }
@@ -0,0 +1,37 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpiderNavBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+/**
+ * Headless pathfinding benchmark on synthetic grids, no map required.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=SpiderNavBenchmark [-shapes=Caves,StackedFloors,CubeRooms,RandomGeometric] [-nodes=10000,100000]
+ *     [-queries=1000] [-loads=5] [-seed=1] [-step=40] [-modes=AStar,Bidirectional,Weighted,Anytime] [-epsilon=2] [-deadlinems=1] [-batch=50] [-out=Path.json] -nullrhi -unattended
+ *
+ * For every shape and size it measures grid generation, memory, LoadGrid (save game deserialization and grid build),
+ * FindClosestNodeLocation and FindPath, and writes p50/p90/p99/max/mean in microseconds to a JSON report.
+ * Every search mode in -modes runs the same queries; the first one also fills the top-level findPathUs.
+ * Each mode also runs the queries through FindPathsBatch in batches of -batch, once as given and once as "waves" sharing one goal.
+ */
+UCLASS()
+class SPIDERNAVIGATION_EDITOR_API USpiderNavBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpiderNavBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** p50/p90/p99/max/mean of the samples in microseconds. Sorts Samples */
+	static TSharedRef<FJsonObject> MakePercentiles(TArray<double>& Samples);
+
+	/** Parses "1000,10k,2M" style lists */
+	static TArray<int32> ParseCounts(const FString& Text);
+};
@@ -0,0 +1,40 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpiderNavBuildCommandlet.generated.h"
+
+struct FSpiderNavBuildSettings;
+
+/**
+ * Headless grid build for CI / nightly pipelines.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=SpiderNavBuild -map=/Game/Maps/MyMap [-volume=ActorName] [-slot=SaveSlot] [-step=40] -nullrhi -unattended
+ *
+ * Every FSpiderNavBuildSettings tunable can be overridden by its widget property name, e.g. -ClosePointsFilterModificator=0.3,
+ * so CI builds hash and generate the same grid as the widget with the same values.
+ *
+ * Loads the map, runs every builder stage fully parallel (no ticker throttling),
+ * writes the grid save game and prints per-stage timings and node/edge counts.
+ * With -dirty=MinX,MinY,MinZ,MaxX,MaxY,MaxZ only that region of the saved grid is regenerated.
+ * Full builds write a checkpoint per stage and resume an interrupted build with the same inputs.
+ */
+UCLASS()
+class SPIDERNAVIGATION_EDITOR_API USpiderNavBuildCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpiderNavBuildCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	UWorld* LoadWorld(const FString& MapName) const;
+	class ASpiderNavGridBuilderVolume* FindVolume(UWorld* World, const FString& VolumeName) const;
+	static bool ParseBox(const FString& Text, FBox& OutBox);
+	/** -step and -<Tunable>=Value switches of every input-hashed FSpiderNavBuildSettings field */
+	static void ApplySettingsOverrides(const TMap<FString, FString>& ParamVals, FSpiderNavBuildSettings& Settings);
+};
@@ -0,0 +1,48 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpiderNavValidateCommandlet.generated.h"
+
+class UNavGridComponent;
+struct FSavedSpiderNavGrid;
+
+/** One search engine under test. Epsilon is the allowed suboptimality (cost <= (1 + Epsilon) * optimal) */
+struct FSpiderNavValidationEngine
+{
+	FString Name;
+	float Epsilon = 0.f;
+	TFunction<TArray<FVector>(UNavGridComponent& Navigation, const FVector& Start, const FVector& End, bool& bFoundCompletePath)> FindPath;
+};
+
+/**
+ * Correctness guardrail for the search engines.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=SpiderNavValidate [-shapes=All] [-nodes=20000] [-pairs=500] [-seed=1] [-slot=SaveSlot] [-out=Path.json] -nullrhi -unattended
+ *
+ * Runs seeded start/goal pairs on synthetic grids (and optionally a saved grid) through every engine and compares
+ * against a reference Dijkstra: reachable goals must yield a complete, connected path within the engine's bound,
+ * unreachable goals must report bFoundCompletePath == false with a connected partial path.
+ * Reports failures, expansions and time per engine; returns non-zero if any check failed.
+ */
+UCLASS()
+class SPIDERNAVIGATION_EDITOR_API USpiderNavValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpiderNavValidateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** Engines under test; add new search modes here */
+	static TArray<FSpiderNavValidationEngine> GetEngines();
+
+	/** Shortest path cost from Start to Goal, or a negative value if Goal is unreachable */
+	static double ReferenceDijkstra(const FSavedSpiderNavGrid& Grid, int32 Start, int32 Goal);
+
+private:
+	TSharedRef<class FJsonObject> ValidateGrid(const FString& GridName, FSavedSpiderNavGrid&& Grid, int32 Pairs, int32 Seed, int32& OutFailures) const;
+};
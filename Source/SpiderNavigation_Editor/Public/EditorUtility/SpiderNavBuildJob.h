@@ -0,0 +1,99 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorUtility/SpiderNavGridBuilder.h"
+#include "Templates/SharedPointer.h"
+
+class ASpiderNavGridBuilderVolume;
+
+/** Stages of a full grid build in execution order */
+enum class ESpiderNavBuildStage : uint8
+{
+	Lattice,
+	Trace,
+	Dedup,
+	Relations,
+	Edges,
+	Num
+};
+
+enum class ESpiderNavBuildJobState : uint8
+{
+	Pending,
+	Running,
+	Succeeded,
+	Cancelled,
+	Failed
+};
+
+/**
+ * A full grid build as a job object.
+ * Run() executes the stages on the calling thread (FSpiderNavWorker in the editor, game thread in the commandlet),
+ * Cancel() and the progress getters may be called from any thread.
+ * After every completed stage the nodes are written to Saved/SpiderNav/<InputHash>/ so a cancelled or crashed
+ * build with the same inputs resumes from the last completed stage.
+ * The volume is captured into the settings on construction; world and volume are only held weakly. Whoever owns
+ * the job must CancelAndWait before the world goes away (map change, editor exit), the traces run on that world.
+ */
+class SPIDERNAVIGATION_EDITOR_API FSpiderNavBuildJob : public TSharedFromThis<FSpiderNavBuildJob, ESPMode::ThreadSafe>
+{
+public:
+	/** Without InputHash no checkpoints are read or written. Game thread only */
+	FSpiderNavBuildJob(UWorld* InWorld, const FSpiderNavBuildSettings& InSettings, const ASpiderNavGridBuilderVolume* InVolume, const FString& InInputHash);
+
+	/** Runs the remaining stages. Blocks until done, cancelled or failed */
+	void Run();
+
+	/** Requests cooperative cancellation. The current stage stops at its next chunk boundary */
+	void Cancel();
+
+	/** Cancel and block until Run has returned or, if it has not started yet, will not run any stage */
+	void CancelAndWait();
+
+	ESpiderNavBuildJobState GetState() const { return State.load(); }
+	bool IsFinished() const;
+
+	/** Overall progress in [0, 1], weighted by the typical stage cost */
+	float GetProgress() const;
+
+	ESpiderNavBuildStage GetCurrentStage() const { return (ESpiderNavBuildStage)CurrentStage.load(); }
+
+	/** First stage that was actually executed. Greater than Lattice when resumed from a checkpoint */
+	ESpiderNavBuildStage GetResumedStage() const { return ResumedStage; }
+
+	const FString& GetInputHash() const { return InputHash; }
+
+	/** Resulting nodes. Only read once IsFinished() returns true */
+	TArray<FSpiderNavNodeBuilder>& GetNodes() { return Nodes; }
+	const TArray<FSpiderNavBuildStageStats>& GetStageStats() const { return StageStats; }
+
+	static const TCHAR* GetStageName(ESpiderNavBuildStage Stage);
+
+	/** Directory holding the checkpoints of one input hash */
+	static FString GetCheckpointDir(const FString& InInputHash);
+
+	/** Deletes all checkpoints of one input hash. Call after the grid has been saved */
+	static void DiscardCheckpoints(const FString& InInputHash);
+
+private:
+	/** Loads the newest checkpoint and returns the stage to continue with */
+	ESpiderNavBuildStage RestoreCheckpoint();
+	bool SaveCheckpoint(ESpiderNavBuildStage Stage) const;
+	bool LoadCheckpoint(ESpiderNavBuildStage Stage);
+
+	FSpiderNavBuildControl Control;
+	FSpiderNavGridBuilder Builder;
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<const ASpiderNavGridBuilderVolume> Volume;
+	FString InputHash;
+
+	std::atomic<ESpiderNavBuildJobState> State{ ESpiderNavBuildJobState::Pending };
+	std::atomic<uint8> CurrentStage{ 0 };
+	ESpiderNavBuildStage ResumedStage = ESpiderNavBuildStage::Lattice;
+
+	TArray<FSpiderNavNodeBuilder> Lattice;
+	TArray<FSpiderNavNodeBuilder> Nodes;
+	TArray<FSpiderNavBuildStageStats> StageStats;
+};
@@ -0,0 +1,39 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorUtility/SpiderNavGridBuilder.h"
+
+/** Measures one builder stage from construction to Finish(): wall and process CPU time, memory and traces issued through Control */
+class SPIDERNAVIGATION_EDITOR_API FSpiderNavBuildStageTimer
+{
+public:
+	explicit FSpiderNavBuildStageTimer(const FSpiderNavBuildControl* InControl = nullptr);
+
+	/** Fills the measured fields of Stats. Name, NodesOut and EdgesOut stay with the caller */
+	void Finish(FSpiderNavBuildStageStats& Stats) const;
+
+private:
+	const FSpiderNavBuildControl* Control;
+	double WallStart;
+	double CpuStart;
+	int64 TracesStart;
+};
+
+/**
+ * Per-stage telemetry of a grid build, written next to the save game as Saved/SaveGames/<Slot>.buildreport.json
+ * so builds can be compared across machines and builder changes.
+ */
+struct SPIDERNAVIGATION_EDITOR_API FSpiderNavBuildReport
+{
+	/** User + kernel time of the whole process in seconds. 0 on platforms without process times */
+	static double GetProcessCpuSeconds();
+
+	static FString GetReportPath(const FString& SlotName);
+
+	static bool Write(const FString& SlotName, const FString& InputHash, const TArray<FSpiderNavBuildStageStats>& Stages);
+
+	/** One line per stage plus a total, for the log and the builder widget */
+	static FString ToText(const TArray<FSpiderNavBuildStageStats>& Stages);
+};
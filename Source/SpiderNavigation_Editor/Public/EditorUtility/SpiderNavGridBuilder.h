@@ -0,0 +1,210 @@
+// Copyright Yves Tanas 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Structs/SpiderNavNodeBuilder.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+
+class AActor;
+class UWorld;
+class ASpiderNavGridBuilderVolume;
+class USpiderNavGridSaveGame;
+
+/** Tunables of the grid generation pipeline (mirrors the builder widget properties) and the build volume it runs in */
+struct FSpiderNavBuildSettings
+{
+	/** The minimum distance between tracers */
+	float GridStepSize = 40.f;
+
+	/** How far put navigation point from a WorldStatic face */
+	float BounceNavDistance = 5.f;
+
+	/** How far to trace from tracers. Multiplier of GridStepSize */
+	float TraceDistanceModificator = 3.5f;
+
+	/** How close navigation points can be to each other. Multiplier of GridStepSize */
+	float ClosePointsFilterModificator = 0.25f;
+
+	/** The radius of a sphere to find neighbors of each node. Multiplier of GridStepSize */
+	float ConnectionSphereRadiusModificator = 2.2f;
+
+	/** How far to trace from each node to find intersections through edges. Multiplier of GridStepSize */
+	float TraceDistanceForEdgesModificator = 4.f;
+
+	/** How far trace lines may deviate near the point of intersection. Multiplier of GridStepSize */
+	float EgdeDeviationModificator = .8f;
+
+	/** Cell size of the relation spatial grid. Multiplier of the connection radius */
+	float RelationCellMultiplier = 1.25f;
+
+	/** Sleep between lattice slices to keep the editor responsive. 0 disables throttling */
+	float ThrottleSleepSeconds = 0.f;
+
+	/** Whether to push debug primitives into FSpiderDebugRenderer */
+	bool bDebugDraw = false;
+
+	/** Build volume, copied on the game thread by FSpiderNavGridBuilder::CaptureVolume so build threads never touch the actor */
+	FTransform VolumeTransform = FTransform::Identity;
+	FVector VolumeExtent = FVector::ZeroVector;
+	FBox VolumeBounds = FBox(ForceInit);
+
+	bool HasVolume() const { return VolumeBounds.IsValid != 0; }
+};
+
+/** Shared between a running build and its observers. Cancellation is cooperative and checked between chunks */
+struct FSpiderNavBuildControl
+{
+	std::atomic<bool> bCancelRequested{ false };
+	std::atomic<int64> StageWorkDone{ 0 };
+	std::atomic<int64> StageWorkTotal{ 0 };
+	/** Collision traces issued since the control was created, for the build report */
+	std::atomic<int64> TracesIssued{ 0 };
+
+	bool IsCancelled() const { return bCancelRequested.load(std::memory_order_relaxed); }
+
+	void ResetWork(int64 Total)
+	{
+		StageWorkDone.store(0, std::memory_order_relaxed);
+		StageWorkTotal.store(Total, std::memory_order_relaxed);
+	}
+
+	void AddWork(int64 Done) { StageWorkDone.fetch_add(Done, std::memory_order_relaxed); }
+	void AddTraces(int64 Count) { TracesIssued.fetch_add(Count, std::memory_order_relaxed); }
+	int64 GetTraces() const { return TracesIssued.load(std::memory_order_relaxed); }
+
+	/** Progress of the current stage in [0, 1] */
+	float GetStageFraction() const
+	{
+		const int64 Total = StageWorkTotal.load(std::memory_order_relaxed);
+		return Total > 0 ? FMath::Clamp(float(StageWorkDone.load(std::memory_order_relaxed)) / float(Total), 0.f, 1.f) : 0.f;
+	}
+};
+
+/** Result of a single builder stage */
+struct FSpiderNavBuildStageStats
+{
+	FString Name;
+	double WallSeconds = 0.0;
+	/** Process CPU time (user + kernel, all threads) spent during the stage */
+	double CpuSeconds = 0.0;
+	/** Process physical memory at the end of the stage and the process peak so far */
+	uint64 UsedPhysicalBytes = 0;
+	uint64 PeakUsedPhysicalBytes = 0;
+	int64 Traces = 0;
+	int32 NodesOut = 0;
+	int64 EdgesOut = 0;
+};
+
+/** Identity of a piece of static collision geometry at build time */
+struct FSpiderNavGeometryEntry
+{
+	FBox Bounds = FBox(ForceInit);
+	/** Hash of transform and asset */
+	uint32 Hash = 0;
+	/** Hash of the component path name, stable across editor sessions */
+	uint32 NameHash = 0;
+};
+
+/** Collision geometry overlapping the build volume, keyed by primitive component */
+typedef TMap<FObjectKey, FSpiderNavGeometryEntry> FSpiderNavGeometrySnapshot;
+
+/** Result of an incremental region rebuild */
+struct FSpiderNavIncrementalStats
+{
+	FBox Region = FBox(ForceInit);
+	int32 RemovedNodes = 0;
+	int32 AddedNodes = 0;
+	int32 RelinkedNodes = 0;
+	int64 EdgesAdded = 0;
+	double WallSeconds = 0.0;
+};
+
+/**
+ * Stateless implementation of the grid generation stages.
+ * Full builds run through FSpiderNavBuildJob, incremental rebuilds call RebuildRegion directly.
+ */
+class SPIDERNAVIGATION_EDITOR_API FSpiderNavGridBuilder
+{
+public:
+	/** Bump when the output of the pipeline changes for identical inputs. Part of the input hash */
+	static constexpr int32 BuilderVersion = 2;
+
+	FSpiderNavGridBuilder(UWorld* InWorld, const FSpiderNavBuildSettings& InSettings, const AActor* InIgnoredActor = nullptr);
+
+	/** Fills the captured volume with lattice points spaced by GridStepSize. Clip restricts the points to a sub box of the same lattice */
+	void GenerateLattice(TArray<FSpiderNavNodeBuilder>& OutPoints, const FBox* Clip = nullptr) const;
+
+	/** Traces the 6 axis directions from lattice points [Begin, End) and appends a node per hit */
+	void TraceLatticeRange(const TArray<FSpiderNavNodeBuilder>& Points, int32 Begin, int32 End, TArray<FSpiderNavNodeBuilder>& OutNodes) const;
+
+	/** Traces all lattice points in parallel. Output order matches the serial variant */
+	void TraceLattice(const TArray<FSpiderNavNodeBuilder>& Points, TArray<FSpiderNavNodeBuilder>& OutNodes) const;
+
+	/** Sorts traced nodes into a canonical order and drops nodes closer than ClosePointsFilterModificator. Returns the number removed */
+	int32 SortAndFilterNodes(TArray<FSpiderNavNodeBuilder>& Nodes) const;
+
+	/**
+	 * Connects mutually visible nodes within the connection radius. Returns the number of edges added.
+	 * With Affected set only pairs touching an affected node are traced and merged into the existing relations.
+	 */
+	int64 BuildRelations(TArray<FSpiderNavNodeBuilder>& Nodes, const TBitArray<>* Affected = nullptr) const;
+
+	/**
+	 * Adds a node where traces around a convex edge of two nodes without direct visibility cross and links it to both.
+	 * Requires relations; with Affected only pairs touching an affected node are searched. Returns the number of nodes added.
+	 */
+	int32 GenerateEdgeNodes(TArray<FSpiderNavNodeBuilder>& Nodes, const TBitArray<>* Affected = nullptr) const;
+
+	/**
+	 * Regenerates nodes and relations around DirtyBox and splices them into Nodes.
+	 * Nodes outside the expanded region keep their indices; freed slots are reused or marked invalid.
+	 */
+	FSpiderNavIncrementalStats RebuildRegion(const FBox& DirtyBox, TArray<FSpiderNavNodeBuilder>& Nodes) const;
+
+	/** World space bounds of the build volume */
+	static FBox GetVolumeBounds(const ASpiderNavGridBuilderVolume* Volume);
+
+	/** Copies transform, extent and bounds of Volume into Settings. Game thread only */
+	static void CaptureVolume(const ASpiderNavGridBuilderVolume* Volume, FSpiderNavBuildSettings& Settings);
+
+	/** Collects the collision geometry overlapping Bounds */
+	void CaptureGeometry(const FBox& Bounds, FSpiderNavGeometrySnapshot& OutSnapshot) const;
+
+	/** Union of the bounds of added, removed or changed geometry. Invalid box if nothing changed */
+	static FBox DiffGeometry(const FSpiderNavGeometrySnapshot& Before, const FSpiderNavGeometrySnapshot& After);
+
+	/** Hash of everything the output depends on: builder version, tunables, volume transform and geometry */
+	FString ComputeInputHash(const ASpiderNavGridBuilderVolume* Volume, const FSpiderNavGeometrySnapshot& Geometry) const;
+
+	/** Hash stamped on incrementally patched grids. Never equals a full build hash, so the next full build is not skipped */
+	static FString MakePartialInputHash(const FString& InputHash);
+
+	/** Checksum of the generated nodes and relations. Identical for identical inputs */
+	static FString ComputeOutputHash(const TArray<FSpiderNavNodeBuilder>& Nodes);
+
+	const FSpiderNavBuildSettings& GetSettings() const { return Settings; }
+
+	/** Progress and cancellation sink for the long running stages. Not owned */
+	void SetControl(FSpiderNavBuildControl* InControl) { Control = InControl; }
+
+	/** Creates a save game object filled with the nodes and their relations, stamped with InputHash */
+	static USpiderNavGridSaveGame* CreateSaveGame(const TArray<FSpiderNavNodeBuilder>& Nodes, const FString& InputHash = FString());
+
+	/** Restores nodes from a save game. Saved indices are kept, gaps become invalid slots */
+	static bool ReadSaveGame(const USpiderNavGridSaveGame* Save, TArray<FSpiderNavNodeBuilder>& OutNodes);
+
+	/** Number of undirected edges */
+	static int64 CountEdges(const TArray<FSpiderNavNodeBuilder>& Nodes);
+
+private:
+	bool IsCancelled() const { return Control && Control->IsCancelled(); }
+
+	UWorld* World;
+	FSpiderNavBuildSettings Settings;
+	/** Only compared, never dereferenced; traces use the id so worker threads do not touch the actor */
+	const AActor* IgnoredActor;
+	uint32 IgnoredActorId = 0;
+	FSpiderNavBuildControl* Control = nullptr;
+};
@@ -5,7 +5,11 @@
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
 #include "Structs/SpiderNavNodeBuilder.h"
+#include "EditorUtility/SpiderNavGridBuilder.h"
 #include "EditorUtility/SpiderNavWorker.h"
+#include "EditorUtility/SpiderNavBuildJob.h"
+#include "Containers/Ticker.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Templates/SharedPointer.h"          
 #include "Templates/SharedPointerFwd.h"          
 #include "Templates/SharedPointerInternals.h"    
@@ -40,6 +44,13 @@ protected:
 	class UButton* Load;
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	class UButton* Debug;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	class UButton* RebuildDirty;
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	class UProgressBar* BuildProgress;
+	/** Per-stage timings, memory and trace counts of the last build, filled after saving */
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	class UTextBlock* BuildReportText;
 protected:
 	UPROPERTY(EditAnywhere, Category = "Spider|Performance")
 	int32 TracesPerTickHint = 2000; // Wie viele Traces pro Tick (je 6 pro Knoten)
@@ -114,6 +125,19 @@ protected:
 	/** Distance threshold to remove tracers enclosed in volumes  */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavGridBuilder")
 	float TracersInVolumesCheckDistance;
+
+	/** Whether RebuildDirtyRegion uses ManualDirtyBox instead of detecting changed geometry */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavGridBuilder|Incremental")
+	bool bUseManualDirtyBox = false;
+
+	/** World space region to regenerate when bUseManualDirtyBox is set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavGridBuilder|Incremental", meta = (EditCondition = "bUseManualDirtyBox"))
+	FBox ManualDirtyBox = FBox(ForceInit);
+
+	/** Skip Generate when the saved grid was built from identical inputs (settings, volume and geometry) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpiderNavGridBuilder")
+	bool bSkipUnchangedBuilds = true;
+
 	// Debug-Option
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bDebugDraw = true;
@@ -124,6 +148,22 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	float DebugDrawTime = 3.0f;
+public:
+	/** Regenerates only the region around changed geometry (or ManualDirtyBox) and splices it into the current grid */
+	UFUNCTION(BlueprintCallable, Category = "SpiderNavGridBuilder")
+	void RebuildDirtyRegion();
+
+	/** Overall progress of the running build in [0, 1] */
+	UFUNCTION(BlueprintPure, Category = "SpiderNavGridBuilder")
+	float GetBuildProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "SpiderNavGridBuilder")
+	bool IsBuildRunning() const;
+
+	/** Text form of the last build report (also written to Saved/SaveGames/<Slot>.buildreport.json) */
+	UFUNCTION(BlueprintPure, Category = "SpiderNavGridBuilder")
+	FString GetLastBuildReport() const;
+
 protected:
 	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
@@ -138,23 +178,42 @@ private:
 	UPROPERTY()
 	TArray<FSpiderNavNodeBuilder> GeneratedNodes;
 
-	FCriticalSection RelationCritical;
+	/** Collision geometry at the time of the last build, used to find dirty regions */
+	FSpiderNavGeometrySnapshot GeometrySnapshot;
 
-private:
-	void SpawnTracersAsync();
-	void TraceFromAllTracersAsync();
-	void BuildRelationsDataAsync();
+	/** Input hash of GeneratedNodes, stored with the save game */
+	FString CurrentInputHash;
+
+	/** Stages of the build that produced GeneratedNodes. Consumed by the next save */
+	TArray<FSpiderNavBuildStageStats> BuildStages;
+	FString LastBuildReport;
+
+	/** Full build executed on Worker */
+	TSharedPtr<FSpiderNavBuildJob, ESPMode::ThreadSafe> ActiveJob;
+	FTSTicker::FDelegateHandle BuildTickerHandle;
+	FProgressNotificationHandle BuildNotification;
 
-	void AddNavPointByHitResult(FHitResult RV_Hit);
-	bool CheckNavPointsVisibility(class ASpiderNavPoint* NavPoint1, class ASpiderNavPoint* NavPoint2);
-	bool GetLineLineIntersection(FVector Start0, FVector End0, FVector Start1, FVector End1, FVector& Intersection);
-	void CheckAndAddIntersectionNavPointEdge(FVector Intersection, class ASpiderNavPoint* NavPoint1, class ASpiderNavPoint* NavPoint2);
-	bool CheckNavPointCanSeeLocation(ASpiderNavPoint* NavPoint, FVector Location);
+	/** The job traces the editor world from the worker: map changes and exit cancel and wait for it first */
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle PreExitHandle;
+
+private:
+	FSpiderNavBuildSettings MakeBuildSettings() const;
+	/** Cancels the running job and blocks until the worker has left it */
+	void AbortBuildJob();
+	void OnMapChanged(uint32 MapChangeFlags);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	FBox GetVolumeBounds() const;
+	void CaptureGeometrySnapshot();
+	bool LoadGridIntoNodes();
+	FString ComputeCurrentInputHash() const;
+
+	void StartBuildJob(const FString& InputHash);
+	bool PollBuildJob(float DeltaTime);
 
-	float Dmnop(const TMap<int32, FVector>* v, int32 m, int32 n, int32 o, int32 p);
 	void SaveGridFromData();
 	//bool IsTracerInsideGeometry(UWorld* W, const FVector& Origin, const FCollisionQueryParams& Params) const;
-	int32 GetNavPointIndex(ASpiderNavPoint* NavPoint);
 
 	void RemoveAllTracers();
 	void RemoveAllNavPoints();
@@ -173,4 +232,6 @@ private:
 	void OnLoadClicked();
 	UFUNCTION()
 	void OnDebugClicked();
+	UFUNCTION()
+	void OnRebuildDirtyClicked();
 };
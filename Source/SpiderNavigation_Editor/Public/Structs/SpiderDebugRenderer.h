@@ -2,18 +2,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "HAL/ThreadSafeBool.h"
-#include "Containers/Queue.h"
-
-struct FSpiderDebugDrawCommand
-{
-    enum class EType { Line, Sphere, Point } Type;
-    FVector A, B;
-    FColor Color;
-    float Size;
-    float LifeTime;
-};
+#include "Components/LineBatchComponent.h"
+#include <atomic>
 
+/**
+ * Collects debug primitives from any thread and submits them in one line batcher call per flush.
+ * Every producer thread writes into its own buffer; FlushToWorld merges them on the game thread.
+ * Above MaxPending primitives new ones are decimated instead of growing without bound.
+ */
 class FSpiderDebugRenderer
 {
 public:
@@ -27,9 +23,36 @@ public:
     void EnqueueSphere(const FVector& Center, float Radius, const FColor& Color, float LifeTime = 1.f);
     void EnqueuePoint(const FVector& Pos, float Size, const FColor& Color, float LifeTime = 1.f);
 
+    /** Game thread only */
     void FlushToWorld(UWorld* World);
 
+    /** Drops everything that has not been flushed yet */
+    void Clear();
+
+    /** Pending primitives before decimation starts */
+    void SetMaxPending(int32 InMaxPending) { MaxPending = FMath::Max(1, InMaxPending); }
+
+    /** Primitives dropped by decimation since the last flush */
+    int32 GetDroppedCount() const { return Dropped.load(std::memory_order_relaxed); }
+
 private:
-    FCriticalSection Mutex;
-    TQueue<FSpiderDebugDrawCommand, EQueueMode::Spsc> Pending;
+    struct FThreadBuffer
+    {
+        FCriticalSection Lock; // nur beim Flush umkämpft
+        TArray<FBatchedLine> Lines;
+        TArray<FBatchedPoint> Points;
+        uint32 Sequence = 0;
+    };
+
+    FThreadBuffer& GetThreadBuffer();
+
+    /** False if the primitive should be dropped. Keeps every 2^n-th primitive once above MaxPending */
+    bool ShouldKeep(FThreadBuffer& Buffer, int32 Count);
+
+    FCriticalSection RegistryMutex;
+    TArray<TUniquePtr<FThreadBuffer>> Buffers;
+
+    std::atomic<int32> PendingCount{ 0 };
+    std::atomic<int32> Dropped{ 0 };
+    int32 MaxPending = 200000;
 };
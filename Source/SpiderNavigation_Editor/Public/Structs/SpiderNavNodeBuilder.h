@@ -13,6 +13,8 @@ struct FSpiderNavNodeBuilder
     FVector Location;
     FVector Normal;
     TArray<int32> Neighbors;
+    /** False for slots freed by an incremental rebuild. Kept so that the other indices stay stable */
+    bool bValid = true;
 };
 
 USTRUCT(BlueprintType)